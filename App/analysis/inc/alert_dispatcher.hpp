@@ -0,0 +1,110 @@
+/**
+ * @file alert_dispatcher.hpp
+ * @brief Declares the AlertDispatcher class, which delivers alerts from the alert channel to the log, UI and socket subscribers.
+ */
+
+#pragma once
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "common.hpp"
+#include "quantile_sketch.hpp"
+
+class AlertChannel;
+class MonitorDashboard;
+
+/**
+ * @class AlertDispatcher
+ * @brief Consumes the alert channel and notifies every alert sink.
+ *
+ * Sleeps in epoll on the channel's eventfd. Each alert is written to the log, pushed to
+ * the dashboard (if any) and sent as a JSON line to every client connected to the unix
+ * socket at alert_socket_path (if set). Subscribers that cannot keep up are disconnected
+ * rather than buffered, so one slow client never delays the others.
+ *
+ * The detect-to-notify latency (from the sampler's detection to the last sink) of every
+ * alert is recorded in a quantile sketch, logged with the alert and summarized on stop.
+ */
+class AlertDispatcher {
+public:
+    /**
+     * @brief Constructs an AlertDispatcher.
+     * @param cfg Monitor configuration (uses alert_socket_path).
+     * @param channel Alert channel to consume.
+     * @param dashboard Dashboard to notify, or nullptr without UI.
+     */
+    AlertDispatcher(const MonitorConfig& cfg, AlertChannel& channel, MonitorDashboard* dashboard);
+
+    /**
+     * @brief Destructor. Stops the dispatcher thread and closes the wake descriptor.
+     */
+    ~AlertDispatcher();
+
+    /**
+     * @brief Starts the dispatcher thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the dispatcher thread after delivering the queued alerts.
+     *
+     * Called after the thread pool has stopped, so alerts cleared on shutdown are delivered too.
+     */
+    void stop();
+
+private:
+    /**
+     * @brief Worker thread function. Waits for alerts and subscribers.
+     */
+    void run();
+
+    /**
+     * @brief Creates the listening unix socket.
+     * @return Listening descriptor, or -1 if disabled or on failure.
+     */
+    int openSocket();
+
+    /**
+     * @brief Accepts pending subscriber connections.
+     * @param epoll_fd epoll instance to register subscribers with.
+     */
+    void acceptSubscribers(int epoll_fd);
+
+    /**
+     * @brief Disconnects a subscriber.
+     * @param fd Subscriber descriptor.
+     */
+    void dropSubscriber(int fd);
+
+    /**
+     * @brief Delivers all queued alerts to every sink.
+     */
+    void drain();
+
+    /**
+     * @brief Delivers one alert to every sink and records its latency.
+     * @param event Alert to deliver.
+     */
+    void dispatch(const AlertEvent& event);
+
+    /**
+     * @brief Formats an alert as a JSON line.
+     * @param event Alert to format.
+     * @param buffer Output buffer.
+     * @param size Buffer size.
+     * @return Length of the line.
+     */
+    static int formatJson(const AlertEvent& event, char* buffer, size_t size);
+
+    const MonitorConfig& cfg_;              ///< Monitor configuration.
+    AlertChannel& channel_;                 ///< Alert channel to consume.
+    MonitorDashboard* dashboard_;           ///< Dashboard to notify (nullptr without UI).
+    std::thread worker_;                    ///< Dispatcher thread.
+    std::atomic<bool> running_{false};      ///< Indicates if the dispatcher is running.
+    int wake_fd_ = -1;                      ///< eventfd waking the loop for shutdown.
+    int listen_fd_ = -1;                    ///< Listening unix socket (-1 if disabled).
+    std::vector<int> subscribers_;          ///< Connected subscriber sockets.
+    QuantileSketch latency_ms_;             ///< Detect-to-notify latencies in milliseconds.
+};
@@ -5,17 +5,29 @@
 
 #pragma once
 #include <atomic>
+#include <memory>
+#include <string>
 #include <thread>
-#include <unordered_map>
+#include <vector>
+#include <cstdint>
 
 class MonitorDashboard;
+class MetricsTable;
 
 /**
  * @class LiveMetricAggregator
- * @brief Aggregates live container metrics from a POSIX message queue and updates the dashboard.
+ * @brief Aggregates live container metrics from the shared-memory metrics table and updates the dashboard.
  *
- * Periodically reads messages containing container metrics, updates the dashboard,
- * and removes stale containers based on the UI refresh interval.
+ * Sleeps in epoll until the table signals a write, then snapshots it and forwards all
+ * slots that changed since the previous snapshot to the dashboard as a single update.
+ * Samplers write with every sample, so after a snapshot the update notifications are
+ * paused for DASHBOARD_FRAME_INTERVAL_MS, the rate at which the dashboard renders; writes
+ * in the meantime are picked up by one snapshot when the pause ends.
+ *
+ * A snapshot only copies slots whose sequence changed. Containers leave the dashboard
+ * when their slot is released, not after a period without updates, so idle containers
+ * sampled at a backed-off interval stay shown. A timerfd snapshots once per UI refresh
+ * interval as a fallback, and an eventfd wakes the loop for shutdown.
  */
 class LiveMetricAggregator {
 public:
@@ -28,7 +40,7 @@ public:
     LiveMetricAggregator(std::atomic<bool>& shutdown_flag, MonitorDashboard* dashboard, int ui_refresh_interval_ms);
 
     /**
-     * @brief Destructor. Ensures the worker thread is stopped.
+     * @brief Destructor. Ensures the worker thread is stopped and closes the wake descriptor.
      */
     ~LiveMetricAggregator();
 
@@ -44,14 +56,29 @@ public:
 
 private:
     /**
-     * @brief Worker thread function. Handles message queue reading and dashboard updates.
+     * @brief Worker thread function. Handles table snapshots and dashboard updates.
      */
     void run();
 
+    /**
+     * @brief Waits for the metrics table to be created.
+     * @param epoll_fd epoll instance watching the wake descriptor.
+     * @return The attached table, or nullptr on shutdown or timeout.
+     */
+    std::unique_ptr<MetricsTable> openTable(int epoll_fd);
+
+    /**
+     * @brief Snapshots the table and forwards changed and released slots to the dashboard.
+     * @param table Metrics table.
+     */
+    void snapshot(const MetricsTable& table);
+
     std::atomic<bool>& shutdown_flag_;                ///< Reference to shutdown flag.
     MonitorDashboard* dashboard_;                     ///< Pointer to dashboard for metric updates.
     int ui_refresh_interval_ms_;                      ///< UI refresh interval in milliseconds.
     std::thread worker_;                              ///< Worker thread for aggregation.
-    bool running_ = false;                            ///< Indicates if the aggregator is running.
-    std::unordered_map<std::string, int64_t> last_update_map_; ///< Tracks last update time for each container.
+    std::atomic<bool> running_{false};                ///< Indicates if the aggregator is running.
+    int wake_fd_ = -1;                                ///< eventfd waking the loop for shutdown.
+    std::vector<std::string> slot_ids_;               ///< Container shown for each slot (empty if none).
+    std::vector<uint32_t> last_sequence_;             ///< Slot sequences seen in the previous snapshot.
 };
\ No newline at end of file
@@ -0,0 +1,272 @@
+/**
+ * @file alert_dispatcher.cpp
+ * @brief Implements the AlertDispatcher class, which delivers alerts from the alert channel to the log, UI and socket subscribers.
+ */
+
+#include "alert_dispatcher.hpp"
+#include <ctime>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include "logger.hpp"
+#include "alert_channel.hpp"
+#include "monitor_dashboard.hpp"
+
+/**
+ * @brief Constructs an AlertDispatcher.
+ * @param cfg Monitor configuration (uses alert_socket_path).
+ * @param channel Alert channel to consume.
+ * @param dashboard Dashboard to notify, or nullptr without UI.
+ */
+AlertDispatcher::AlertDispatcher(const MonitorConfig& cfg, AlertChannel& channel, MonitorDashboard* dashboard)
+    : cfg_(cfg), channel_(channel), dashboard_(dashboard) {
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        CM_LOG_ERROR << "[AlertDispatcher] eventfd failed: " << strerror(errno) << "\n";
+    }
+}
+
+/**
+ * @brief Destructor. Stops the dispatcher thread and closes the wake descriptor.
+ */
+AlertDispatcher::~AlertDispatcher() {
+    stop();
+    if (wake_fd_ >= 0) close(wake_fd_);
+}
+
+/**
+ * @brief Starts the dispatcher thread.
+ */
+void AlertDispatcher::start() {
+    if (!running_) {
+        running_ = true;
+        worker_ = std::thread(&AlertDispatcher::run, this);
+    }
+}
+
+/**
+ * @brief Stops the dispatcher thread after delivering the queued alerts.
+ *
+ * Called after the thread pool has stopped, so alerts cleared on shutdown are delivered too.
+ */
+void AlertDispatcher::stop() {
+    running_ = false;
+    if (wake_fd_ >= 0) eventfd_write(wake_fd_, 1);
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+/**
+ * @brief Worker thread function. Waits for alerts and subscribers.
+ *
+ * - Sleeps in epoll on the channel eventfd, the listening socket, the subscribers and the wake eventfd.
+ * - Delivers queued alerts as soon as the channel signals.
+ * - Accepts new subscribers and drops disconnected ones.
+ * - On shutdown, delivers what is left and logs the latency summary.
+ */
+void AlertDispatcher::run() {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd_ < 0) {
+        CM_LOG_ERROR << "[AlertDispatcher] epoll setup failed: " << strerror(errno) << "\n";
+        if (epoll_fd >= 0) close(epoll_fd);
+        return;
+    }
+    listen_fd_ = openSocket();
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    for (int fd : {wake_fd_, channel_.eventFd(), listen_fd_}) {
+        if (fd < 0) continue;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    // Runs until stop(), not the shutdown flag, so alerts pushed while the pool stops are delivered
+    while (running_) {
+        // Alerts queued before the loop started, or pushed without an eventfd
+        drain();
+        int n = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, channel_.eventFd() >= 0 ? -1 : SLEEP_MS_MEDIUM);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            CM_LOG_ERROR << "[AlertDispatcher] epoll_wait failed: " << strerror(errno) << "\n";
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            uint64_t count;
+            if (fd == wake_fd_ || fd == channel_.eventFd()) {
+                if (read(fd, &count, sizeof(count)) < 0) continue;
+            } else if (fd == listen_fd_) {
+                acceptSubscribers(epoll_fd);
+            } else {
+                // Subscribers never send; a readable subscriber has hung up
+                dropSubscriber(fd);
+            }
+        }
+    }
+    drain();
+
+    for (int fd : subscribers_) close(fd);
+    subscribers_.clear();
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(cfg_.alert_socket_path.c_str());
+        listen_fd_ = -1;
+    }
+    close(epoll_fd);
+
+    if (latency_ms_.count() > 0) {
+        double latency[PERCENTILE_COUNT];
+        latency_ms_.quantiles(PERCENTILE_RANKS, latency, PERCENTILE_COUNT);
+        CM_LOG_INFO << "[AlertDispatcher] " << latency_ms_.count() << " alerts delivered, detect-to-notify latency p50 "
+                    << latency[0] << " ms, p95 " << latency[1] << " ms, p99 " << latency[2] << " ms, "
+                    << channel_.dropped() << " dropped\n";
+    }
+}
+
+/**
+ * @brief Creates the listening unix socket.
+ * @return Listening descriptor, or -1 if disabled or on failure.
+ */
+int AlertDispatcher::openSocket() {
+    const std::string& path = cfg_.alert_socket_path;
+    if (path.empty()) return -1;
+    struct sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        CM_LOG_ERROR << "[AlertDispatcher] Alert socket path too long: " << path << "\n";
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        CM_LOG_ERROR << "[AlertDispatcher] socket failed: " << strerror(errno) << "\n";
+        return -1;
+    }
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, ALERT_SOCKET_BACKLOG) != 0) {
+        CM_LOG_ERROR << "[AlertDispatcher] Cannot listen on " << path << ": " << strerror(errno) << "\n";
+        close(fd);
+        return -1;
+    }
+    CM_LOG_INFO << "[AlertDispatcher] Publishing alerts on " << path << "\n";
+    return fd;
+}
+
+/**
+ * @brief Accepts pending subscriber connections.
+ * @param epoll_fd epoll instance to register subscribers with.
+ */
+void AlertDispatcher::acceptSubscribers(int epoll_fd) {
+    for (;;) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        if (subscribers_.size() >= ALERT_SOCKET_MAX_SUBSCRIBERS) {
+            CM_LOG_WARN << "[AlertDispatcher] Too many alert subscribers, connection refused\n";
+            close(fd);
+            continue;
+        }
+        struct epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        subscribers_.push_back(fd);
+    }
+}
+
+/**
+ * @brief Disconnects a subscriber.
+ * @param fd Subscriber descriptor.
+ */
+void AlertDispatcher::dropSubscriber(int fd) {
+    auto it = std::find(subscribers_.begin(), subscribers_.end(), fd);
+    if (it == subscribers_.end()) return;
+    subscribers_.erase(it);
+    close(fd);  // Also removes it from epoll
+}
+
+/**
+ * @brief Delivers all queued alerts to every sink.
+ */
+void AlertDispatcher::drain() {
+    AlertEvent event;
+    while (channel_.pop(event)) dispatch(event);
+}
+
+/**
+ * @brief Delivers one alert to every sink and records its latency.
+ *
+ * The UI and socket subscribers are notified first; the latency is taken after the
+ * last of them, and the log line that follows includes it.
+ *
+ * @param event Alert to deliver.
+ */
+void AlertDispatcher::dispatch(const AlertEvent& event) {
+    if (dashboard_) dashboard_->pushAlert(event);
+    if (!subscribers_.empty()) {
+        char line[ALERT_LINE_BUF_SIZE];
+        int length = formatJson(event, line, sizeof(line));
+        for (size_t i = 0; i < subscribers_.size();) {
+            // A subscriber that cannot take a whole line right away is too slow to keep
+            ssize_t sent = send(subscribers_[i], line, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (sent == length) {
+                ++i;
+            } else {
+                CM_LOG_WARN << "[AlertDispatcher] Alert subscriber disconnected\n";
+                dropSubscriber(subscribers_[i]);
+            }
+        }
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t now_ns = static_cast<int64_t>(now.tv_sec) * static_cast<int64_t>(NANOSECONDS_PER_SECOND) + now.tv_nsec;
+    double latency_ms = static_cast<double>(now_ns - event.detected_ns) / NANOSECONDS_PER_MILLISECOND;
+    latency_ms_.add(latency_ms);
+
+    const char* metric = ALERT_METRIC_NAMES[static_cast<size_t>(event.metric)];
+    const char* severity = ALERT_SEVERITY_NAMES[static_cast<size_t>(event.severity)];
+    const char* unit = (event.kind == AlertKind::Rate) ? " %/s" : " %";
+    if (event.kind == AlertKind::Forecast) {
+        if (event.raised) {
+            CM_LOG_WARN << "[Alert] " << severity << " forecast alert on " << metric << " of " << event.container_name
+                        << ": limit reached in " << event.value << " s, within " << event.threshold
+                        << " s (notified in " << latency_ms << " ms)\n";
+        } else {
+            CM_LOG_INFO << "[Alert] " << severity << " forecast alert on " << metric << " of " << event.container_name
+                        << " cleared\n";
+        }
+    } else if (event.raised) {
+        CM_LOG_WARN << "[Alert] " << severity << " " << ALERT_KIND_NAMES[static_cast<size_t>(event.kind)] << " alert on "
+                    << metric << " of " << event.container_name << ": " << event.value << unit << " >= "
+                    << event.threshold << unit << " (notified in " << latency_ms << " ms)\n";
+    } else {
+        CM_LOG_INFO << "[Alert] " << severity << " " << ALERT_KIND_NAMES[static_cast<size_t>(event.kind)] << " alert on "
+                    << metric << " of " << event.container_name << " cleared at " << event.value << unit << "\n";
+    }
+}
+
+/**
+ * @brief Formats an alert as a JSON line.
+ * @param event Alert to format.
+ * @param buffer Output buffer.
+ * @param size Buffer size.
+ * @return Length of the line.
+ */
+int AlertDispatcher::formatJson(const AlertEvent& event, char* buffer, size_t size) {
+    int length = std::snprintf(buffer, size,
+        "{\"event\":\"%s\",\"severity\":\"%s\",\"kind\":\"%s\",\"metric\":\"%s\",\"container\":\"%s\","
+        "\"value\":%.2f,\"threshold\":%.2f,\"timestamp\":%lld}\n",
+        event.raised ? "raised" : "cleared", ALERT_SEVERITY_NAMES[static_cast<size_t>(event.severity)],
+        ALERT_KIND_NAMES[static_cast<size_t>(event.kind)], ALERT_METRIC_NAMES[static_cast<size_t>(event.metric)],
+        event.container_name, event.value, event.threshold, static_cast<long long>(event.timestamp));
+    return std::min(length, static_cast<int>(size) - 1);
+}
@@ -4,16 +4,40 @@
  */
 
 #include "live_metric_aggregator.hpp"
-#include <iostream>
-#include <mqueue.h>
-#include <cstring>
-#include <cerrno>
+#include <algorithm>
+#include <memory>
 #include <thread>
-#include <chrono>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include "logger.hpp"
 #include "common.hpp"
+#include "metrics_table.hpp"
 #include "monitor_dashboard.hpp"
 
+namespace {
+
+/**
+ * @brief Arms a timerfd.
+ * @param fd Timer descriptor.
+ * @param period_ms Time until expiry in milliseconds.
+ * @param repeat Whether the timer repeats with the same period.
+ */
+void armTimer(int fd, int period_ms, bool repeat) {
+    struct itimerspec spec{};
+    int64_t period_ns = static_cast<int64_t>(period_ms) * NANOSECONDS_PER_MILLISECOND;
+    spec.it_value.tv_sec = period_ns / static_cast<int64_t>(NANOSECONDS_PER_SECOND);
+    spec.it_value.tv_nsec = period_ns % static_cast<int64_t>(NANOSECONDS_PER_SECOND);
+    if (repeat) spec.it_interval = spec.it_value;
+    timerfd_settime(fd, 0, &spec, nullptr);
+}
+
+}
+
 /**
  * @brief Constructs a LiveMetricAggregator.
  * @param shutdown_flag Reference to the application's shutdown flag.
@@ -21,13 +45,19 @@
  * @param ui_refresh_interval_ms UI refresh interval in milliseconds.
  */
 LiveMetricAggregator::LiveMetricAggregator(std::atomic<bool>& shutdown_flag, MonitorDashboard* dashboard, int ui_refresh_interval_ms)
-    : shutdown_flag_(shutdown_flag), dashboard_(dashboard), ui_refresh_interval_ms_(ui_refresh_interval_ms) {}
+    : shutdown_flag_(shutdown_flag), dashboard_(dashboard), ui_refresh_interval_ms_(ui_refresh_interval_ms) {
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        CM_LOG_ERROR << "[Aggregator] eventfd failed: " << strerror(errno) << "\n";
+    }
+}
 
 /**
- * @brief Destructor. Ensures the worker thread is stopped.
+ * @brief Destructor. Ensures the worker thread is stopped and closes the wake descriptor.
  */
 LiveMetricAggregator::~LiveMetricAggregator() {
     stop();
+    if (wake_fd_ >= 0) close(wake_fd_);
 }
 
 /**
@@ -45,81 +75,159 @@ void LiveMetricAggregator::start() {
  */
 void LiveMetricAggregator::stop() {
     running_ = false;
+    if (wake_fd_ >= 0) eventfd_write(wake_fd_, 1);
     if (worker_.joinable()) {
         worker_.join();
     }
 }
 
 /**
- * @brief Worker thread function. Handles message queue reading and dashboard updates.
+ * @brief Worker thread function. Handles table snapshots and dashboard updates.
  *
- * - Waits for the POSIX message queue to appear.
- * - Reads messages containing container metrics.
- * - Updates the dashboard with new metrics.
- * - Periodically removes stale containers.
- * - Handles graceful shutdown and message queue cleanup.
+ * - Waits for the shared-memory metrics table to appear.
+ * - Sleeps in epoll on the table's update eventfd, the fallback and frame timerfds and the wake eventfd.
+ * - On an update, snapshots the table and forwards every changed or released slot in one batch,
+ *   then pauses update notifications until the frame timer fires.
+ * - When the frame timer fires, snapshots again if the table was written meanwhile, else resumes notifications.
+ * - Handles graceful shutdown.
  */
 void LiveMetricAggregator::run() {
-    CM_LOG_INFO << "Waiting for message queue '" << METRIC_MQ_NAME << "' to appear... \n";
-
-    mqd_t mqd;
-    int attempts = 0;
-    while (attempts < 50 && !shutdown_flag_) {
-        mqd = mq_open(METRIC_MQ_NAME.data(), O_RDONLY | O_NONBLOCK);
-        if (mqd != (mqd_t)-1) {
-            CM_LOG_INFO << "Message queue opened successfully on attempt " << (attempts + 1) << ". \n";
-            break;
-        } else {
-            CM_LOG_WARN << "Attempt " << (attempts + 1) << ": Queue not found, retrying... \n";
-            attempts++;
-            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MS_LONG));
-        }
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd_ < 0) {
+        CM_LOG_ERROR << "[Aggregator] epoll setup failed: " << strerror(errno) << "\n";
+        if (epoll_fd >= 0) close(epoll_fd);
+        return;
     }
-    if (mqd == (mqd_t)-1) {
-        CM_LOG_FATAL << "Message queue not found after waiting. \n";
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd_, &ev);
+
+    std::unique_ptr<MetricsTable> table = openTable(epoll_fd);
+    if (!table) {
+        close(epoll_fd);
         return;
     }
+    last_sequence_.assign(table->capacity(), 0);
+    slot_ids_.assign(table->capacity(), std::string());
 
-    CM_LOG_INFO << "Waiting for messages... \n";
-    ContainerMaxMetricsMsg msg;
-    unsigned int prio;
-    int64_t last_cleanup = 0;
+    // Readers outside the owning process get no update descriptor and snapshot on the timer instead
+    int update_fd = table->updateFd();
+    int timer_period_ms = (update_fd >= 0) ? ui_refresh_interval_ms_ : METRICS_TABLE_SNAPSHOT_MS;
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd >= 0) armTimer(timer_fd, timer_period_ms, true);
+    // One-shot timer ending the pause of update notifications after a snapshot
+    int frame_fd = (update_fd >= 0) ? timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC) : -1;
+    for (int fd : {timer_fd, update_fd, frame_fd}) {
+        if (fd < 0) continue;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    // Values written before the loop started
+    snapshot(*table);
+
+    struct epoll_event events[EPOLL_MAX_EVENTS];
     while (running_ && !shutdown_flag_) {
-        ssize_t bytes = mq_receive(mqd, reinterpret_cast<char*>(&msg), METRIC_MQ_MSG_SIZE, &prio);
-        int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-
-        if (bytes >= 0) {
-            std::string id(msg.container_id);
-            last_update_map_[id] = now;
-            if (dashboard_) {
-                dashboard_->pushMetrics(msg);
-            }
-        } else if (errno == EAGAIN) {
-            // No message, just wait
-        } else if (errno == EINTR) {
-            break; // Interrupted by signal
-        } else {
-            CM_LOG_ERROR << "mq_receive error: " << strerror(errno) << "\n";
+        int n = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            CM_LOG_ERROR << "[Aggregator] epoll_wait failed: " << strerror(errno) << "\n";
+            break;
         }
-
-        // Periodically check for stale containers
-        if (now - last_cleanup > ui_refresh_interval_ms_) {
-            last_cleanup = now;
-            for (auto it = last_update_map_.begin(); it != last_update_map_.end(); ) {
-                if (now - it->second > ui_refresh_interval_ms_) {
-                    // CM_LOG_INFO << "[Aggregator] Removing stale container: " << it->first << "\n";
-                    if (dashboard_) {
-                        dashboard_->pushMetricsRemoved(it->first);
-                    }
-                    it = last_update_map_.erase(it);
+        bool updated = false, paused = false;
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            uint64_t count;
+            if (read(fd, &count, sizeof(count)) < 0) continue;
+            if (fd == timer_fd) updated = true;
+            if (fd == update_fd) updated = paused = true;
+            if (fd == frame_fd) {
+                // Snapshot the writes made during the pause, or resume notifications if there were none
+                if (read(update_fd, &count, sizeof(count)) > 0) {
+                    updated = paused = true;
                 } else {
-                    ++it;
+                    ev.data.fd = update_fd;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, update_fd, &ev);
                 }
             }
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MS_SHORT));
+        if (updated) snapshot(*table);
+        if (paused && frame_fd >= 0) {
+            // Writes during the pause only increment the eventfd counter, without waking the loop
+            struct epoll_event paused_ev{};
+            paused_ev.data.fd = update_fd;
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, update_fd, &paused_ev);
+            armTimer(frame_fd, DASHBOARD_FRAME_INTERVAL_MS, false);
+        }
+    }
+    if (frame_fd >= 0) close(frame_fd);
+    if (timer_fd >= 0) close(timer_fd);
+    close(epoll_fd);
+    CM_LOG_INFO << "Metrics table closed. \n";
+}
+
+/**
+ * @brief Waits for the metrics table to be created.
+ * @param epoll_fd epoll instance watching the wake descriptor.
+ * @return The attached table, or nullptr on shutdown or timeout.
+ */
+std::unique_ptr<MetricsTable> LiveMetricAggregator::openTable(int epoll_fd) {
+    CM_LOG_INFO << "Waiting for metrics table '" << METRICS_TABLE_NAME << "' to appear... \n";
+    struct epoll_event event;
+    for (int attempts = 0; attempts < METRICS_TABLE_OPEN_ATTEMPTS && running_ && !shutdown_flag_; ++attempts) {
+        std::unique_ptr<MetricsTable> table = MetricsTable::open(METRICS_TABLE_NAME);
+        if (table) {
+            CM_LOG_INFO << "Metrics table opened successfully on attempt " << (attempts + 1) << ". \n";
+            return table;
+        }
+        CM_LOG_WARN << "Attempt " << (attempts + 1) << ": Table not found, retrying... \n";
+        // Sleeps like SLEEP_MS_LONG, but stop() ends the wait early
+        epoll_wait(epoll_fd, &event, 1, SLEEP_MS_LONG);
+    }
+    if (running_ && !shutdown_flag_) {
+        CM_LOG_FATAL << "Metrics table not found after waiting. \n";
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Snapshots the table and forwards changed and released slots to the dashboard.
+ *
+ * Slots whose sequence did not change are skipped without copying them. A container is
+ * removed only once its slot is released (its sampler dropped it); with adaptive sampling
+ * an idle container may legitimately go unwritten for up to max_sampling_interval_ms.
+ *
+ * @param table Metrics table.
+ */
+void LiveMetricAggregator::snapshot(const MetricsTable& table) {
+    std::vector<ContainerMaxMetricsMsg> updated;
+    std::vector<std::string> removed;
+    MetricsTableEntry entry;
+    for (size_t slot = 0; slot < table.capacity(); ++slot) {
+        if (table.sequence(slot) == last_sequence_[slot]) continue;
+        uint32_t sequence = 0;
+        bool claimed = table.read(slot, entry, sequence);
+        last_sequence_[slot] = sequence;
+        std::string& shown = slot_ids_[slot];
+        if (!shown.empty() && (!claimed || shown != entry.metrics.container_id)) {
+            // Released, or released and claimed by another container since the previous snapshot
+            removed.push_back(std::move(shown));
+            shown.clear();
+        }
+        if (claimed) {
+            shown = entry.metrics.container_id;
+            updated.push_back(entry.metrics);
+        }
+    }
+
+    // A container recreated in another slot since the previous snapshot stays shown
+    if (!removed.empty()) {
+        removed.erase(std::remove_if(removed.begin(), removed.end(), [this](const std::string& id) {
+            return std::find(slot_ids_.begin(), slot_ids_.end(), id) != slot_ids_.end();
+        }), removed.end());
+    }
+    if (dashboard_ && (!updated.empty() || !removed.empty())) {
+        dashboard_->pushUpdate(updated, removed);
     }
-    mq_close(mqd);
-    CM_LOG_INFO << "Message queue closed. \n";
 }
\ No newline at end of file
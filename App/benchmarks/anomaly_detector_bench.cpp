@@ -0,0 +1,113 @@
+/**
+ * @file anomaly_detector_bench.cpp
+ * @brief Measures the cost of AnomalyDetector::update at the sampler's container count and rate.
+ *
+ * Usage: anomaly_detector_bench [containers] [rate_hz] [seconds]  (defaults: 500 10 10)
+ *
+ * Runs two passes over one detector per container, fed with Gaussian noise:
+ * - a tight loop, reporting the cost of one update;
+ * - a paced loop that updates every detector rate_hz times per second for the given
+ *   duration, reporting the thread CPU time as a share of one core.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include "common.hpp"
+#include "anomaly_detector.hpp"
+
+namespace {
+
+constexpr size_t SERIES_LENGTH = 1024;   ///< Pre-generated samples per container (cycled).
+
+/**
+ * @brief Returns the CPU time consumed by the calling thread.
+ * @return CPU time in nanoseconds.
+ */
+int64_t threadCpuNs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * static_cast<int64_t>(NANOSECONDS_PER_SECOND) + ts.tv_nsec;
+}
+
+/**
+ * @brief Generates noisy samples around a random level for every container.
+ * @param containers Number of containers.
+ * @return containers * SERIES_LENGTH samples, one series per container.
+ */
+std::vector<ContainerMetrics> makeSeries(size_t containers) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> level(5.0, 80.0);
+    std::normal_distribution<double> noise(0.0, 2.0);
+    std::vector<ContainerMetrics> series(containers * SERIES_LENGTH);
+    for (size_t c = 0; c < containers; ++c) {
+        double cpu = level(rng), memory = level(rng), pids = level(rng);
+        for (size_t i = 0; i < SERIES_LENGTH; ++i) {
+            ContainerMetrics& m = series[c * SERIES_LENGTH + i];
+            m.cpu_usage_percent = cpu + noise(rng);
+            m.memory_usage_percent = memory + noise(rng);
+            m.pids_percent = pids + noise(rng);
+        }
+    }
+    return series;
+}
+
+}
+
+/**
+ * @brief Runs the tight and paced benchmark passes.
+ * @param argc Argument count.
+ * @param argv Optional containers, rate_hz and seconds.
+ * @return 0 on success, 1 on invalid arguments.
+ */
+int main(int argc, char* argv[]) {
+    size_t containers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 500;
+    double rate_hz = (argc > 2) ? std::strtod(argv[2], nullptr) : 10.0;
+    double seconds = (argc > 3) ? std::strtod(argv[3], nullptr) : 10.0;
+    if (containers == 0 || rate_hz <= 0.0 || seconds <= 0.0) {
+        std::fprintf(stderr, "usage: %s [containers] [rate_hz] [seconds]\n", argv[0]);
+        return 1;
+    }
+
+    const std::vector<ContainerMetrics> series = makeSeries(containers);
+    std::vector<AnomalyDetector> detectors(containers, AnomalyDetector(DEFAULT_ANOMALY_SIGMA));
+    uint64_t flagged = 0;
+
+    // Tight loop: round-robin over the detectors, like one sampler pass after another
+    const size_t rounds = 4 * SERIES_LENGTH;
+    int64_t start_ns = threadCpuNs();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t c = 0; c < containers; ++c) {
+            flagged += detectors[c].update(series[c * SERIES_LENGTH + round % SERIES_LENGTH]) != 0;
+        }
+    }
+    double update_ns = static_cast<double>(threadCpuNs() - start_ns) / static_cast<double>(rounds * containers);
+    std::printf("tight: %.1f ns per update over %zu detectors\n", update_ns, containers);
+
+    // Paced loop: one round per sampling period, the way the samplers call the detector
+    for (AnomalyDetector& detector : detectors) detector.clear();
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate_hz));
+    const size_t paced_rounds = static_cast<size_t>(seconds * rate_hz);
+    auto next = std::chrono::steady_clock::now();
+    int64_t busy_ns = 0;
+    for (size_t round = 0; round < paced_rounds; ++round) {
+        start_ns = threadCpuNs();
+        for (size_t c = 0; c < containers; ++c) {
+            flagged += detectors[c].update(series[c * SERIES_LENGTH + round % SERIES_LENGTH]) != 0;
+        }
+        busy_ns += threadCpuNs() - start_ns;
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    double wall_ns = static_cast<double>(paced_rounds) / rate_hz * NANOSECONDS_PER_SECOND;
+    std::printf("paced: %zu detectors at %.1f Hz for %.1f s used %.4f %% of one core (%.1f ns per update)\n",
+                containers, rate_hz, seconds, 100.0 * static_cast<double>(busy_ns) / wall_ns,
+                static_cast<double>(busy_ns) / static_cast<double>(paced_rounds * containers));
+    std::printf("flagged samples: %llu\n", static_cast<unsigned long long>(flagged));
+    return 0;
+}
\ No newline at end of file
@@ -16,6 +16,8 @@
  *
  * @param runtime The container runtime name (e.g., "docker", "podman").
  * @param cgroup_version The cgroup version (e.g., "v1", "v2").
+ * @param cgroup_root Mount point of the cgroup filesystem.
  * @return std::unique_ptr<IContainerRuntimePathFactory> Factory instance.
  */
-std::unique_ptr<IContainerRuntimePathFactory> createPathFactory(const std::string& runtime, const std::string& cgroup_version);
\ No newline at end of file
+std::unique_ptr<IContainerRuntimePathFactory> createPathFactory(const std::string& runtime, const std::string& cgroup_version,
+                                                                const std::string& cgroup_root = std::string(DEFAULT_CGROUP_ROOT));
\ No newline at end of file
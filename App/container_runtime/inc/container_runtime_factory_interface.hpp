@@ -5,13 +5,15 @@
 
 #pragma once
 #include <string>
+#include <vector>
 #include "common.hpp"
 
 /**
  * @class IContainerRuntimePathFactory
  * @brief Interface for container runtime resource path factories.
  *
- * Provides a method to obtain resource file paths for a given container ID.
+ * Provides methods to obtain resource file paths for a given container ID and
+ * the cgroup directories under which the runtime places its containers.
  */
 class IContainerRuntimePathFactory {
 public:
@@ -20,7 +22,44 @@ public:
     /**
      * @brief Returns resource file paths for the specified container ID.
      * @param container_id The container identifier.
-     * @return ContainerResourcePaths Struct containing CPU, memory, and pids paths.
+     * @return ContainerResourcePaths Struct containing CPU, memory, pids and memory peak paths.
      */
     virtual ContainerResourcePaths getPaths(const std::string& container_id) const = 0;
+
+    /**
+     * @brief Returns resource limit file paths for the specified container ID.
+     * @param container_id The container identifier.
+     * @return ContainerLimitPaths Struct containing CPU quota/period, memory and pids limit paths.
+     */
+    virtual ContainerLimitPaths getLimitPaths(const std::string& container_id) const = 0;
+
+    /**
+     * @brief Returns the files used to register kernel memory notifications for a container ID.
+     * @param container_id The container identifier.
+     * @return ContainerMemoryEventPaths Struct with an empty event_control_path if unsupported.
+     */
+    virtual ContainerMemoryEventPaths getMemoryEventPaths(const std::string& container_id) const = 0;
+
+    /**
+     * @brief Returns the pressure stall information (PSI) files of a container ID.
+     * @param container_id The container identifier.
+     * @return ContainerPressurePaths Struct with empty paths if unsupported.
+     */
+    virtual ContainerPressurePaths getPressurePaths(const std::string& container_id) const = 0;
+
+    /**
+     * @brief Returns the cgroup directory of the specified container ID.
+     *
+     * The directory only exists while the container is running.
+     *
+     * @param container_id The container identifier.
+     * @return Path of the container's cgroup directory.
+     */
+    virtual std::string getCgroupDir(const std::string& container_id) const = 0;
+
+    /**
+     * @brief Returns the cgroup directories holding one sub-directory per running container.
+     * @return Parent directories, one per cgroup controller hierarchy.
+     */
+    virtual std::vector<std::string> getParentDirs() const = 0;
 };
\ No newline at end of file
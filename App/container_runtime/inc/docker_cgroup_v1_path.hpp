@@ -5,6 +5,7 @@
 
 #pragma once
 #include <cstdio>
+#include <string>
 #include "common.hpp"
 #include "container_runtime_factory_interface.hpp"
 
@@ -17,22 +18,104 @@
  */
 class DockerCgroupV1PathFactory : public IContainerRuntimePathFactory {
 public:
+    /**
+     * @brief Constructs a DockerCgroupV1PathFactory.
+     * @param cgroup_root Mount point of the cgroup filesystem.
+     */
+    explicit DockerCgroupV1PathFactory(std::string cgroup_root = std::string(DEFAULT_CGROUP_ROOT))
+        : cgroup_root_(std::move(cgroup_root)) {}
+
     /**
      * @brief Returns resource file paths for the specified container ID.
      * @param container_id The container identifier.
-     * @return ContainerResourcePaths Struct containing CPU, memory, and pids paths.
+     * @return ContainerResourcePaths Struct containing CPU, memory, pids and memory peak paths.
      */
     ContainerResourcePaths getPaths(const std::string& container_id) const override {
         ContainerResourcePaths paths;
         char buf[CGROUP_PATH_BUF_SIZE];
 
-        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_CPU_PATH_FMT, container_id.c_str());
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_CPU_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
         paths.cpu_path = buf;
-        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_MEMORY_PATH_FMT, container_id.c_str());
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_MEMORY_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
         paths.memory_path = buf;
-        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_PIDS_PATH_FMT, container_id.c_str());
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_PIDS_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
         paths.pids_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_MEMORY_PEAK_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.memory_peak_path = buf;
+
+        return paths;
+    }
+
+    /**
+     * @brief Returns resource limit file paths for the specified container ID.
+     * @param container_id The container identifier.
+     * @return ContainerLimitPaths Struct containing CPU quota/period, memory and pids limit paths.
+     */
+    ContainerLimitPaths getLimitPaths(const std::string& container_id) const override {
+        ContainerLimitPaths paths;
+        char buf[CGROUP_PATH_BUF_SIZE];
+
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_CPU_QUOTA_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.cpu_quota_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_CPU_PERIOD_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.cpu_period_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_MEMORY_LIMIT_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.memory_limit_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_PIDS_MAX_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.pids_max_path = buf;
+
+        return paths;
+    }
+
+    /**
+     * @brief Returns the Docker cgroup v1 files used to register memory notifications.
+     * @param container_id The container identifier.
+     * @return ContainerMemoryEventPaths Struct containing event control, usage and OOM control paths.
+     */
+    ContainerMemoryEventPaths getMemoryEventPaths(const std::string& container_id) const override {
+        ContainerMemoryEventPaths paths;
+        char buf[CGROUP_PATH_BUF_SIZE];
+
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_EVENT_CONTROL_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.event_control_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_MEMORY_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.usage_path = buf;
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_OOM_CONTROL_PATH_FMT, cgroup_root_.c_str(), container_id.c_str());
+        paths.oom_control_path = buf;
 
         return paths;
     }
+
+    /**
+     * @brief Pressure stall information is only exposed per cgroup on cgroup v2.
+     * @param container_id The container identifier (unused).
+     * @return ContainerPressurePaths Struct with empty paths.
+     */
+    ContainerPressurePaths getPressurePaths(const std::string& /*container_id*/) const override {
+        return {};
+    }
+
+    /**
+     * @brief Returns the Docker cgroup v1 directory of the specified container ID (cpu hierarchy).
+     * @param container_id The container identifier.
+     * @return Path of the container's cgroup directory.
+     */
+    std::string getCgroupDir(const std::string& container_id) const override {
+        char buf[CGROUP_PATH_BUF_SIZE];
+        std::snprintf(buf, sizeof(buf), DOCKER_CGROUP_V1_DIR_FMT, cgroup_root_.c_str(), container_id.c_str());
+        return buf;
+    }
+
+    /**
+     * @brief Returns the Docker cgroup v1 parent directories for the cpu, memory and pids controllers.
+     * @return Parent directories, one per cgroup controller hierarchy.
+     */
+    std::vector<std::string> getParentDirs() const override {
+        return {cgroup_root_ + DOCKER_CGROUP_V1_CPU_PARENT_DIR,
+                cgroup_root_ + DOCKER_CGROUP_V1_MEMORY_PARENT_DIR,
+                cgroup_root_ + DOCKER_CGROUP_V1_PIDS_PARENT_DIR};
+    }
+
+private:
+    std::string cgroup_root_;   ///< Mount point of the cgroup filesystem.
 };
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * @file docker_cgroup_v2_path.hpp
+ * @brief Declares the DockerCgroupV2PathFactory for Docker cgroup v2 resource paths.
+ */
+
+#pragma once
+#include <cstdio>
+#include <string>
+#include "common.hpp"
+#include "container_runtime_factory_interface.hpp"
+
+/**
+ * @class DockerCgroupV2PathFactory
+ * @brief Factory for generating Docker cgroup v2 resource file paths.
+ *
+ * Implements IContainerRuntimePathFactory for the unified hierarchy with Docker's
+ * cgroupfs driver, where every container has a single directory <root>/docker/<id>
+ * holding all controller files.
+ */
+class DockerCgroupV2PathFactory : public IContainerRuntimePathFactory {
+public:
+    /**
+     * @brief Constructs a DockerCgroupV2PathFactory.
+     * @param cgroup_root Mount point of the cgroup filesystem.
+     */
+    explicit DockerCgroupV2PathFactory(std::string cgroup_root = std::string(DEFAULT_CGROUP_ROOT))
+        : cgroup_root_(std::move(cgroup_root)) {}
+
+    /**
+     * @brief Returns resource file paths for the specified container ID.
+     * @param container_id The container identifier.
+     * @return ContainerResourcePaths Struct containing CPU (cpu.stat), memory, pids and memory peak paths.
+     */
+    ContainerResourcePaths getPaths(const std::string& container_id) const override {
+        ContainerResourcePaths paths;
+        paths.cpu_path = format(DOCKER_CGROUP_V2_CPU_PATH_FMT, container_id);
+        paths.memory_path = format(DOCKER_CGROUP_V2_MEMORY_PATH_FMT, container_id);
+        paths.pids_path = format(DOCKER_CGROUP_V2_PIDS_PATH_FMT, container_id);
+        paths.memory_peak_path = format(DOCKER_CGROUP_V2_MEMORY_PEAK_PATH_FMT, container_id);
+        return paths;
+    }
+
+    /**
+     * @brief Returns resource limit file paths for the specified container ID.
+     *
+     * Quota and period share cpu.max ("<quota> <period>").
+     *
+     * @param container_id The container identifier.
+     * @return ContainerLimitPaths Struct containing CPU quota/period, memory and pids limit paths.
+     */
+    ContainerLimitPaths getLimitPaths(const std::string& container_id) const override {
+        ContainerLimitPaths paths;
+        paths.cpu_quota_path = format(DOCKER_CGROUP_V2_CPU_MAX_PATH_FMT, container_id);
+        paths.cpu_period_path = paths.cpu_quota_path;
+        paths.memory_limit_path = format(DOCKER_CGROUP_V2_MEMORY_MAX_PATH_FMT, container_id);
+        paths.pids_max_path = format(DOCKER_CGROUP_V2_PIDS_MAX_PATH_FMT, container_id);
+        return paths;
+    }
+
+    /**
+     * @brief cgroup.event_control does not exist on cgroup v2.
+     * @param container_id The container identifier (unused).
+     * @return ContainerMemoryEventPaths Struct with an empty event_control_path.
+     */
+    ContainerMemoryEventPaths getMemoryEventPaths(const std::string& /*container_id*/) const override {
+        return {};
+    }
+
+    /**
+     * @brief Returns the pressure stall information (PSI) files of a container ID.
+     * @param container_id The container identifier.
+     * @return ContainerPressurePaths Struct containing cpu, memory and io pressure paths.
+     */
+    ContainerPressurePaths getPressurePaths(const std::string& container_id) const override {
+        ContainerPressurePaths paths;
+        paths.cpu_pressure_path = format(DOCKER_CGROUP_V2_CPU_PRESSURE_PATH_FMT, container_id);
+        paths.memory_pressure_path = format(DOCKER_CGROUP_V2_MEMORY_PRESSURE_PATH_FMT, container_id);
+        paths.io_pressure_path = format(DOCKER_CGROUP_V2_IO_PRESSURE_PATH_FMT, container_id);
+        return paths;
+    }
+
+    /**
+     * @brief Returns the Docker cgroup v2 directory of the specified container ID.
+     * @param container_id The container identifier.
+     * @return Path of the container's cgroup directory.
+     */
+    std::string getCgroupDir(const std::string& container_id) const override {
+        return format(DOCKER_CGROUP_V2_DIR_FMT, container_id);
+    }
+
+    /**
+     * @brief Returns the single Docker parent directory of the unified hierarchy.
+     * @return Parent directories (one entry).
+     */
+    std::vector<std::string> getParentDirs() const override {
+        return {cgroup_root_ + DOCKER_CGROUP_V2_PARENT_DIR};
+    }
+
+private:
+    /**
+     * @brief Expands a path format with the cgroup root and a container ID.
+     * @param fmt Path format (first %s: cgroup root, second %s: container ID).
+     * @param container_id The container identifier.
+     * @return Expanded path.
+     */
+    std::string format(const char* fmt, const std::string& container_id) const {
+        char buf[CGROUP_PATH_BUF_SIZE];
+        std::snprintf(buf, sizeof(buf), fmt, cgroup_root_.c_str(), container_id.c_str());
+        return buf;
+    }
+
+    std::string cgroup_root_;   ///< Mount point of the cgroup filesystem.
+};
@@ -5,23 +5,29 @@
 
 #include "container_runtime_configuration.hpp"
 #include "docker_cgroup_v1_path.hpp"
+#include "docker_cgroup_v2_path.hpp"
 #include <memory>
 #include <string>
 
 /**
  * @brief Selects and creates an appropriate container runtime path factory.
  *
- * Currently supports Docker with cgroup v1. Extend this function to support
+ * Currently supports Docker with cgroup v1 and v2 (cgroupfs driver). Extend this function to support
  * additional runtime and cgroup combinations as needed.
  *
  * @param runtime The container runtime name (e.g., "docker", "podman").
  * @param cgroup_version The cgroup version (e.g., "v1", "v2").
+ * @param cgroup_root Mount point of the cgroup filesystem.
  * @return std::unique_ptr<IContainerRuntimePathFactory> Factory instance.
  */
-std::unique_ptr<IContainerRuntimePathFactory> createPathFactory(const std::string& runtime, const std::string& cgroup_version) {
+std::unique_ptr<IContainerRuntimePathFactory> createPathFactory(const std::string& runtime, const std::string& cgroup_version,
+                                                                const std::string& cgroup_root) {
     if (runtime == "docker" && cgroup_version == "v1") {
-        return std::make_unique<DockerCgroupV1PathFactory>();
+        return std::make_unique<DockerCgroupV1PathFactory>(cgroup_root);
+    }
+    if (runtime == "docker" && cgroup_version == "v2") {
+        return std::make_unique<DockerCgroupV2PathFactory>(cgroup_root);
     }
     // Add more combinations as needed
-    return std::make_unique<DockerCgroupV1PathFactory>();
+    return std::make_unique<DockerCgroupV1PathFactory>(cgroup_root);
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * @file container_metadata_cache.hpp
+ * @brief Declares the ContainerMetadataCache class for persisting resolved container metadata.
+ */
+
+#pragma once
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "common.hpp"
+
+/**
+ * @struct CachedContainer
+ * @brief Resolved metadata of a container, as stored in the metadata cache.
+ */
+struct CachedContainer {
+    std::string name;               ///< Container name.
+    ContainerInfo info;             ///< Container ID and resource limits.
+    ContainerResourcePaths paths;   ///< Resolved cgroup resource file paths.
+    std::string cgroup_dir;         ///< Cgroup directory used for validation.
+    uint64_t cgroup_inode = 0;      ///< Inode of the cgroup directory (0 if not yet known).
+    int64_t cgroup_ctime_ns = 0;    ///< Change time of the cgroup directory in nanoseconds.
+};
+
+/**
+ * @class ContainerMetadataCache
+ * @brief Compact on-disk cache of resolved container metadata keyed by container ID.
+ *
+ * Lets a warm restart resume sampling without querying the runtime. An entry is only
+ * trusted if its cgroup directory still has the same inode and ctime as when it was
+ * cached, which a recreated container cannot match. Thread-safe.
+ */
+class ContainerMetadataCache {
+public:
+    /**
+     * @brief Constructs a ContainerMetadataCache.
+     * @param path Cache file path. An empty path disables persistence.
+     */
+    explicit ContainerMetadataCache(const std::string& path);
+
+    /**
+     * @brief Loads the cache file, replacing the in-memory entries.
+     * @return True if the file was read successfully, false otherwise.
+     */
+    bool load();
+
+    /**
+     * @brief Writes the cache file atomically.
+     *
+     * Validation keys of entries cached before their cgroup existed are filled in here;
+     * entries whose cgroup directory no longer exists are dropped.
+     *
+     * @return True if the file was written successfully, false otherwise.
+     */
+    bool save();
+
+    /**
+     * @brief Looks up a container and validates it against its cgroup directory.
+     * @param id Container ID.
+     * @param entry Reference to receive the cached entry.
+     * @return True if a valid entry was found, false otherwise.
+     */
+    bool lookup(const std::string& id, CachedContainer& entry) const;
+
+    /**
+     * @brief Adds or replaces a container entry.
+     *
+     * The validation key is taken from the cgroup directory if it already exists.
+     *
+     * @param name Container name.
+     * @param info Container ID and resource limits.
+     * @param paths Resolved cgroup resource file paths.
+     * @param cgroup_dir Cgroup directory of the container.
+     */
+    void put(const std::string& name, const ContainerInfo& info,
+             const ContainerResourcePaths& paths, const std::string& cgroup_dir);
+
+    /**
+     * @brief Removes a container entry.
+     * @param id Container ID.
+     */
+    void erase(const std::string& id);
+
+    /**
+     * @brief Gets the number of cached entries.
+     * @return Number of entries.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @brief Reads the inode and ctime of a cgroup directory.
+     * @param dir Directory path.
+     * @param inode Reference to receive the inode number.
+     * @param ctime_ns Reference to receive the change time in nanoseconds.
+     * @return True if the directory exists, false otherwise.
+     */
+    static bool statDir(const std::string& dir, uint64_t& inode, int64_t& ctime_ns);
+
+    std::string path_;                                          ///< Cache file path.
+    mutable std::mutex mutex_;                                  ///< Mutex for thread-safe access.
+    std::unordered_map<std::string, CachedContainer> entries_;  ///< Entries by container ID.
+};
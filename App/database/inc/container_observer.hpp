@@ -0,0 +1,33 @@
+/**
+ * @file container_observer.hpp
+ * @brief Declares the observer interface for container registry changes.
+ */
+
+#pragma once
+#include <string>
+#include "common.hpp"
+
+/**
+ * @class IContainerObserver
+ * @brief Receives notifications when containers are added to or removed from the registry.
+ *
+ * Notifications are delivered synchronously on the thread that changed the registry,
+ * after the registry has released its own locks, so observers may call back into it.
+ */
+class IContainerObserver {
+public:
+    virtual ~IContainerObserver() = default;
+
+    /**
+     * @brief Called after a container has been saved to the registry.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     */
+    virtual void onContainerAdded(const std::string& name, const ContainerInfo& info) = 0;
+
+    /**
+     * @brief Called after a container has been removed from the registry.
+     * @param name Container name.
+     */
+    virtual void onContainerRemoved(const std::string& name) = 0;
+};
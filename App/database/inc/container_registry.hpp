@@ -0,0 +1,116 @@
+/**
+ * @file container_registry.hpp
+ * @brief Declares the ContainerRegistry class, the in-memory source of truth for container metadata.
+ */
+
+#pragma once
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include "common.hpp"
+#include "database_interface.hpp"
+
+/**
+ * @class ContainerRegistry
+ * @brief Read-optimized container registry with write-behind persistence.
+ *
+ * Container metadata lives in an immutable map published as a shared snapshot.
+ * Readers load the current snapshot without locking or touching the database, and
+ * writers copy the map, apply their change and publish the new snapshot. Container
+ * saves and removals are then persisted to the backing database by a background
+ * writer thread. Metrics, host usage, schema and export calls are forwarded to the
+ * backing database directly.
+ */
+class ContainerRegistry : public IDatabaseInterface {
+public:
+    /**
+     * @brief Constructs a ContainerRegistry over a backing database.
+     * @param backend Database that container metadata is persisted to.
+     */
+    explicit ContainerRegistry(IDatabaseInterface& backend);
+
+    /**
+     * @brief Destructor. Stops the writer thread after persisting pending writes.
+     */
+    ~ContainerRegistry();
+
+    /**
+     * @brief Starts the write-behind thread.
+     */
+    void start();
+
+    /**
+     * @brief Persists all pending writes and stops the write-behind thread.
+     */
+    void stop();
+
+    /**
+     * @brief Blocks until all pending writes have been persisted.
+     */
+    void flush();
+
+    void saveContainer(const std::string& name, const ContainerInfo& info) override;
+    void removeContainer(const std::string& name) override;
+    void clearAll() override;
+    ContainerInfo getContainer(const std::string& name) const override;
+    size_t size() const override;
+    ContainerSnapshot getAll() const override;
+    void setupSchema() override;
+    void insertBatch(const std::string& container_name, const std::vector<ContainerMetrics>& metrics_vec) override;
+    void exportAllTablesToCSV(const std::string& export_dir) override;
+    void saveHostUsage(int64_t timestamp_ms, double cpu_usage_percent, double mem_usage_percent) override;
+    void insertHostBatch(const std::vector<HostUsage>& usage_vec) override;
+    void savePressureSample(const PressureSample& sample) override;
+    void insertPercentiles(const std::string& container_name, const std::vector<ContainerPercentiles>& percentiles_vec) override;
+    void addObserver(IContainerObserver* observer) override;
+
+private:
+    /**
+     * @struct PendingWrite
+     * @brief A container change waiting to be persisted.
+     */
+    struct PendingWrite {
+        std::string name;       ///< Container name.
+        ContainerInfo info;     ///< Container info (unused for removals).
+        bool remove = false;    ///< True for a removal, false for a save.
+    };
+
+    /**
+     * @brief Writer thread function. Persists pending writes in order.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Persists all currently pending writes on the calling thread.
+     * @param lock Lock on queue_mutex_, released while writing.
+     */
+    void drainPending(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Queues a container change for persistence.
+     * @param write Change to persist.
+     */
+    void enqueue(PendingWrite write);
+
+    /**
+     * @brief Returns a copy of the registered observers.
+     * @return Registered observers.
+     */
+    std::vector<IContainerObserver*> getObservers();
+
+    IDatabaseInterface& backend_;                   ///< Backing database.
+    std::mutex update_mutex_;                       ///< Serializes snapshot updates.
+    ContainerSnapshot snapshot_;                    ///< Current snapshot (accessed atomically).
+    std::mutex queue_mutex_;                        ///< Mutex for the pending write queue.
+    std::condition_variable queue_cv_;              ///< Signals new pending writes.
+    std::condition_variable drained_cv_;            ///< Signals that the queue has been drained.
+    std::deque<PendingWrite> pending_;              ///< Writes not yet persisted.
+    bool writing_ = false;                          ///< Whether a batch is being persisted.
+    bool running_ = false;                          ///< Indicates if the writer is running.
+    std::thread writer_;                            ///< Write-behind thread.
+    std::mutex observer_mutex_;                     ///< Mutex for the observer list.
+    std::vector<IContainerObserver*> observers_;    ///< Observers of container additions and removals.
+};
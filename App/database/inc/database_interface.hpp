@@ -6,8 +6,20 @@
 #pragma once
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 #include "common.hpp"
+#include "container_observer.hpp"
+
+/**
+ * @brief Container name to ContainerInfo map.
+ */
+using ContainerMap = std::map<std::string, ContainerInfo>;
+
+/**
+ * @brief Immutable point-in-time view of all registered containers.
+ */
+using ContainerSnapshot = std::shared_ptr<const ContainerMap>;
 
 /**
  * @class IDatabaseInterface
@@ -59,9 +71,9 @@ public:
 
     /**
      * @brief Get all container information.
-     * @return Map of container name to ContainerInfo.
+     * @return Snapshot of container name to ContainerInfo.
      */
-    virtual const std::map<std::string, ContainerInfo>& getAll() const = 0;
+    virtual ContainerSnapshot getAll() const = 0;
 
     /**
      * @brief Setup database schema (tables).
@@ -81,4 +93,29 @@ public:
      * @param mem_usage_percent Memory usage percent.
      */
     virtual void saveHostUsage(int64_t timestamp_ms, double cpu_usage_percent, double mem_usage_percent) = 0;
+
+    /**
+     * @brief Insert a batch of host usage samples, including their per-core breakdown.
+     * @param usage_vec Vector of HostUsage.
+     */
+    virtual void insertHostBatch(const std::vector<HostUsage>& usage_vec) = 0;
+
+    /**
+     * @brief Save the pressure stall values of a container resource.
+     * @param sample PressureSample recorded when a pressure trigger fired.
+     */
+    virtual void savePressureSample(const PressureSample& sample) = 0;
+
+    /**
+     * @brief Insert the percentiles of a container's closed windows.
+     * @param container_name Container name.
+     * @param percentiles_vec Vector of ContainerPercentiles.
+     */
+    virtual void insertPercentiles(const std::string& container_name, const std::vector<ContainerPercentiles>& percentiles_vec) = 0;
+
+    /**
+     * @brief Register an observer notified when containers are added or removed.
+     * @param observer Observer to notify (must outlive the database).
+     */
+    virtual void addObserver(IContainerObserver* observer) = 0;
 };
\ No newline at end of file
@@ -37,19 +37,32 @@ public:
     void clearAll() override;
     ContainerInfo getContainer(const std::string& name) const override;
     size_t size() const override;
-    const std::map<std::string, ContainerInfo>& getAll() const override;
+    ContainerSnapshot getAll() const override;
     void setupSchema() override;
     void insertBatch(const std::string& container_name, const std::vector<ContainerMetrics>& metrics_vec) override;
     void exportAllTablesToCSV(const std::string& export_dir) override;
     void saveHostUsage(int64_t timestamp_ms, double cpu_usage_percent, double mem_usage_percent) override;
+    void insertHostBatch(const std::vector<HostUsage>& usage_vec) override;
+    void savePressureSample(const PressureSample& sample) override;
+    void insertPercentiles(const std::string& container_name, const std::vector<ContainerPercentiles>& percentiles_vec) override;
+    void addObserver(IContainerObserver* observer) override;
 
 private:
     sqlite3* db_;                                   ///< SQLite database handle.
     mutable std::mutex db_mutex;                    ///< Mutex for thread-safe access.
     mutable std::map<std::string, ContainerInfo> cache_; ///< In-memory cache of container info.
+    mutable bool cache_loaded_ = false;             ///< Whether the cache has been loaded from the database.
+    std::mutex observer_mutex_;                     ///< Mutex for the observer list.
+    std::vector<IContainerObserver*> observers_;    ///< Observers of container additions and removals.
 
     /**
-     * @brief Loads container info cache from the database.
+     * @brief Returns a copy of the registered observers.
+     * @return Registered observers.
+     */
+    std::vector<IContainerObserver*> getObservers();
+
+    /**
+     * @brief Loads container info cache from the database once. Caller must hold db_mutex.
      */
     void loadCache() const;
 };
\ No newline at end of file
@@ -0,0 +1,246 @@
+/**
+ * @file container_metadata_cache.cpp
+ * @brief Implements the ContainerMetadataCache class for persisting resolved container metadata.
+ */
+
+#include "container_metadata_cache.hpp"
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sys/stat.h>
+#include "logger.hpp"
+
+namespace {
+
+/**
+ * @brief Writes a trivially copyable value in native byte order.
+ * @param out Output stream.
+ * @param value Value to write.
+ */
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Writes a length-prefixed string.
+ * @param out Output stream.
+ * @param str String to write.
+ */
+void writeString(std::ostream& out, const std::string& str) {
+    uint16_t len = static_cast<uint16_t>(std::min<size_t>(str.size(), UINT16_MAX));
+    writeValue(out, len);
+    out.write(str.data(), len);
+}
+
+/**
+ * @brief Reads a trivially copyable value in native byte order.
+ * @param in Input stream.
+ * @param value Reference to receive the value.
+ * @return True if the value was read completely.
+ */
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * @brief Reads a length-prefixed string.
+ * @param in Input stream.
+ * @param str Reference to receive the string.
+ * @return True if the string was read completely.
+ */
+bool readString(std::istream& in, std::string& str) {
+    uint16_t len = 0;
+    if (!readValue(in, len)) return false;
+    str.resize(len);
+    return len == 0 || static_cast<bool>(in.read(&str[0], len));
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a ContainerMetadataCache.
+ * @param path Cache file path. An empty path disables persistence.
+ */
+ContainerMetadataCache::ContainerMetadataCache(const std::string& path) : path_(path) {}
+
+/**
+ * @brief Reads the inode and ctime of a cgroup directory.
+ * @param dir Directory path.
+ * @param inode Reference to receive the inode number.
+ * @param ctime_ns Reference to receive the change time in nanoseconds.
+ * @return True if the directory exists, false otherwise.
+ */
+bool ContainerMetadataCache::statDir(const std::string& dir, uint64_t& inode, int64_t& ctime_ns) {
+    struct stat st;
+    if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return false;
+    inode = st.st_ino;
+    ctime_ns = static_cast<int64_t>(st.st_ctim.tv_sec) * 1000000000LL + st.st_ctim.tv_nsec;
+    return true;
+}
+
+/**
+ * @brief Loads the cache file, replacing the in-memory entries.
+ *
+ * File layout: magic, version, entry count, then per entry the name, ID, limits,
+ * resource paths, cgroup directory and validation key.
+ *
+ * @return True if the file was read successfully, false otherwise.
+ */
+bool ContainerMetadataCache::load() {
+    if (path_.empty()) return false;
+    std::ifstream in(path_, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    uint32_t magic = 0, version = 0, count = 0;
+    if (!readValue(in, magic) || magic != METADATA_CACHE_MAGIC ||
+        !readValue(in, version) || version != METADATA_CACHE_VERSION ||
+        !readValue(in, count)) {
+        CM_LOG_WARN << "[MetadataCache] Ignoring incompatible cache file: " << path_ << "\n";
+        return false;
+    }
+
+    std::unordered_map<std::string, CachedContainer> loaded;
+    for (uint32_t i = 0; i < count; ++i) {
+        CachedContainer entry;
+        int32_t memory_limit = 0, pid_limit = 0;
+        if (!readString(in, entry.name) || !readString(in, entry.info.id) ||
+            !readValue(in, entry.info.cpu_limit) || !readValue(in, memory_limit) || !readValue(in, pid_limit) ||
+            !readString(in, entry.paths.cpu_path) || !readString(in, entry.paths.memory_path) ||
+            !readString(in, entry.paths.pids_path) || !readString(in, entry.paths.memory_peak_path) ||
+            !readString(in, entry.cgroup_dir) ||
+            !readValue(in, entry.cgroup_inode) || !readValue(in, entry.cgroup_ctime_ns)) {
+            CM_LOG_WARN << "[MetadataCache] Truncated cache file: " << path_ << "\n";
+            return false;
+        }
+        entry.info.memory_limit = memory_limit;
+        entry.info.pid_limit = pid_limit;
+        loaded[entry.info.id] = std::move(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_ = std::move(loaded);
+    CM_LOG_INFO << "[MetadataCache] Loaded " << entries_.size() << " cached containers from " << path_ << "\n";
+    return true;
+}
+
+/**
+ * @brief Writes the cache file atomically.
+ * @return True if the file was written successfully, false otherwise.
+ */
+bool ContainerMetadataCache::save() {
+    if (path_.empty()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Fill in missing validation keys and drop containers whose cgroup is gone
+    for (auto it = entries_.begin(); it != entries_.end(); ) {
+        uint64_t inode = 0;
+        int64_t ctime_ns = 0;
+        if (!statDir(it->second.cgroup_dir, inode, ctime_ns)) {
+            it = entries_.erase(it);
+            continue;
+        }
+        if (it->second.cgroup_inode == 0) {
+            it->second.cgroup_inode = inode;
+            it->second.cgroup_ctime_ns = ctime_ns;
+        }
+        ++it;
+    }
+
+    std::string tmp_path = path_ + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            CM_LOG_ERROR << "[MetadataCache] Failed to open cache file for writing: " << tmp_path << "\n";
+            return false;
+        }
+        writeValue(out, METADATA_CACHE_MAGIC);
+        writeValue(out, METADATA_CACHE_VERSION);
+        writeValue(out, static_cast<uint32_t>(entries_.size()));
+        for (const auto& [id, entry] : entries_) {
+            writeString(out, entry.name);
+            writeString(out, entry.info.id);
+            writeValue(out, entry.info.cpu_limit);
+            writeValue(out, static_cast<int32_t>(entry.info.memory_limit));
+            writeValue(out, static_cast<int32_t>(entry.info.pid_limit));
+            writeString(out, entry.paths.cpu_path);
+            writeString(out, entry.paths.memory_path);
+            writeString(out, entry.paths.pids_path);
+            writeString(out, entry.paths.memory_peak_path);
+            writeString(out, entry.cgroup_dir);
+            writeValue(out, entry.cgroup_inode);
+            writeValue(out, entry.cgroup_ctime_ns);
+        }
+        if (!out.flush()) {
+            CM_LOG_ERROR << "[MetadataCache] Failed to write cache file: " << tmp_path << "\n";
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        CM_LOG_ERROR << "[MetadataCache] Failed to replace cache file: " << path_ << "\n";
+        return false;
+    }
+    CM_LOG_INFO << "[MetadataCache] Saved " << entries_.size() << " containers to " << path_ << "\n";
+    return true;
+}
+
+/**
+ * @brief Looks up a container and validates it against its cgroup directory.
+ * @param id Container ID.
+ * @param entry Reference to receive the cached entry.
+ * @return True if a valid entry was found, false otherwise.
+ */
+bool ContainerMetadataCache::lookup(const std::string& id, CachedContainer& entry) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.cgroup_inode == 0) return false;
+
+    uint64_t inode = 0;
+    int64_t ctime_ns = 0;
+    if (!statDir(it->second.cgroup_dir, inode, ctime_ns) ||
+        inode != it->second.cgroup_inode || ctime_ns != it->second.cgroup_ctime_ns) {
+        return false;
+    }
+    entry = it->second;
+    return true;
+}
+
+/**
+ * @brief Adds or replaces a container entry.
+ * @param name Container name.
+ * @param info Container ID and resource limits.
+ * @param paths Resolved cgroup resource file paths.
+ * @param cgroup_dir Cgroup directory of the container.
+ */
+void ContainerMetadataCache::put(const std::string& name, const ContainerInfo& info,
+                                 const ContainerResourcePaths& paths, const std::string& cgroup_dir) {
+    CachedContainer entry;
+    entry.name = name;
+    entry.info = info;
+    entry.paths = paths;
+    entry.cgroup_dir = cgroup_dir;
+    // The cgroup only exists once the container runs; save() fills the key in later otherwise
+    statDir(cgroup_dir, entry.cgroup_inode, entry.cgroup_ctime_ns);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[info.id] = std::move(entry);
+}
+
+/**
+ * @brief Removes a container entry.
+ * @param id Container ID.
+ */
+void ContainerMetadataCache::erase(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(id);
+}
+
+/**
+ * @brief Gets the number of cached entries.
+ * @return Number of entries.
+ */
+size_t ContainerMetadataCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
@@ -0,0 +1,267 @@
+/**
+ * @file container_registry.cpp
+ * @brief Implements the ContainerRegistry class, the in-memory source of truth for container metadata.
+ */
+
+#include "container_registry.hpp"
+#include <memory>
+#include "logger.hpp"
+
+/**
+ * @brief Constructs a ContainerRegistry over a backing database.
+ * @param backend Database that container metadata is persisted to.
+ */
+ContainerRegistry::ContainerRegistry(IDatabaseInterface& backend)
+    : backend_(backend), snapshot_(backend.getAll()) {}
+
+/**
+ * @brief Destructor. Stops the writer thread after persisting pending writes.
+ */
+ContainerRegistry::~ContainerRegistry() {
+    stop();
+}
+
+/**
+ * @brief Starts the write-behind thread.
+ */
+void ContainerRegistry::start() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (running_) return;
+    running_ = true;
+    writer_ = std::thread(&ContainerRegistry::writerLoop, this);
+}
+
+/**
+ * @brief Persists all pending writes and stops the write-behind thread.
+ */
+void ContainerRegistry::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        running_ = false;
+    }
+    queue_cv_.notify_all();
+    if (writer_.joinable()) writer_.join();
+    flush();
+}
+
+/**
+ * @brief Blocks until all pending writes have been persisted.
+ *
+ * Without a running writer thread the pending writes are persisted on the caller.
+ */
+void ContainerRegistry::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (!running_) {
+        drainPending(lock);
+        return;
+    }
+    drained_cv_.wait(lock, [this]() { return pending_.empty() && !writing_; });
+}
+
+/**
+ * @brief Writer thread function. Persists pending writes in order.
+ *
+ * - Waits for writes to be queued.
+ * - Persists them to the backing database outside the queue lock.
+ * - Drains the remaining writes on shutdown.
+ */
+void ContainerRegistry::writerLoop() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    while (running_) {
+        queue_cv_.wait(lock, [this]() { return !running_ || !pending_.empty(); });
+        drainPending(lock);
+    }
+    drainPending(lock);
+}
+
+/**
+ * @brief Persists all currently pending writes on the calling thread.
+ * @param lock Lock on queue_mutex_, released while writing.
+ */
+void ContainerRegistry::drainPending(std::unique_lock<std::mutex>& lock) {
+    while (!pending_.empty() && !writing_) {
+        std::deque<PendingWrite> batch;
+        batch.swap(pending_);
+        writing_ = true;
+        lock.unlock();
+        for (const auto& write : batch) {
+            if (write.remove) {
+                backend_.removeContainer(write.name);
+            } else {
+                backend_.saveContainer(write.name, write.info);
+            }
+        }
+        lock.lock();
+        writing_ = false;
+    }
+    drained_cv_.notify_all();
+}
+
+/**
+ * @brief Queues a container change for persistence.
+ * @param write Change to persist.
+ */
+void ContainerRegistry::enqueue(PendingWrite write) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        pending_.push_back(std::move(write));
+    }
+    queue_cv_.notify_one();
+}
+
+/**
+ * @brief Registers an observer notified when containers are added or removed.
+ * @param observer Observer to notify (must outlive the registry).
+ */
+void ContainerRegistry::addObserver(IContainerObserver* observer) {
+    std::lock_guard<std::mutex> lock(observer_mutex_);
+    observers_.push_back(observer);
+}
+
+/**
+ * @brief Returns a copy of the registered observers.
+ * @return Registered observers.
+ */
+std::vector<IContainerObserver*> ContainerRegistry::getObservers() {
+    std::lock_guard<std::mutex> lock(observer_mutex_);
+    return observers_;
+}
+
+/**
+ * @brief Publishes the container in a new snapshot, queues its persistence and notifies observers.
+ * @param name Container name.
+ * @param info ContainerInfo struct.
+ */
+void ContainerRegistry::saveContainer(const std::string& name, const ContainerInfo& info) {
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        auto next = std::make_shared<ContainerMap>(*std::atomic_load(&snapshot_));
+        (*next)[name] = info;
+        std::atomic_store(&snapshot_, ContainerSnapshot(std::move(next)));
+        // Queued under the update lock so the backend sees changes in snapshot order
+        enqueue({name, info, false});
+    }
+
+    for (auto* observer : getObservers()) {
+        observer->onContainerAdded(name, info);
+    }
+}
+
+/**
+ * @brief Publishes a snapshot without the container, queues its removal and notifies observers.
+ * @param name Container name.
+ */
+void ContainerRegistry::removeContainer(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        ContainerSnapshot current = std::atomic_load(&snapshot_);
+        if (current->count(name)) {
+            auto next = std::make_shared<ContainerMap>(*current);
+            next->erase(name);
+            std::atomic_store(&snapshot_, ContainerSnapshot(std::move(next)));
+        }
+        enqueue({name, {}, true});
+    }
+
+    for (auto* observer : getObservers()) {
+        observer->onContainerRemoved(name);
+    }
+}
+
+/**
+ * @brief Clears the registry and all tables of the backing database.
+ */
+void ContainerRegistry::clearAll() {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    flush();
+    std::atomic_store(&snapshot_, ContainerSnapshot(std::make_shared<const ContainerMap>()));
+    backend_.clearAll();
+}
+
+/**
+ * @brief Retrieves container information by name from the current snapshot.
+ * @param name Container name.
+ * @return ContainerInfo struct (empty if not registered).
+ */
+ContainerInfo ContainerRegistry::getContainer(const std::string& name) const {
+    ContainerSnapshot current = std::atomic_load(&snapshot_);
+    auto it = current->find(name);
+    if (it != current->end()) return it->second;
+    return {};
+}
+
+/**
+ * @brief Returns the number of registered containers.
+ * @return Number of containers.
+ */
+size_t ContainerRegistry::size() const {
+    return std::atomic_load(&snapshot_)->size();
+}
+
+/**
+ * @brief Returns the current snapshot of all registered containers.
+ * @return Snapshot of container name to ContainerInfo.
+ */
+ContainerSnapshot ContainerRegistry::getAll() const {
+    return std::atomic_load(&snapshot_);
+}
+
+/**
+ * @brief Sets up the schema of the backing database.
+ */
+void ContainerRegistry::setupSchema() {
+    backend_.setupSchema();
+}
+
+/**
+ * @brief Inserts a batch of metrics into the backing database.
+ * @param container_name Container name.
+ * @param metrics_vec Vector of ContainerMetrics.
+ */
+void ContainerRegistry::insertBatch(const std::string& container_name, const std::vector<ContainerMetrics>& metrics_vec) {
+    backend_.insertBatch(container_name, metrics_vec);
+}
+
+/**
+ * @brief Persists pending container writes, then exports all tables of the backing database.
+ * @param export_dir Directory to export CSV files.
+ */
+void ContainerRegistry::exportAllTablesToCSV(const std::string& export_dir) {
+    flush();
+    backend_.exportAllTablesToCSV(export_dir);
+}
+
+/**
+ * @brief Saves host usage metrics to the backing database.
+ * @param timestamp_ms Timestamp in milliseconds.
+ * @param cpu_usage_percent CPU usage percent.
+ * @param mem_usage_percent Memory usage percent.
+ */
+void ContainerRegistry::saveHostUsage(int64_t timestamp_ms, double cpu_usage_percent, double mem_usage_percent) {
+    backend_.saveHostUsage(timestamp_ms, cpu_usage_percent, mem_usage_percent);
+}
+
+/**
+ * @brief Inserts a batch of host usage samples into the backing database.
+ * @param usage_vec Vector of HostUsage.
+ */
+void ContainerRegistry::insertHostBatch(const std::vector<HostUsage>& usage_vec) {
+    backend_.insertHostBatch(usage_vec);
+}
+
+/**
+ * @brief Saves the pressure stall values of a container resource to the backing database.
+ * @param sample PressureSample recorded when a pressure trigger fired.
+ */
+void ContainerRegistry::savePressureSample(const PressureSample& sample) {
+    backend_.savePressureSample(sample);
+}
+
+/**
+ * @brief Inserts the percentiles of a container's closed windows into the backing database.
+ * @param container_name Container name.
+ * @param percentiles_vec Vector of ContainerPercentiles.
+ */
+void ContainerRegistry::insertPercentiles(const std::string& container_name, const std::vector<ContainerPercentiles>& percentiles_vec) {
+    backend_.insertPercentiles(container_name, percentiles_vec);
+}
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <cstring>
 #include "logger.hpp"
 
 /**
@@ -28,24 +29,50 @@ SQLiteDatabase::~SQLiteDatabase() {
 }
 
 /**
- * @brief Saves container information to the database and cache.
+ * @brief Registers an observer notified when containers are added or removed.
+ * @param observer Observer to notify (must outlive the database).
+ */
+void SQLiteDatabase::addObserver(IContainerObserver* observer) {
+    std::lock_guard<std::mutex> lock(observer_mutex_);
+    observers_.push_back(observer);
+}
+
+/**
+ * @brief Returns a copy of the registered observers.
+ * @return Registered observers.
+ */
+std::vector<IContainerObserver*> SQLiteDatabase::getObservers() {
+    std::lock_guard<std::mutex> lock(observer_mutex_);
+    return observers_;
+}
+
+/**
+ * @brief Saves container information to the database and cache, then notifies observers.
  * @param name Container name.
  * @param info ContainerInfo struct.
  */
 void SQLiteDatabase::saveContainer(const std::string& name, const ContainerInfo& info) {
     if (!db_) return;
-    const char* sql = SQL_INSERT_OR_REPLACE_CONTAINER;
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_text(stmt, 2, info.id.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_double(stmt, 3, info.cpu_limit);
-        sqlite3_bind_int(stmt, 4, info.memory_limit);
-        sqlite3_bind_int(stmt, 5, info.pid_limit);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        loadCache();
+        const char* sql = SQL_INSERT_OR_REPLACE_CONTAINER;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, info.id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(stmt, 3, info.cpu_limit);
+            sqlite3_bind_int(stmt, 4, info.memory_limit);
+            sqlite3_bind_int(stmt, 5, info.pid_limit);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+        cache_[name] = info;
+    }
+
+    for (auto* observer : getObservers()) {
+        observer->onContainerAdded(name, info);
     }
-    cache_[name] = info;
 }
 
 /**
@@ -55,6 +82,7 @@ void SQLiteDatabase::saveContainer(const std::string& name, const ContainerInfo&
  */
 ContainerInfo SQLiteDatabase::getContainer(const std::string& name) const {
     if (!db_) return {};
+    std::lock_guard<std::mutex> lock(db_mutex);
     loadCache();
     auto it = cache_.find(name);
     if (it != cache_.end()) return it->second;
@@ -66,24 +94,29 @@ ContainerInfo SQLiteDatabase::getContainer(const std::string& name) const {
  * @return Number of containers.
  */
 size_t SQLiteDatabase::size() const {
+    std::lock_guard<std::mutex> lock(db_mutex);
     loadCache();
     return cache_.size();
 }
 
 /**
  * @brief Returns all container information from the cache.
- * @return Map of container name to ContainerInfo.
+ * @return Snapshot of container name to ContainerInfo.
  */
-const std::map<std::string, ContainerInfo>& SQLiteDatabase::getAll() const {
+ContainerSnapshot SQLiteDatabase::getAll() const {
+    std::lock_guard<std::mutex> lock(db_mutex);
     loadCache();
-    return cache_;
+    return std::make_shared<const ContainerMap>(cache_);
 }
 
 /**
- * @brief Loads container info cache from the database.
+ * @brief Loads container info cache from the database once. Caller must hold db_mutex.
+ *
+ * Afterwards the cache is kept in sync by saveContainer, removeContainer and clearAll.
  */
 void SQLiteDatabase::loadCache() const {
-    if (!db_) return;
+    if (!db_ || cache_loaded_) return;
+    cache_loaded_ = true;
     cache_.clear();
     const char* sql = SQL_SELECT_CONTAINER;
     sqlite3_stmt* stmt;
@@ -102,19 +135,27 @@ void SQLiteDatabase::loadCache() const {
 }
 
 /**
- * @brief Removes a container from the database and cache.
+ * @brief Removes a container from the database and cache, then notifies observers.
  * @param name Container name.
  */
 void SQLiteDatabase::removeContainer(const std::string& name) {
     if (!db_) return;
-    const char* sql = SQL_DELETE_CONTAINER_BY_NAME;
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        loadCache();
+        const char* sql = SQL_DELETE_CONTAINER_BY_NAME;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+        cache_.erase(name);
+    }
+
+    for (auto* observer : getObservers()) {
+        observer->onContainerRemoved(name);
     }
-    cache_.erase(name);
 }
 
 /**
@@ -122,9 +163,13 @@ void SQLiteDatabase::removeContainer(const std::string& name) {
  */
 void SQLiteDatabase::clearAll() {
     if (!db_) return;
+    std::lock_guard<std::mutex> lock(db_mutex);
     const char* sql1 = SQL_DELETE_ALL_CONTAINERS;
     const char* sql2 = SQL_DELETE_CONTAINER_METRICS;
     const char* sql3 = SQL_DELETE_HOST_USAGE;
+    const char* sql4 = SQL_DELETE_HOST_CORE_USAGE;
+    const char* sql5 = SQL_DELETE_CONTAINER_PRESSURE;
+    const char* sql6 = SQL_DELETE_CONTAINER_PERCENTILES;
     char* err_msg = nullptr;
     if (sqlite3_exec(db_, sql1, nullptr, nullptr, &err_msg) != SQLITE_OK) {
         CM_LOG_ERROR << "Failed to clear containers table: " << (err_msg ? err_msg : "unknown error") << "\n";
@@ -138,11 +183,24 @@ void SQLiteDatabase::clearAll() {
         CM_LOG_ERROR << "Failed to clear host_usage table: " << (err_msg ? err_msg : "unknown error") << "\n";
         sqlite3_free(err_msg);
     }
+    if (sqlite3_exec(db_, sql4, nullptr, nullptr, &err_msg) != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to clear host_core_usage table: " << (err_msg ? err_msg : "unknown error") << "\n";
+        sqlite3_free(err_msg);
+    }
+    if (sqlite3_exec(db_, sql5, nullptr, nullptr, &err_msg) != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to clear container_pressure table: " << (err_msg ? err_msg : "unknown error") << "\n";
+        sqlite3_free(err_msg);
+    }
+    if (sqlite3_exec(db_, sql6, nullptr, nullptr, &err_msg) != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to clear container_percentiles table: " << (err_msg ? err_msg : "unknown error") << "\n";
+        sqlite3_free(err_msg);
+    }
     cache_.clear();
+    cache_loaded_ = true;
 }
 
 /**
- * @brief Sets up the database schema (tables).
+ * @brief Sets up the database schema (tables), upgrading tables created by older versions.
  */
 void SQLiteDatabase::setupSchema() {
     // Create containers table
@@ -162,6 +220,26 @@ void SQLiteDatabase::setupSchema() {
         sqlite3_free(errMsg);
     }
 
+    // A database from an older version keeps its container_metrics table; add the anomaly column
+    bool has_anomaly = false;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db_, SQL_TABLE_INFO_CONTAINER_METRICS, -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const unsigned char* column = sqlite3_column_text(stmt, 1);
+            if (column && std::strcmp(reinterpret_cast<const char*>(column), "anomaly") == 0) has_anomaly = true;
+        }
+        sqlite3_finalize(stmt);
+    }
+    if (!has_anomaly) {
+        rc = sqlite3_exec(db_, SQL_ADD_CONTAINER_METRICS_ANOMALY, nullptr, nullptr, &errMsg);
+        if (rc != SQLITE_OK) {
+            CM_LOG_ERROR << "Failed to add anomaly column to container_metrics table: " << errMsg << "\n";
+            sqlite3_free(errMsg);
+        } else {
+            CM_LOG_INFO << "Added anomaly column to existing container_metrics table\n";
+        }
+    }
+
     // Create host_usage table
     const char* create_host_usage_sql = SQL_CREATE_HOST_USAGE_TABLE;
     rc = sqlite3_exec(db_, create_host_usage_sql, nullptr, nullptr, &errMsg);
@@ -169,6 +247,30 @@ void SQLiteDatabase::setupSchema() {
         CM_LOG_ERROR << "Failed to create host_usage table: " << errMsg << "\n";
         sqlite3_free(errMsg);
     }
+
+    // Create host_core_usage table
+    const char* create_host_core_usage_sql = SQL_CREATE_HOST_CORE_USAGE_TABLE;
+    rc = sqlite3_exec(db_, create_host_core_usage_sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to create host_core_usage table: " << errMsg << "\n";
+        sqlite3_free(errMsg);
+    }
+
+    // Create container_pressure table
+    const char* create_container_pressure_sql = SQL_CREATE_CONTAINER_PRESSURE_TABLE;
+    rc = sqlite3_exec(db_, create_container_pressure_sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to create container_pressure table: " << errMsg << "\n";
+        sqlite3_free(errMsg);
+    }
+
+    // Create container_percentiles table
+    const char* create_container_percentiles_sql = SQL_CREATE_CONTAINER_PERCENTILES_TABLE;
+    rc = sqlite3_exec(db_, create_container_percentiles_sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        CM_LOG_ERROR << "Failed to create container_percentiles table: " << errMsg << "\n";
+        sqlite3_free(errMsg);
+    }
 }
 
 /**
@@ -188,10 +290,13 @@ void SQLiteDatabase::insertBatch(const std::string& container_name, const std::v
             sqlite3_bind_double(stmt, 3, metrics.cpu_usage_percent);
             sqlite3_bind_double(stmt, 4, metrics.memory_usage_percent);
             sqlite3_bind_double(stmt, 5, metrics.pids_percent);
+            sqlite3_bind_int(stmt, 6, metrics.anomaly_flags);
             sqlite3_step(stmt);
             sqlite3_reset(stmt);
         }
         sqlite3_finalize(stmt);
+    } else {
+        CM_LOG_ERROR << "Failed to prepare insert SQL for container_metrics: " << sqlite3_errmsg(db_) << "\n";
     }
 }
 
@@ -219,7 +324,8 @@ void SQLiteDatabase::exportAllTablesToCSV(const std::string& export_dir) {
                     file << sqlite3_column_int64(stmt, 1) << ",";
                     file << sqlite3_column_double(stmt, 2) << ",";
                     file << sqlite3_column_double(stmt, 3) << ",";
-                    file << sqlite3_column_double(stmt, 4) << "\n";
+                    file << sqlite3_column_double(stmt, 4) << ",";
+                    file << sqlite3_column_int(stmt, 5) << "\n";
                 }
                 sqlite3_finalize(stmt);
             } else {
@@ -250,6 +356,80 @@ void SQLiteDatabase::exportAllTablesToCSV(const std::string& export_dir) {
             file.close();
         }
     }
+
+    // Export host_core_usage table
+    {
+        std::string filename = export_dir + CSV_HOST_CORE_USAGE_FILENAME;
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            CM_LOG_ERROR << "Failed to open host_core_usage.csv for export: " << filename << "\n";
+        } else {
+            file << CSV_HOST_CORE_USAGE_HEADER;
+            const char* sql = SQL_SELECT_HOST_CORE_USAGE;
+            sqlite3_stmt* stmt;
+            if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+                while (sqlite3_step(stmt) == SQLITE_ROW) {
+                    file << sqlite3_column_int64(stmt, 0) << ",";
+                    file << sqlite3_column_int(stmt, 1) << ",";
+                    file << sqlite3_column_double(stmt, 2) << "\n";
+                }
+                sqlite3_finalize(stmt);
+            }
+            file.close();
+        }
+    }
+
+    // Export container_pressure table
+    {
+        std::string filename = export_dir + CSV_CONTAINER_PRESSURE_FILENAME;
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            CM_LOG_ERROR << "Failed to open container_pressure.csv for export: " << filename << "\n";
+        } else {
+            file << CSV_CONTAINER_PRESSURE_HEADER;
+            const char* sql = SQL_SELECT_CONTAINER_PRESSURE;
+            sqlite3_stmt* stmt;
+            if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+                while (sqlite3_step(stmt) == SQLITE_ROW) {
+                    file << reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)) << ",";
+                    file << sqlite3_column_int64(stmt, 1) << ",";
+                    file << reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)) << ",";
+                    file << sqlite3_column_double(stmt, 3) << ",";
+                    file << sqlite3_column_double(stmt, 4) << ",";
+                    file << sqlite3_column_int64(stmt, 5) << "\n";
+                }
+                sqlite3_finalize(stmt);
+            }
+            file.close();
+        }
+    }
+
+    // Export container_percentiles table
+    {
+        std::string filename = export_dir + CSV_CONTAINER_PERCENTILES_FILENAME;
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            CM_LOG_ERROR << "Failed to open container_percentiles.csv for export: " << filename << "\n";
+        } else {
+            file << CSV_CONTAINER_PERCENTILES_HEADER;
+            const char* sql = SQL_SELECT_CONTAINER_PERCENTILES;
+            sqlite3_stmt* stmt;
+            if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+                while (sqlite3_step(stmt) == SQLITE_ROW) {
+                    file << reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)) << ",";
+                    file << sqlite3_column_int64(stmt, 1) << ",";
+                    file << sqlite3_column_int64(stmt, 2) << ",";
+                    file << reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)) << ",";
+                    file << sqlite3_column_int64(stmt, 4) << ",";
+                    file << sqlite3_column_double(stmt, 5) << ",";
+                    file << sqlite3_column_double(stmt, 6) << ",";
+                    file << sqlite3_column_double(stmt, 7) << "\n";
+                }
+                sqlite3_finalize(stmt);
+            }
+            file.close();
+        }
+    }
 }
 
 /**
@@ -259,6 +439,7 @@ void SQLiteDatabase::exportAllTablesToCSV(const std::string& export_dir) {
  * @param mem_usage_percent Memory usage percent.
  */
 void SQLiteDatabase::saveHostUsage(int64_t timestamp_ms, double cpu_usage_percent, double mem_usage_percent) {
+    std::lock_guard<std::mutex> lock(db_mutex);
     if (!db_) return;
     const char* sql = SQL_INSERT_HOST_USAGE;
     sqlite3_stmt* stmt;
@@ -269,4 +450,87 @@ void SQLiteDatabase::saveHostUsage(int64_t timestamp_ms, double cpu_usage_percen
         sqlite3_step(stmt);
         sqlite3_finalize(stmt);
     }
+}
+
+/**
+ * @brief Inserts a batch of host usage samples, including their per-core breakdown.
+ * @param usage_vec Vector of HostUsage.
+ */
+void SQLiteDatabase::insertHostBatch(const std::vector<HostUsage>& usage_vec) {
+    std::lock_guard<std::mutex> lock(db_mutex);
+    if (!db_ || usage_vec.empty()) return;
+    const char* sql = SQL_INSERT_HOST_USAGE;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& usage : usage_vec) {
+            sqlite3_bind_int64(stmt, 1, usage.timestamp);
+            sqlite3_bind_double(stmt, 2, usage.cpu_usage_percent);
+            sqlite3_bind_double(stmt, 3, usage.memory_usage_percent);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    // Per-core rows, one per core and sample
+    if (sqlite3_prepare_v2(db_, SQL_INSERT_HOST_CORE_USAGE, -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& usage : usage_vec) {
+            for (size_t core = 0; core < usage.core_usage_percent.size(); ++core) {
+                sqlite3_bind_int64(stmt, 1, usage.timestamp);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(core));
+                sqlite3_bind_double(stmt, 3, usage.core_usage_percent[core]);
+                sqlite3_step(stmt);
+                sqlite3_reset(stmt);
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+}
+
+/**
+ * @brief Saves the pressure stall values of a container resource.
+ * @param sample PressureSample recorded when a pressure trigger fired.
+ */
+void SQLiteDatabase::savePressureSample(const PressureSample& sample) {
+    std::lock_guard<std::mutex> lock(db_mutex);
+    if (!db_) return;
+    const char* sql = SQL_INSERT_CONTAINER_PRESSURE;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, sample.container_name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, sample.timestamp);
+        sqlite3_bind_text(stmt, 3, sample.resource.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_double(stmt, 4, sample.some_avg10);
+        sqlite3_bind_double(stmt, 5, sample.full_avg10);
+        sqlite3_bind_int64(stmt, 6, static_cast<sqlite3_int64>(sample.some_total_us));
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+}
+
+/**
+ * @brief Inserts the percentiles of a container's closed windows.
+ * @param container_name Container name.
+ * @param percentiles_vec Vector of ContainerPercentiles.
+ */
+void SQLiteDatabase::insertPercentiles(const std::string& container_name, const std::vector<ContainerPercentiles>& percentiles_vec) {
+    std::lock_guard<std::mutex> lock(db_mutex);
+    if (!db_ || percentiles_vec.empty()) return;
+    const char* sql = SQL_INSERT_CONTAINER_PERCENTILES;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        for (const auto& percentiles : percentiles_vec) {
+            sqlite3_bind_text(stmt, 1, container_name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 2, percentiles.window_start);
+            sqlite3_bind_int64(stmt, 3, percentiles.window_ms);
+            sqlite3_bind_text(stmt, 4, percentiles.metric.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(percentiles.samples));
+            for (size_t i = 0; i < PERCENTILE_COUNT; ++i) {
+                sqlite3_bind_double(stmt, 6 + static_cast<int>(i), percentiles.values[i]);
+            }
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+    }
 }
\ No newline at end of file
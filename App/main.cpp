@@ -2,7 +2,7 @@
  * @file main.cpp
  * @brief Entry point for the Container Monitor application.
  *
- * Initializes configuration, logging, message queues, database, resource threads,
+ * Initializes configuration, logging, the shared-memory metrics table, database, resource threads,
  * event listeners/processors, UI components, and manages graceful shutdown.
  */
 
@@ -11,21 +11,30 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <algorithm>
 #include <csignal>
 #include <cerrno>
-#include <mqueue.h>
 #include "logger.hpp"
 #include "common.hpp"
 #include "initializer.hpp"
 #include "event_queue.hpp"
 #include "config_parser.hpp"
+#include "cgroup_watcher.hpp"
 #include "event_listener.hpp"
 #include "event_processor.hpp"
-#include "resource_monitor.hpp"
+#include "host_metrics_sampler.hpp"
+#include "memory_event_monitor.hpp"
+#include "pressure_monitor.hpp"
+#include "container_discovery.hpp"
+#include "container_metadata_cache.hpp"
 #include "sqlite_database.hpp"
+#include "container_registry.hpp"
 #include "monitor_dashboard.hpp"
 #include "resource_thread_pool.hpp"
 #include "live_metric_aggregator.hpp"
+#include "alert_channel.hpp"
+#include "alert_dispatcher.hpp"
 
 /**
  * @brief Atomic flag to signal application shutdown.
@@ -45,10 +54,12 @@ void SignalHandler(int signum) {
  * @brief Main entry point for the Container Monitor application.
  * 
  * - Parses configuration and initializes logging.
- * - Sets up message queues and signal handlers.
- * - Initializes database and resource thread pool.
- * - Starts event listener, processor, resource monitor, and UI components.
- * - Waits for shutdown signal and performs graceful cleanup.
+ * - Removes a stale metrics table and sets up signal handlers.
+ * - Initializes database, container registry, alert channel and resource thread pool.
+ * - Loads the container metadata cache and discovers containers that are already running.
+ * - Starts event listener (or cgroup watcher), processor, host sampler, alert dispatcher and UI components.
+ * - Reports the top CPU and memory consumers to the dashboard every second and to the log every minute.
+ * - Waits for shutdown signal, saves the metadata cache and performs graceful cleanup.
  * 
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line arguments.
@@ -61,8 +72,8 @@ int main(int argc, char* argv[]) {
     // Initialize glog if needed
     Initializer::initLogger(argc, argv, cfg);
     
-    // Ensure message queue is unlinked on startup
-    Initializer::unlinkMessageQueue();
+    // Ensure a metrics table left by a previous run is removed on startup
+    Initializer::unlinkMetricsTable();
     
     // Setup signal handlers for graceful shutdown
     Initializer::setupSignalHandlers(SignalHandler);
@@ -74,20 +85,66 @@ int main(int argc, char* argv[]) {
     std::vector<std::thread> worker_threads;
 
     // Initialize database interface
-    SQLiteDatabase db(cfg.db_path); 
+    SQLiteDatabase sqlite_db(cfg.db_path); 
     
     // Clear existing data and setup schema
-    db.clearAll();
-    db.setupSchema();
+    sqlite_db.clearAll();
+    sqlite_db.setupSchema();
+
+    // In-memory container registry, persisted to the database in the background
+    ContainerRegistry db(sqlite_db);
+    db.start();
+
+    // Load resolved container metadata from the previous run
+    ContainerMetadataCache metadata_cache(cfg.metadata_cache_path);
+    metadata_cache.load();
+
+    // Alerts detected by the samplers, delivered by the alert dispatcher
+    AlertChannel alert_channel(ALERT_CHANNEL_CAPACITY);
 
     // Initialize resource thread pool
-    ResourceThreadPool thread_pool(cfg, shutdown_requested, db);
+    ResourceThreadPool thread_pool(cfg, shutdown_requested, db, &alert_channel);
     thread_pool.start();
 
+    // Containers saved to or removed from the database are pushed straight to the thread pool
+    db.addObserver(&thread_pool);
+
+    // Memory threshold and OOM notifications registered with the kernel per container
+    std::unique_ptr<MemoryEventMonitor> memory_event_monitor;
+    if (cfg.memory_events_enabled) {
+        memory_event_monitor = std::make_unique<MemoryEventMonitor>(cfg, shutdown_requested);
+        memory_event_monitor->start();
+        db.addObserver(memory_event_monitor.get());
+    }
+
+    // Pressure stall triggers raise the sampling rate of contended containers (cgroup v2)
+    std::unique_ptr<PressureMonitor> pressure_monitor;
+    if (cfg.psi_enabled) {
+        pressure_monitor = std::make_unique<PressureMonitor>(cfg, db, thread_pool, shutdown_requested);
+        pressure_monitor->start();
+        db.addObserver(pressure_monitor.get());
+    }
+
+    // Containers are discovered either from runtime events or by watching the cgroup filesystem
+    bool cgroupfs_discovery = (cfg.discovery_mode == "cgroupfs");
+
     // Create worker objects as unique_ptr
-    auto event_listener = std::make_unique<RuntimeEventListener>(cfg, *event_queue, shutdown_requested);
-    auto event_processor = std::make_unique<EventProcessor>(*event_queue, shutdown_requested, db, cfg);
-    auto resource_monitor = std::make_unique<ResourceMonitor>(db, shutdown_requested, thread_pool);
+    std::unique_ptr<RuntimeEventListener> event_listener;
+    std::unique_ptr<CgroupWatcher> cgroup_watcher;
+    if (cgroupfs_discovery) {
+        cgroup_watcher = std::make_unique<CgroupWatcher>(cfg, db, shutdown_requested);
+    } else {
+        event_listener = std::make_unique<RuntimeEventListener>(cfg, *event_queue, shutdown_requested);
+    }
+    auto host_sampler = std::make_unique<HostMetricsSampler>(cfg, db, shutdown_requested);
+    auto event_processor = std::make_unique<EventProcessor>(*event_queue, shutdown_requested, db, cfg, &metadata_cache);
+
+    // Seed containers that were running before startup; events since the scan began are replayed
+    if (event_listener && cfg.startup_discovery_enabled) {
+        event_listener->setSince(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        ContainerDiscovery(cfg, db, thread_pool, &metadata_cache).discover();
+    }
 
     // Create UI components
     std::unique_ptr<MonitorDashboard> monitor_dashboard;
@@ -99,14 +156,23 @@ int main(int argc, char* argv[]) {
         live_metric_aggregator = std::make_unique<LiveMetricAggregator>(shutdown_requested, monitor_dashboard.get(), cfg.ui_refresh_interval_ms);
     }
 
-    // Start event listener
-    worker_threads.emplace_back([&](){ event_listener->start(); });    
+    // Deliver alerts to the log, the dashboard and socket subscribers
+    AlertDispatcher alert_dispatcher(cfg, alert_channel, monitor_dashboard.get());
+    alert_dispatcher.start();
+
+    // Start event listener or cgroup watcher
+    if (event_listener) {
+        worker_threads.emplace_back([&](){ event_listener->start(); });
+    }
+    if (cgroup_watcher) {
+        worker_threads.emplace_back([&](){ cgroup_watcher->start(); });
+    }
     
     // Start event processor
     worker_threads.emplace_back([&](){ event_processor->start(); });
-    
-    // Start resource monitor thread
-    worker_threads.emplace_back([&](){ resource_monitor->start(); });
+
+    // Start host metrics sampler
+    worker_threads.emplace_back([&](){ host_sampler->start(); });
     
     // Start UI components if enabled
     if (cfg.ui_enabled && monitor_dashboard) {
@@ -118,21 +184,47 @@ int main(int argc, char* argv[]) {
         worker_threads.emplace_back([&](){ live_metric_aggregator->start(); });
     }
 
-    // Main thread waits for shutdown signal
+    // Main thread reports the top consumers until the shutdown signal
+    size_t top_k = static_cast<size_t>(std::max(cfg.heavy_hitter_top_k, 1));
+    int64_t last_report_ms = 0;
+    int64_t last_log_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::vector<HeavyHitter> top_cpu, top_memory;
     while (!shutdown_requested) {
         std::this_thread::sleep_for(std::chrono::milliseconds(MAIN_LOOP_SLEEP_MS));
+        int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        if (monitor_dashboard && now_ms - last_report_ms >= HEAVY_HITTER_REPORT_MS) {
+            thread_pool.topConsumers(top_k, now_ms, top_cpu, top_memory);
+            monitor_dashboard->pushTopConsumers(top_cpu, top_memory);
+            last_report_ms = now_ms;
+        }
+        if (now_ms - last_log_ms >= HEAVY_HITTER_LOG_MS) {
+            thread_pool.logTopConsumers(top_k, now_ms);
+            last_log_ms = now_ms;
+        }
     }
 
     // Shutdown thread pool first to stop resource collection
     thread_pool.stop();
 
-    // Stop event listener and processor
-    event_listener->stop();
+    // Deliver the remaining alerts, including those cleared by the stopping thread pool
+    alert_dispatcher.stop();
+
+    // Stop event listener (or cgroup watcher) and processor
+    if (event_listener) event_listener->stop();
+    if (cgroup_watcher) cgroup_watcher->stop();
     event_processor->stop();
 
-    // Stop resource monitor
-    resource_monitor->stop();
-    
+    // Stop host metrics sampler
+    host_sampler->stop();
+
+    // Stop memory event monitor
+    if (memory_event_monitor) memory_event_monitor->stop();
+
+    // Stop pressure monitor
+    if (pressure_monitor) pressure_monitor->stop();
+
     // Stop UI components if running
     if (cfg.ui_enabled && live_metric_aggregator) {
         live_metric_aggregator->stop();
@@ -148,6 +240,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // Persist pending container registry writes
+    db.stop();
+
+    // Persist resolved container metadata for the next start
+    metadata_cache.save();
+
     // Export container metrics to a file before shutdown
     db.exportAllTablesToCSV(cfg.file_export_folder_path);
     CM_LOG_INFO << "Container metrics exported to CSV at: " << cfg.file_export_folder_path << "\n";
@@ -0,0 +1,132 @@
+/**
+ * @file alert_engine.hpp
+ * @brief Declares the AlertEngine class, which evaluates threshold and rate-of-change alert rules per sample.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "common.hpp"
+
+/**
+ * @struct AlertRule
+ * @brief A compiled alert rule.
+ */
+struct AlertRule {
+    AlertMetric metric;             ///< Watched metric.
+    AlertSeverity severity;         ///< Severity of the alert.
+    AlertKind kind;                 ///< Threshold, rate-of-change or forecast condition.
+    double raise_level;             ///< Level at or above which the condition holds (forecast: at or below, in seconds).
+    double clear_level;             ///< Level below which an active alert clears (forecast: above, in seconds).
+    int64_t min_duration_ms;        ///< Time the condition must hold before the alert fires.
+};
+
+/**
+ * @struct AlertRuleState
+ * @brief Evaluation state of one rule for one container.
+ */
+struct AlertRuleState {
+    bool active = false;            ///< Whether the alert is raised.
+    int64_t pending_since_ms = -1;  ///< Time the condition started to hold (-1 if it does not).
+};
+
+/**
+ * @struct AlertState
+ * @brief Evaluation state of all rules for one container, owned by its sampler thread.
+ */
+struct AlertState {
+    std::vector<AlertRuleState> rules;  ///< State per rule, in rule set order.
+    bool has_prev = false;              ///< Whether prev holds a sample.
+    ContainerMetrics prev{};            ///< Previous sample, for rate-of-change rules.
+};
+
+/**
+ * @class AlertEngine
+ * @brief Evaluates alert rules against every sample, inline in the sampler.
+ *
+ * The rule set is compiled once from the configuration into a flat array: for CPU,
+ * memory and PIDs a warning and a critical threshold rule (alert_warning and
+ * alert_critical), plus a rate-of-change rule if alert_rate_per_second is set, and for
+ * memory and PIDs a forecast rule if forecast_horizon_ms is set. A sample is evaluated
+ * with one pass over the array and no allocation.
+ *
+ * A threshold rule fires once its metric stayed at or above the level for
+ * alert_min_duration_ms and clears only after falling alert_hysteresis points below it,
+ * so values hovering at a threshold do not flap. A rate rule fires on the first sample
+ * rising at least alert_rate_per_second points per second and clears once the rise is
+ * below ALERT_RATE_CLEAR_FRACTION of that. A forecast rule fires once the forecast time
+ * until the limit stayed within the horizon for alert_min_duration_ms and clears when the
+ * usage stops rising or the limit moves beyond FORECAST_CLEAR_FACTOR times the horizon.
+ */
+class AlertEngine {
+public:
+    /**
+     * @brief Compiles the rule set.
+     * @param cfg Monitor configuration (uses the alert_* settings).
+     */
+    explicit AlertEngine(const MonitorConfig& cfg);
+
+    /**
+     * @brief Returns the compiled rule set.
+     * @return Rules in evaluation order.
+     */
+    const std::vector<AlertRule>& rules() const;
+
+    /**
+     * @brief Returns a fresh evaluation state for a container.
+     * @return State with all alerts inactive.
+     */
+    AlertState makeState() const;
+
+    /**
+     * @brief Evaluates all rules against a sample.
+     * @param name Container name.
+     * @param metrics Latest sample.
+     * @param forecast Time-to-limit forecast including the sample.
+     * @param state Container's evaluation state.
+     * @param events Receives the alerts that fired or cleared (appended).
+     */
+    void evaluate(const std::string& name, const ContainerMetrics& metrics, const ContainerForecast& forecast,
+                  AlertState& state, std::vector<AlertEvent>& events) const;
+
+    /**
+     * @brief Clears all active alerts of a container, e.g. when it is no longer monitored.
+     * @param name Container name.
+     * @param state Container's evaluation state.
+     * @param timestamp_ms Current time in milliseconds.
+     * @param events Receives the cleared alerts (appended).
+     */
+    void clearAll(const std::string& name, AlertState& state, int64_t timestamp_ms,
+                  std::vector<AlertEvent>& events) const;
+
+private:
+    /**
+     * @brief Builds an alert for a rule transition.
+     * @param index Rule index.
+     * @param name Container name.
+     * @param timestamp_ms Sample time in milliseconds.
+     * @param value Value that caused the transition.
+     * @param raised True if the alert fired, false if it cleared.
+     * @return The alert.
+     */
+    AlertEvent makeEvent(size_t index, const std::string& name, int64_t timestamp_ms, double value, bool raised) const;
+
+    /**
+     * @brief Returns the value of a metric in a sample.
+     * @param metrics Sample.
+     * @param metric Metric.
+     * @return Value in percent.
+     */
+    static double metricValue(const ContainerMetrics& metrics, AlertMetric metric);
+
+    /**
+     * @brief Returns the forecast time until a metric reaches its limit.
+     * @param forecast Forecast.
+     * @param metric Metric (memory or PIDs).
+     * @return Seconds, or FORECAST_NONE if not approaching.
+     */
+    static double forecastValue(const ContainerForecast& forecast, AlertMetric metric);
+
+    std::vector<AlertRule> rules_;      ///< Compiled rule set.
+};
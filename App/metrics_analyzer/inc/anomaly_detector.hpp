@@ -0,0 +1,49 @@
+/**
+ * @file anomaly_detector.hpp
+ * @brief Declares the AnomalyDetector class, which flags samples far from their EWMA mean.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include "common.hpp"
+
+/**
+ * @class AnomalyDetector
+ * @brief Streaming z-score test of a container's CPU, memory and PIDs usage.
+ *
+ * Keeps an exponentially weighted mean and variance per metric (weight
+ * ANOMALY_EWMA_ALPHA). A sample is anomalous when it lies more than sigma standard
+ * deviations from the mean of the samples before it; the standard deviation is floored
+ * at ANOMALY_MIN_STDDEV so that tiny moves of a flat metric are not flagged. Nothing is
+ * flagged during the first ANOMALY_WARMUP_SAMPLES samples.
+ *
+ * Each update is a fixed loop over three metrics with no data-dependent branches and
+ * no allocation; the state is a few doubles per container.
+ */
+class AnomalyDetector {
+public:
+    /**
+     * @brief Constructs an empty detector.
+     * @param sigma Standard deviations from the mean at which a sample is anomalous.
+     */
+    explicit AnomalyDetector(double sigma = DEFAULT_ANOMALY_SIGMA);
+
+    /**
+     * @brief Tests a sample and adds it to the means and variances.
+     * @param metrics Latest sample.
+     * @return Anomalous metrics (ANOMALY_FLAG_* bits).
+     */
+    uint8_t update(const ContainerMetrics& metrics);
+
+    /**
+     * @brief Forgets all samples.
+     */
+    void clear();
+
+private:
+    std::array<double, ANOMALY_METRICS> mean_{};     ///< EWMA mean per metric.
+    std::array<double, ANOMALY_METRICS> variance_{}; ///< EWMA variance per metric.
+    double threshold_;                                ///< Squared sigma.
+    uint32_t count_ = 0;                              ///< Samples seen (saturates at ANOMALY_WARMUP_SAMPLES).
+};
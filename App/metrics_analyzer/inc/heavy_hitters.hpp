@@ -0,0 +1,96 @@
+/**
+ * @file heavy_hitters.hpp
+ * @brief Declares the HeavyHitters class, a Space-Saving summary of the top consumers of a resource.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "common.hpp"
+
+/**
+ * @class HeavyHitters
+ * @brief Weighted Space-Saving summary with exponential decay.
+ *
+ * Tracks at most capacity counters, no matter how many containers come and go. A
+ * tracked container adds its weight to its counter; an untracked one takes over the
+ * smallest counter, inheriting its weight as the error bound. Every container whose
+ * weight exceeds 1/capacity of the total is guaranteed to be tracked, and a counter
+ * never underestimates by more than its error.
+ *
+ * Weights decay with a half-life (forward decay): a sample is added scaled by
+ * 2^((t - landmark) / half_life), which leaves the order of the counters unchanged, and
+ * weights are scaled back to the query time when reported. The landmark moves forward
+ * before the scale gets large, so the counters never overflow.
+ *
+ * The counters form a min-heap indexed by name: updates are O(log capacity).
+ */
+class HeavyHitters {
+public:
+    /**
+     * @brief Constructs an empty summary.
+     * @param capacity Number of counters.
+     * @param half_life_ms Half-life of past weight in milliseconds.
+     */
+    HeavyHitters(size_t capacity, double half_life_ms = HEAVY_HITTER_HALF_LIFE_MS);
+
+    /**
+     * @brief Adds weight for a container.
+     * @param name Container name.
+     * @param weight Weight to add (ignored unless positive).
+     * @param timestamp_ms Sample time in milliseconds.
+     */
+    void add(const std::string& name, double weight, int64_t timestamp_ms);
+
+    /**
+     * @brief Returns the heaviest containers.
+     * @param k Maximum number of containers.
+     * @param now_ms Time to decay the weights to.
+     * @return Up to k containers by descending weight.
+     */
+    std::vector<HeavyHitter> top(size_t k, int64_t now_ms) const;
+
+    /**
+     * @brief Returns the number of tracked containers.
+     * @return Tracked containers (at most the capacity).
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @struct Counter
+     * @brief A tracked container.
+     */
+    struct Counter {
+        std::string name;   ///< Container name.
+        double weight;      ///< Weight scaled to the landmark.
+        double error;       ///< Overestimate bound scaled to the landmark.
+    };
+
+    /**
+     * @brief Moves the counter at a heap position up until its parent is lighter.
+     * @param position Heap position.
+     */
+    void siftUp(size_t position);
+
+    /**
+     * @brief Moves the counter at a heap position down until its children are heavier.
+     * @param position Heap position.
+     */
+    void siftDown(size_t position);
+
+    /**
+     * @brief Swaps two heap positions and updates the index.
+     * @param a First position.
+     * @param b Second position.
+     */
+    void swapCounters(size_t a, size_t b);
+
+    size_t capacity_;                                   ///< Maximum number of counters.
+    double half_life_ms_;                               ///< Half-life of past weight.
+    int64_t landmark_ms_ = -1;                          ///< Time at which the scale is 1 (-1 before the first sample).
+    std::vector<Counter> heap_;                         ///< Counters, lightest first.
+    std::unordered_map<std::string, size_t> index_;     ///< Container name to heap position.
+};
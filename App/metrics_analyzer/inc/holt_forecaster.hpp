@@ -0,0 +1,71 @@
+/**
+ * @file holt_forecaster.hpp
+ * @brief Declares the HoltForecaster class, which forecasts when a metric reaches a limit.
+ */
+
+#pragma once
+#include <cstdint>
+#include "common.hpp"
+
+/**
+ * @class HoltForecaster
+ * @brief Holt's linear (double exponential) smoothing of a metric over irregular samples.
+ *
+ * Keeps a smoothed level and a smoothed trend per millisecond. Each sample first
+ * projects the level along the trend to the sample time, blends in the new value, and
+ * then blends the level change into the trend. The blend weights follow from the time
+ * since the previous sample, 1 - exp(-dt / tau), so the smoothing does not depend on
+ * the sampling interval, which changes with adaptive sampling and pressure boosts.
+ *
+ * Updates and forecasts are O(1) with no sample history, so every container can be
+ * forecast on every sample in the sampler thread.
+ */
+class HoltForecaster {
+public:
+    /**
+     * @brief Constructs an empty forecaster.
+     * @param level_tau_ms Time constant of the level in milliseconds.
+     * @param trend_tau_ms Time constant of the trend in milliseconds.
+     */
+    HoltForecaster(double level_tau_ms = FORECAST_LEVEL_TAU_MS, double trend_tau_ms = FORECAST_TREND_TAU_MS);
+
+    /**
+     * @brief Adds a sample.
+     * @param timestamp_ms Sample time in milliseconds.
+     * @param value Metric value.
+     */
+    void update(int64_t timestamp_ms, double value);
+
+    /**
+     * @brief Forgets all samples.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the smoothed level.
+     * @return Level (0 before the first sample).
+     */
+    double level() const;
+
+    /**
+     * @brief Returns the smoothed trend.
+     * @return Change per second.
+     */
+    double trendPerSecond() const;
+
+    /**
+     * @brief Forecasts the time until the metric reaches a limit.
+     * @param limit Limit value.
+     * @return Seconds until the limit (0 if reached), or FORECAST_NONE if the trend is
+     *         not rising or fewer than FORECAST_WARMUP_MS were observed.
+     */
+    double secondsUntil(double limit) const;
+
+private:
+    double level_tau_ms_;       ///< Time constant of the level.
+    double trend_tau_ms_;       ///< Time constant of the trend.
+    double level_ = 0.0;        ///< Smoothed level.
+    double trend_ = 0.0;        ///< Smoothed change per millisecond.
+    int64_t first_ms_ = -1;     ///< Time of the first sample (-1 before it).
+    int64_t last_ms_ = -1;      ///< Time of the latest sample (-1 before it).
+};
@@ -5,6 +5,9 @@
 
 #pragma once
 #include <string>
+#include <vector>
+#include <utility>
+#include <sys/types.h>
 #include "common.hpp"
 
 /**
@@ -13,6 +16,7 @@
  *
  * Provides methods to read memory, pids, and CPU usage for containers,
  * as well as host CPU and memory usage. Supports conversion to percentages.
+ * Host files are kept open and re-read with pread into a stack buffer.
  */
 class MetricsReader {
 public:
@@ -23,6 +27,14 @@ public:
      */
     MetricsReader(const ContainerResourcePaths& paths, int num_cpus);
 
+    /**
+     * @brief Destructor. Closes the host /proc file descriptors.
+     */
+    ~MetricsReader();
+
+    MetricsReader(const MetricsReader&) = delete;
+    MetricsReader& operator=(const MetricsReader&) = delete;
+
     // Container metrics
 
     /**
@@ -61,10 +73,19 @@ public:
 
     /**
      * @brief Gets host CPU usage percentage.
+     *
+     * Also updates the per-core usage returned by getHostCoreUsagePercentages().
+     *
      * @return CPU usage percent.
      */
     double getHostCpuUsagePercentage();
 
+    /**
+     * @brief Gets per-core CPU usage computed by the last getHostCpuUsagePercentage() call.
+     * @return CPU usage percent per core, indexed by core number.
+     */
+    const std::vector<double>& getHostCoreUsagePercentages() const;
+
     /**
      * @brief Gets host memory usage percentage.
      * @return Memory usage percent.
@@ -78,10 +99,102 @@ public:
      */
     uint64_t readUintFromFile(const std::string& path);
 
+    /**
+     * @brief Reads an unsigned integer value from a file, reporting failure.
+     * @param path File path.
+     * @param value Reference to receive the value.
+     * @return True if the file could be opened and parsed, false otherwise.
+     */
+    static bool tryReadUintFromFile(const std::string& path, uint64_t& value);
+
+    /**
+     * @brief Reads the cumulative CPU time of a container in nanoseconds.
+     *
+     * Accepts both cgroup v1 cpuacct.usage and cgroup v2 cpu.stat.
+     *
+     * @param path CPU usage file path.
+     * @param cpu_usage_ns Reference to receive the CPU time in nanoseconds.
+     * @return True if the file could be opened and parsed, false otherwise.
+     */
+    static bool tryReadCpuUsageNs(const std::string& path, uint64_t& cpu_usage_ns);
+
+    /**
+     * @brief Reads a complete usage sample of the container.
+     *
+     * Unlike the individual getters, a missing file is reported instead of read as zero,
+     * so a sample is only produced while the container's cgroup exists.
+     *
+     * @param info ContainerInfo struct.
+     * @param cpu_usage_ns Reference to receive the cumulative CPU time in nanoseconds.
+     * @param memory_percent Reference to receive the memory usage percent.
+     * @param memory_bytes Reference to receive the memory usage in bytes (also without a limit).
+     * @param pids_percent Reference to receive the pids usage percent.
+     * @return True if all resource files were read, false otherwise.
+     */
+    bool readUsage(const ContainerInfo& info, uint64_t& cpu_usage_ns, double& memory_percent, uint64_t& memory_bytes,
+                   double& pids_percent);
+
+    /**
+     * @brief Reads a memory high-water mark through a persistent descriptor.
+     *
+     * The file is opened read-write on first use so the mark can be reset, falling
+     * back to read-only where resets are not permitted.
+     *
+     * @param fd Descriptor, opened on first use (-1 if not yet open).
+     * @param path High-water mark file path (memory.max_usage_in_bytes or memory.peak).
+     * @param peak_bytes Reference to receive the high-water mark in bytes.
+     * @return True if the mark could be read, false otherwise.
+     */
+    static bool readMemoryPeak(int& fd, const std::string& path, uint64_t& peak_bytes);
+
+    /**
+     * @brief Resets a memory high-water mark to the current usage.
+     *
+     * On cgroup v2 the reset only applies to reads through the same descriptor.
+     *
+     * @param fd Descriptor opened by readMemoryPeak.
+     * @return True if the kernel accepted the reset, false otherwise.
+     */
+    static bool resetMemoryPeak(int fd);
+
+    /**
+     * @brief Reads container resource limits directly from cgroup limit files.
+     *
+     * An unlimited CPU quota, memory limit or pids.max is reported as 0, matching
+     * what the runtime reports for unconstrained containers.
+     *
+     * @param paths Limit file paths for the container.
+     * @param info ContainerInfo whose cpu_limit, memory_limit and pid_limit are filled in.
+     * @return True if the memory limit file could be read, false otherwise.
+     */
+    static bool readContainerLimits(const ContainerLimitPaths& paths, ContainerInfo& info);
+
 private:
+    /**
+     * @brief Reads a /proc file from offset 0 through a persistent descriptor.
+     * @param fd Descriptor, opened on first use (-1 if not yet open).
+     * @param path File path.
+     * @param buf Destination buffer; the content is NUL terminated.
+     * @param size Buffer size.
+     * @return Number of bytes read, or -1 on error.
+     */
+    static ssize_t preadProcFile(int& fd, const char* path, char* buf, size_t size);
+
+    /**
+     * @brief Computes a usage percentage from two tick samples.
+     * @param total Current total ticks.
+     * @param idle Current idle ticks.
+     * @param last Previous total and idle ticks, updated in place.
+     * @return Usage percent (0 for the first sample).
+     */
+    double tickUsage(uint64_t total, uint64_t idle, std::pair<uint64_t, uint64_t>& last) const;
+
     ContainerResourcePaths paths_;      ///< Resource file paths for the container.
     double round2(double val) const;    ///< Rounds a value to two decimal places.
     int num_cpus_;                      ///< Number of CPUs on the host.
-    uint64_t last_total = 0;            ///< Last total CPU ticks (for host CPU usage).
-    uint64_t last_idle = 0;             ///< Last idle CPU ticks (for host CPU usage).
+    std::pair<uint64_t, uint64_t> last_ticks_{0, 0};             ///< Last total and idle CPU ticks (host).
+    std::vector<std::pair<uint64_t, uint64_t>> last_core_ticks_; ///< Last total and idle ticks per core.
+    std::vector<double> core_usage_;    ///< Per-core CPU usage percent of the last sample.
+    int proc_stat_fd_ = -1;             ///< Persistent descriptor for /proc/stat.
+    int proc_meminfo_fd_ = -1;          ///< Persistent descriptor for /proc/meminfo.
 };
\ No newline at end of file
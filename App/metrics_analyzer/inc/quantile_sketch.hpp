@@ -0,0 +1,97 @@
+/**
+ * @file quantile_sketch.hpp
+ * @brief Declares the QuantileSketch class, a mergeable log-bucket histogram for streaming percentiles.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "common.hpp"
+
+/**
+ * @class QuantileSketch
+ * @brief Streaming percentiles of a non-negative metric with bounded relative error.
+ *
+ * Values are counted in logarithmic buckets whose bounds grow by a factor of
+ * (1 + a) / (1 - a), with a = QUANTILE_SKETCH_RELATIVE_ACCURACY, between
+ * QUANTILE_SKETCH_MIN_VALUE and QUANTILE_SKETCH_MAX_VALUE; smaller values share a zero
+ * bucket and larger ones the last bucket. Every bucket reports the value within a
+ * relative error of a from all values it holds, so any percentile is accurate to a
+ * (and clamped to the exact min and max).
+ *
+ * Adding a value is O(1) and the memory is fixed. Two sketches merge by adding their
+ * bucket counts, so the sketch of a longer window is the exact merge of the sketches
+ * of its sub-windows, without keeping the samples.
+ *
+ * A value can carry a weight, e.g. the time it was held for, so that percentiles of
+ * irregularly spaced samples are percentiles over time rather than over samples.
+ */
+class QuantileSketch {
+public:
+    /**
+     * @brief Constructs an empty sketch.
+     */
+    QuantileSketch();
+
+    /**
+     * @brief Adds a value.
+     * @param value Value to add (negative values count as zero).
+     * @param weight Weight of the value (0 counts as 1).
+     */
+    void add(double value, uint64_t weight = 1);
+
+    /**
+     * @brief Adds all values of another sketch.
+     * @param other Sketch to merge into this one.
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Removes all values.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of values added.
+     * @return Number of values.
+     */
+    uint64_t count() const;
+
+    /**
+     * @brief Returns a percentile.
+     * @param rank Percentile as a fraction in [0, 1].
+     * @return Percentile value (0 if empty).
+     */
+    double quantile(double rank) const;
+
+    /**
+     * @brief Returns several percentiles in a single pass over the buckets.
+     * @param ranks Percentiles as fractions in [0, 1], in ascending order.
+     * @param values Receives one value per rank.
+     * @param count Number of ranks.
+     */
+    void quantiles(const double* ranks, double* values, size_t count) const;
+
+private:
+    /**
+     * @brief Returns the bucket of a value.
+     * @param value Value of at least QUANTILE_SKETCH_MIN_VALUE.
+     * @return Bucket index.
+     */
+    static size_t bucketIndex(double value);
+
+    /**
+     * @brief Returns the value a bucket reports.
+     * @param index Bucket index.
+     * @return Value within the relative accuracy of all values in the bucket.
+     */
+    static double bucketValue(size_t index);
+
+    std::array<uint64_t, QUANTILE_SKETCH_BUCKETS> buckets_; ///< Weight per logarithmic bucket.
+    uint64_t zero_weight_;      ///< Weight of values below QUANTILE_SKETCH_MIN_VALUE.
+    uint64_t count_;            ///< Total number of values.
+    uint64_t weight_;           ///< Total weight of all values.
+    double min_;                ///< Smallest value added.
+    double max_;                ///< Largest value added.
+};
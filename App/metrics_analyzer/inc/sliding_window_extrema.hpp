@@ -0,0 +1,71 @@
+/**
+ * @file sliding_window_extrema.hpp
+ * @brief Declares the SlidingWindowExtrema class for the max and min of a metric over a time window.
+ */
+
+#pragma once
+#include <deque>
+#include <cstdint>
+
+/**
+ * @class SlidingWindowExtrema
+ * @brief Maximum and minimum of a metric over the last window_ms milliseconds.
+ *
+ * Keeps two monotonic deques of (timestamp, value): the max deque holds decreasing values,
+ * the min deque increasing ones. A new sample first drops the samples it dominates from
+ * the back, then samples older than the window are dropped from the front, so the
+ * extremes are always at the front. Each sample is pushed and popped at most once per
+ * deque, giving O(1) amortized updates and O(1) queries.
+ */
+class SlidingWindowExtrema {
+public:
+    /**
+     * @brief Constructs an empty window.
+     * @param window_ms Window length in milliseconds (0 keeps only the latest sample).
+     */
+    explicit SlidingWindowExtrema(int64_t window_ms = 0);
+
+    /**
+     * @brief Adds a sample and drops samples that fell out of the window.
+     * @param timestamp_ms Sample time in milliseconds (non-decreasing).
+     * @param value Sample value.
+     */
+    void push(int64_t timestamp_ms, double value);
+
+    /**
+     * @brief Removes all samples.
+     */
+    void clear();
+
+    /**
+     * @brief Checks whether the window holds no samples.
+     * @return True if empty.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the maximum over the window.
+     * @return Maximum value (0 if empty).
+     */
+    double max() const;
+
+    /**
+     * @brief Returns the minimum over the window.
+     * @return Minimum value (0 if empty).
+     */
+    double min() const;
+
+private:
+    /**
+     * @struct Sample
+     * @brief A timestamped value.
+     */
+    struct Sample {
+        int64_t timestamp_ms;   ///< Sample time in milliseconds.
+        double value;           ///< Sample value.
+    };
+
+    int64_t window_ms_;             ///< Window length in milliseconds.
+    std::deque<Sample> max_deque_;  ///< Candidates for the maximum, values decreasing.
+    std::deque<Sample> min_deque_;  ///< Candidates for the minimum, values increasing.
+};
@@ -0,0 +1,182 @@
+/**
+ * @file alert_engine.cpp
+ * @brief Implements the AlertEngine class, which evaluates threshold and rate-of-change alert rules per sample.
+ */
+
+#include "alert_engine.hpp"
+#include <ctime>
+#include <cstring>
+#include <algorithm>
+#include "logger.hpp"
+
+/**
+ * @brief Compiles the rule set.
+ * @param cfg Monitor configuration (uses the alert_* settings).
+ */
+AlertEngine::AlertEngine(const MonitorConfig& cfg) {
+    int64_t min_duration_ms = std::max(cfg.alert_min_duration_ms, 0);
+    for (AlertMetric metric : {AlertMetric::Cpu, AlertMetric::Memory, AlertMetric::Pids}) {
+        rules_.push_back({metric, AlertSeverity::Warning, AlertKind::Threshold,
+                          cfg.alert_warning, cfg.alert_warning - cfg.alert_hysteresis, min_duration_ms});
+        rules_.push_back({metric, AlertSeverity::Critical, AlertKind::Threshold,
+                          cfg.alert_critical, cfg.alert_critical - cfg.alert_hysteresis, min_duration_ms});
+        if (cfg.alert_rate_per_second > 0) {
+            rules_.push_back({metric, AlertSeverity::Warning, AlertKind::Rate, cfg.alert_rate_per_second,
+                              cfg.alert_rate_per_second * ALERT_RATE_CLEAR_FRACTION, 0});
+        }
+        if (cfg.forecast_horizon_ms > 0 && metric != AlertMetric::Cpu) {
+            double horizon_s = cfg.forecast_horizon_ms / MILLISECONDS_PER_SECOND;
+            rules_.push_back({metric, AlertSeverity::Warning, AlertKind::Forecast, horizon_s,
+                              horizon_s * FORECAST_CLEAR_FACTOR, min_duration_ms});
+        }
+    }
+    CM_LOG_INFO << "[AlertEngine] Compiled " << rules_.size() << " alert rules\n";
+}
+
+/**
+ * @brief Returns the compiled rule set.
+ * @return Rules in evaluation order.
+ */
+const std::vector<AlertRule>& AlertEngine::rules() const {
+    return rules_;
+}
+
+/**
+ * @brief Returns a fresh evaluation state for a container.
+ * @return State with all alerts inactive.
+ */
+AlertState AlertEngine::makeState() const {
+    AlertState state;
+    state.rules.resize(rules_.size());
+    return state;
+}
+
+/**
+ * @brief Evaluates all rules against a sample.
+ * @param name Container name.
+ * @param metrics Latest sample.
+ * @param forecast Time-to-limit forecast including the sample.
+ * @param state Container's evaluation state.
+ * @param events Receives the alerts that fired or cleared (appended).
+ */
+void AlertEngine::evaluate(const std::string& name, const ContainerMetrics& metrics, const ContainerForecast& forecast,
+                           AlertState& state, std::vector<AlertEvent>& events) const {
+    int64_t interval_ms = state.has_prev ? metrics.timestamp - state.prev.timestamp : 0;
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        const AlertRule& rule = rules_[i];
+        AlertRuleState& rule_state = state.rules[i];
+        double value = metricValue(metrics, rule.metric);
+        if (rule.kind == AlertKind::Rate) {
+            // Rise per second since the previous sample; needs two samples
+            if (interval_ms <= 0) continue;
+            value = (value - metricValue(state.prev, rule.metric)) * MILLISECONDS_PER_SECOND / interval_ms;
+        }
+
+        // A forecast holds while the limit is near, i.e. the time until it is short
+        bool holds, clears;
+        if (rule.kind == AlertKind::Forecast) {
+            value = forecastValue(forecast, rule.metric);
+            holds = value >= 0.0 && value <= rule.raise_level;
+            clears = value < 0.0 || value > rule.clear_level;
+        } else {
+            holds = value >= rule.raise_level;
+            clears = value < rule.clear_level;
+        }
+
+        if (rule_state.active) {
+            if (clears) {
+                rule_state.active = false;
+                rule_state.pending_since_ms = -1;
+                events.push_back(makeEvent(i, name, metrics.timestamp, value, false));
+            }
+        } else if (holds) {
+            if (rule_state.pending_since_ms < 0) rule_state.pending_since_ms = metrics.timestamp;
+            if (metrics.timestamp - rule_state.pending_since_ms >= rule.min_duration_ms) {
+                rule_state.active = true;
+                events.push_back(makeEvent(i, name, metrics.timestamp, value, true));
+            }
+        } else {
+            rule_state.pending_since_ms = -1;
+        }
+    }
+    state.prev = metrics;
+    state.has_prev = true;
+}
+
+/**
+ * @brief Clears all active alerts of a container, e.g. when it is no longer monitored.
+ * @param name Container name.
+ * @param state Container's evaluation state.
+ * @param timestamp_ms Current time in milliseconds.
+ * @param events Receives the cleared alerts (appended).
+ */
+void AlertEngine::clearAll(const std::string& name, AlertState& state, int64_t timestamp_ms,
+                           std::vector<AlertEvent>& events) const {
+    for (size_t i = 0; i < state.rules.size() && i < rules_.size(); ++i) {
+        AlertRuleState& rule_state = state.rules[i];
+        if (rule_state.active) {
+            double value = (rules_[i].kind == AlertKind::Threshold) ? metricValue(state.prev, rules_[i].metric)
+                         : (rules_[i].kind == AlertKind::Forecast) ? FORECAST_NONE : ZERO_PERCENT;
+            events.push_back(makeEvent(i, name, timestamp_ms, value, false));
+        }
+        rule_state = AlertRuleState{};
+    }
+    state.has_prev = false;
+}
+
+/**
+ * @brief Builds an alert for a rule transition.
+ * @param index Rule index.
+ * @param name Container name.
+ * @param timestamp_ms Sample time in milliseconds.
+ * @param value Value that caused the transition.
+ * @param raised True if the alert fired, false if it cleared.
+ * @return The alert.
+ */
+AlertEvent AlertEngine::makeEvent(size_t index, const std::string& name, int64_t timestamp_ms, double value, bool raised) const {
+    const AlertRule& rule = rules_[index];
+    AlertEvent event;
+    std::memset(&event, 0, sizeof(event));
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    event.detected_ns = static_cast<int64_t>(now.tv_sec) * static_cast<int64_t>(NANOSECONDS_PER_SECOND) + now.tv_nsec;
+    event.timestamp = timestamp_ms;
+    event.value = value;
+    event.threshold = rule.raise_level;
+    event.rule = static_cast<uint16_t>(index);
+    event.metric = rule.metric;
+    event.severity = rule.severity;
+    event.kind = rule.kind;
+    event.raised = raised;
+    std::strncpy(event.container_name, name.c_str(), sizeof(event.container_name) - 1);
+    return event;
+}
+
+/**
+ * @brief Returns the value of a metric in a sample.
+ * @param metrics Sample.
+ * @param metric Metric.
+ * @return Value in percent.
+ */
+double AlertEngine::metricValue(const ContainerMetrics& metrics, AlertMetric metric) {
+    switch (metric) {
+        case AlertMetric::Cpu:    return metrics.cpu_usage_percent;
+        case AlertMetric::Memory: return metrics.memory_usage_percent;
+        case AlertMetric::Pids:   return metrics.pids_percent;
+    }
+    return ZERO_PERCENT;
+}
+
+/**
+ * @brief Returns the forecast time until a metric reaches its limit.
+ * @param forecast Forecast.
+ * @param metric Metric (memory or PIDs).
+ * @return Seconds, or FORECAST_NONE if not approaching.
+ */
+double AlertEngine::forecastValue(const ContainerForecast& forecast, AlertMetric metric) {
+    switch (metric) {
+        case AlertMetric::Memory: return forecast.memory_seconds_to_limit;
+        case AlertMetric::Pids:   return forecast.pids_seconds_to_limit;
+        default:                  return FORECAST_NONE;
+    }
+}
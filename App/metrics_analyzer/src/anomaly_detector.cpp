@@ -0,0 +1,52 @@
+/**
+ * @file anomaly_detector.cpp
+ * @brief Implements the AnomalyDetector class, which flags samples far from their EWMA mean.
+ */
+
+#include "anomaly_detector.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructs an empty detector.
+ * @param sigma Standard deviations from the mean at which a sample is anomalous.
+ */
+AnomalyDetector::AnomalyDetector(double sigma)
+    : threshold_(sigma * sigma) {}
+
+/**
+ * @brief Tests a sample and adds it to the means and variances.
+ *
+ * The test compares squared distances, so no square root is taken, and the flags are
+ * combined with shifts and a mask rather than branches.
+ *
+ * @param metrics Latest sample.
+ * @return Anomalous metrics (ANOMALY_FLAG_* bits).
+ */
+uint8_t AnomalyDetector::update(const ContainerMetrics& metrics) {
+    const double values[ANOMALY_METRICS] = {metrics.cpu_usage_percent, metrics.memory_usage_percent, metrics.pids_percent};
+    if (count_ == 0) {
+        // The first sample seeds the means
+        for (size_t i = 0; i < ANOMALY_METRICS; ++i) mean_[i] = values[i];
+    }
+    uint8_t flags = 0;
+    for (size_t i = 0; i < ANOMALY_METRICS; ++i) {
+        double diff = values[i] - mean_[i];
+        double variance = std::max(variance_[i], ANOMALY_MIN_STDDEV * ANOMALY_MIN_STDDEV);
+        flags |= static_cast<uint8_t>(diff * diff > threshold_ * variance) << i;
+        double increment = ANOMALY_EWMA_ALPHA * diff;
+        mean_[i] += increment;
+        variance_[i] = (1.0 - ANOMALY_EWMA_ALPHA) * (variance_[i] + diff * increment);
+    }
+    uint8_t warm = static_cast<uint8_t>(count_ >= ANOMALY_WARMUP_SAMPLES);
+    count_ += 1 - warm;
+    return flags & static_cast<uint8_t>(-warm);
+}
+
+/**
+ * @brief Forgets all samples.
+ */
+void AnomalyDetector::clear() {
+    mean_.fill(0.0);
+    variance_.fill(0.0);
+    count_ = 0;
+}
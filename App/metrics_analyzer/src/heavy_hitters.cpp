@@ -0,0 +1,135 @@
+/**
+ * @file heavy_hitters.cpp
+ * @brief Implements the HeavyHitters class, a Space-Saving summary of the top consumers of a resource.
+ */
+
+#include "heavy_hitters.hpp"
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @brief Constructs an empty summary.
+ * @param capacity Number of counters.
+ * @param half_life_ms Half-life of past weight in milliseconds.
+ */
+HeavyHitters::HeavyHitters(size_t capacity, double half_life_ms)
+    : capacity_(std::max<size_t>(capacity, 1)), half_life_ms_(half_life_ms) {
+    heap_.reserve(capacity_);
+    index_.reserve(capacity_);
+}
+
+/**
+ * @brief Adds weight for a container.
+ *
+ * Once the scale passes 2^HEAVY_HITTER_RESCALE_HALF_LIVES, all counters are scaled down
+ * and the landmark moves to the sample time.
+ *
+ * @param name Container name.
+ * @param weight Weight to add (ignored unless positive).
+ * @param timestamp_ms Sample time in milliseconds.
+ */
+void HeavyHitters::add(const std::string& name, double weight, int64_t timestamp_ms) {
+    if (!(weight > 0.0)) return;
+    if (landmark_ms_ < 0) landmark_ms_ = timestamp_ms;
+    double half_lives = (timestamp_ms - landmark_ms_) / half_life_ms_;
+    if (half_lives > HEAVY_HITTER_RESCALE_HALF_LIVES) {
+        double factor = std::exp2(-half_lives);
+        for (auto& counter : heap_) {
+            counter.weight *= factor;
+            counter.error *= factor;
+        }
+        landmark_ms_ = timestamp_ms;
+        half_lives = 0.0;
+    }
+    double scaled = weight * std::exp2(half_lives);
+
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        heap_[it->second].weight += scaled;
+        siftDown(it->second);
+    } else if (heap_.size() < capacity_) {
+        index_.emplace(name, heap_.size());
+        heap_.push_back({name, scaled, 0.0});
+        siftUp(heap_.size() - 1);
+    } else {
+        // Take over the lightest counter; its weight bounds the newcomer's error
+        Counter& lightest = heap_.front();
+        index_.erase(lightest.name);
+        lightest.name = name;
+        lightest.error = lightest.weight;
+        lightest.weight += scaled;
+        index_.emplace(name, 0);
+        siftDown(0);
+    }
+}
+
+/**
+ * @brief Returns the heaviest containers.
+ * @param k Maximum number of containers.
+ * @param now_ms Time to decay the weights to.
+ * @return Up to k containers by descending weight.
+ */
+std::vector<HeavyHitter> HeavyHitters::top(size_t k, int64_t now_ms) const {
+    std::vector<HeavyHitter> result;
+    if (heap_.empty()) return result;
+    double factor = std::exp2(-(now_ms - landmark_ms_) / half_life_ms_);
+    result.reserve(heap_.size());
+    for (const auto& counter : heap_) {
+        result.push_back({counter.name, counter.weight * factor, counter.error * factor});
+    }
+    size_t count = std::min(k, result.size());
+    std::partial_sort(result.begin(), result.begin() + count, result.end(),
+                      [](const HeavyHitter& a, const HeavyHitter& b) { return a.weight > b.weight; });
+    result.resize(count);
+    return result;
+}
+
+/**
+ * @brief Returns the number of tracked containers.
+ * @return Tracked containers (at most the capacity).
+ */
+size_t HeavyHitters::size() const {
+    return heap_.size();
+}
+
+/**
+ * @brief Moves the counter at a heap position up until its parent is lighter.
+ * @param position Heap position.
+ */
+void HeavyHitters::siftUp(size_t position) {
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (heap_[parent].weight <= heap_[position].weight) break;
+        swapCounters(parent, position);
+        position = parent;
+    }
+}
+
+/**
+ * @brief Moves the counter at a heap position down until its children are heavier.
+ * @param position Heap position.
+ */
+void HeavyHitters::siftDown(size_t position) {
+    for (;;) {
+        size_t lightest = position;
+        size_t left = 2 * position + 1;
+        size_t right = left + 1;
+        if (left < heap_.size() && heap_[left].weight < heap_[lightest].weight) lightest = left;
+        if (right < heap_.size() && heap_[right].weight < heap_[lightest].weight) lightest = right;
+        if (lightest == position) return;
+        swapCounters(position, lightest);
+        position = lightest;
+    }
+}
+
+/**
+ * @brief Swaps two heap positions and updates the index.
+ * @param a First position.
+ * @param b Second position.
+ */
+void HeavyHitters::swapCounters(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    index_[heap_[a].name] = a;
+    index_[heap_[b].name] = b;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file holt_forecaster.cpp
+ * @brief Implements the HoltForecaster class, which forecasts when a metric reaches a limit.
+ */
+
+#include "holt_forecaster.hpp"
+#include <cmath>
+
+/**
+ * @brief Constructs an empty forecaster.
+ * @param level_tau_ms Time constant of the level in milliseconds.
+ * @param trend_tau_ms Time constant of the trend in milliseconds.
+ */
+HoltForecaster::HoltForecaster(double level_tau_ms, double trend_tau_ms)
+    : level_tau_ms_(level_tau_ms), trend_tau_ms_(trend_tau_ms) {}
+
+/**
+ * @brief Adds a sample.
+ *
+ * Samples that are not newer than the previous one are ignored.
+ *
+ * @param timestamp_ms Sample time in milliseconds.
+ * @param value Metric value.
+ */
+void HoltForecaster::update(int64_t timestamp_ms, double value) {
+    if (last_ms_ < 0) {
+        level_ = value;
+        trend_ = 0.0;
+        first_ms_ = last_ms_ = timestamp_ms;
+        return;
+    }
+    double dt = static_cast<double>(timestamp_ms - last_ms_);
+    if (dt <= 0) return;
+    double alpha = 1.0 - std::exp(-dt / level_tau_ms_);
+    double beta = 1.0 - std::exp(-dt / trend_tau_ms_);
+    double level = alpha * value + (1.0 - alpha) * (level_ + trend_ * dt);
+    trend_ = beta * (level - level_) / dt + (1.0 - beta) * trend_;
+    level_ = level;
+    last_ms_ = timestamp_ms;
+}
+
+/**
+ * @brief Forgets all samples.
+ */
+void HoltForecaster::clear() {
+    level_ = 0.0;
+    trend_ = 0.0;
+    first_ms_ = last_ms_ = -1;
+}
+
+/**
+ * @brief Returns the smoothed level.
+ * @return Level (0 before the first sample).
+ */
+double HoltForecaster::level() const {
+    return level_;
+}
+
+/**
+ * @brief Returns the smoothed trend.
+ * @return Change per second.
+ */
+double HoltForecaster::trendPerSecond() const {
+    return trend_ * MILLISECONDS_PER_SECOND;
+}
+
+/**
+ * @brief Forecasts the time until the metric reaches a limit.
+ * @param limit Limit value.
+ * @return Seconds until the limit (0 if reached), or FORECAST_NONE if the trend is
+ *         not rising or fewer than FORECAST_WARMUP_MS were observed.
+ */
+double HoltForecaster::secondsUntil(double limit) const {
+    if (last_ms_ < 0 || last_ms_ - first_ms_ < FORECAST_WARMUP_MS || trend_ <= 0.0) return FORECAST_NONE;
+    if (level_ >= limit) return 0.0;
+    return (limit - level_) / trend_ / MILLISECONDS_PER_SECOND;
+}
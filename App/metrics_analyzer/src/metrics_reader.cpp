@@ -8,6 +8,11 @@
 #include <sys/sysinfo.h>
 #include <string>
 #include <cmath>
+#include <fcntl.h>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
 #include <unistd.h>
 #include "common.hpp"
 
@@ -20,6 +25,50 @@ MetricsReader::MetricsReader(const ContainerResourcePaths& paths, int num_cpus)
     : paths_(paths), num_cpus_(num_cpus)
 {}
 
+/**
+ * @brief Destructor. Closes the host /proc file descriptors.
+ */
+MetricsReader::~MetricsReader() {
+    if (proc_stat_fd_ >= 0) close(proc_stat_fd_);
+    if (proc_meminfo_fd_ >= 0) close(proc_meminfo_fd_);
+}
+
+/**
+ * @brief Reads a /proc file from offset 0 through a persistent descriptor.
+ * @param fd Descriptor, opened on first use (-1 if not yet open).
+ * @param path File path.
+ * @param buf Destination buffer; the content is NUL terminated.
+ * @param size Buffer size.
+ * @return Number of bytes read, or -1 on error.
+ */
+ssize_t MetricsReader::preadProcFile(int& fd, const char* path, char* buf, size_t size) {
+    if (fd < 0) {
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return -1;
+    }
+    ssize_t len = pread(fd, buf, size - 1, 0);
+    buf[len > 0 ? len : 0] = '\0';
+    return len;
+}
+
+/**
+ * @brief Computes a usage percentage from two tick samples.
+ * @param total Current total ticks.
+ * @param idle Current idle ticks.
+ * @param last Previous total and idle ticks, updated in place.
+ * @return Usage percent (0 for the first sample).
+ */
+double MetricsReader::tickUsage(uint64_t total, uint64_t idle, std::pair<uint64_t, uint64_t>& last) const {
+    double usage = ZERO_PERCENT;
+    if (last.first != 0 && total > last.first) {
+        uint64_t delta_total = total - last.first;
+        uint64_t delta_idle = idle - last.second;
+        usage = round2((double)(delta_total - delta_idle) / delta_total * PERCENT_FACTOR);
+    }
+    last = {total, idle};
+    return usage;
+}
+
 /**
  * @brief Reads an unsigned integer value from a file.
  * @param path File path.
@@ -34,6 +83,135 @@ uint64_t MetricsReader::readUintFromFile(const std::string& path) {
     return value;
 }
 
+/**
+ * @brief Reads an unsigned integer value from a file, reporting failure.
+ * @param path File path.
+ * @param value Reference to receive the value.
+ * @return True if the file could be opened and parsed, false otherwise.
+ */
+bool MetricsReader::tryReadUintFromFile(const std::string& path, uint64_t& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+/**
+ * @brief Reads the cumulative CPU time of a container in nanoseconds.
+ *
+ * Accepts both cgroup v1 cpuacct.usage (a single value in ns) and cgroup v2
+ * cpu.stat (key/value lines, usage_usec in us).
+ *
+ * @param path CPU usage file path.
+ * @param cpu_usage_ns Reference to receive the CPU time in nanoseconds.
+ * @return True if the file could be opened and parsed, false otherwise.
+ */
+bool MetricsReader::tryReadCpuUsageNs(const std::string& path, uint64_t& cpu_usage_ns) {
+    std::ifstream file(path);
+    std::string key;
+    uint64_t value = 0;
+    if (!(file >> key)) return false;
+    if (std::isdigit(static_cast<unsigned char>(key[0]))) {
+        cpu_usage_ns = std::strtoull(key.c_str(), nullptr, 10);
+        return true;
+    }
+    while (file >> value) {
+        if (key == CGROUP_V2_CPU_USAGE_KEY) {
+            cpu_usage_ns = value * NANOSECONDS_PER_MICROSECOND;
+            return true;
+        }
+        if (!(file >> key)) break;
+    }
+    return false;
+}
+
+/**
+ * @brief Reads a complete usage sample of the container.
+ * @param info ContainerInfo struct.
+ * @param cpu_usage_ns Reference to receive the cumulative CPU time in nanoseconds.
+ * @param memory_percent Reference to receive the memory usage percent.
+ * @param memory_bytes Reference to receive the memory usage in bytes (also without a limit).
+ * @param pids_percent Reference to receive the pids usage percent.
+ * @return True if all resource files were read, false otherwise.
+ */
+bool MetricsReader::readUsage(const ContainerInfo& info, uint64_t& cpu_usage_ns, double& memory_percent, uint64_t& memory_bytes,
+                              double& pids_percent) {
+    uint64_t pids = 0;
+    if (!tryReadUintFromFile(paths_.memory_path, memory_bytes) ||
+        !tryReadUintFromFile(paths_.pids_path, pids) ||
+        !tryReadCpuUsageNs(paths_.cpu_path, cpu_usage_ns)) {
+        return false;
+    }
+    int mem_mb = static_cast<int>(memory_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE));
+    memory_percent = round2((info.memory_limit > 0) ? ((double)mem_mb / info.memory_limit * PERCENT_FACTOR) : ZERO_PERCENT);
+    pids_percent = round2((info.pid_limit > 0) ? ((double)pids / info.pid_limit * PERCENT_FACTOR) : ZERO_PERCENT);
+    return true;
+}
+
+/**
+ * @brief Reads a memory high-water mark through a persistent descriptor.
+ * @param fd Descriptor, opened on first use (-1 if not yet open).
+ * @param path High-water mark file path (memory.max_usage_in_bytes or memory.peak).
+ * @param peak_bytes Reference to receive the high-water mark in bytes.
+ * @return True if the mark could be read, false otherwise.
+ */
+bool MetricsReader::readMemoryPeak(int& fd, const std::string& path, uint64_t& peak_bytes) {
+    if (fd < 0) {
+        if (path.empty()) return false;
+        fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+    }
+    char buf[32];
+    ssize_t len = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (len <= 0) return false;
+    buf[len] = '\0';
+    char* end = nullptr;
+    peak_bytes = std::strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+/**
+ * @brief Resets a memory high-water mark to the current usage.
+ * @param fd Descriptor opened by readMemoryPeak.
+ * @return True if the kernel accepted the reset, false otherwise.
+ */
+bool MetricsReader::resetMemoryPeak(int fd) {
+    return fd >= 0 && pwrite(fd, CGROUP_PEAK_RESET_VALUE, std::strlen(CGROUP_PEAK_RESET_VALUE), 0) > 0;
+}
+
+/**
+ * @brief Reads container resource limits directly from cgroup limit files.
+ * @param paths Limit file paths for the container.
+ * @param info ContainerInfo whose cpu_limit, memory_limit and pid_limit are filled in.
+ * @return True if the memory limit file could be read, false otherwise.
+ */
+bool MetricsReader::readContainerLimits(const ContainerLimitPaths& paths, ContainerInfo& info) {
+    // CFS quota is -1 (v1) or "max" (v2) when unlimited, either fails the check or the parse;
+    // on v2 quota and period share cpu.max
+    int64_t quota = -1, period = 0;
+    std::ifstream quota_file(paths.cpu_quota_path);
+    quota_file >> quota;
+    if (paths.cpu_period_path == paths.cpu_quota_path) {
+        quota_file >> period;
+    } else {
+        std::ifstream(paths.cpu_period_path) >> period;
+    }
+    info.cpu_limit = (quota > 0 && period > 0) ? static_cast<double>(quota) / period : 0.0;
+
+    std::ifstream mem_file(paths.memory_limit_path);
+    std::string mem_value;
+    if (!(mem_file >> mem_value)) return false;
+    uint64_t mem_bytes = (mem_value == CGROUP_V2_UNLIMITED) ? CGROUP_UNLIMITED_BYTES
+        : std::strtoull(mem_value.c_str(), nullptr, 10);
+    info.memory_limit = (mem_bytes >= CGROUP_UNLIMITED_BYTES) ? 0
+        : static_cast<int>(mem_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE));
+
+    // pids.max holds "max" when unlimited, which fails to parse and leaves 0
+    int pids_max = 0;
+    std::ifstream(paths.pids_max_path) >> pids_max;
+    info.pid_limit = pids_max;
+    return true;
+}
+
 /**
  * @brief Gets the container's memory usage in megabytes.
  * @return Memory usage in MB.
@@ -97,49 +275,88 @@ HostInfo MetricsReader::getHostInfo() {
 
 /**
  * @brief Gets host CPU usage percentage.
+ *
+ * Parses the aggregate "cpu" line and the per-core "cpuN" lines in a single pass
+ * over the raw buffer, stopping at the first line that is not a cpu line.
+ *
  * @return CPU usage percent.
  */
 double MetricsReader::getHostCpuUsagePercentage() {
-    std::ifstream file(PROC_STAT_PATH);
-    std::string line;
-    std::getline(file, line);
-    uint64_t user, nice, system, idle, iowait, irq, softirq, steal;
-    sscanf(line.c_str(), CPU_STAT_FORMAT,
-           &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal);
-    uint64_t total = user + nice + system + idle + iowait + irq + softirq + steal;
-    uint64_t total_idle = idle + iowait;
+    char buf[PROC_STAT_BUF_SIZE];
+    if (preadProcFile(proc_stat_fd_, PROC_STAT_PATH, buf, sizeof(buf)) <= 0) return ZERO_PERCENT;
 
+    const size_t prefix_len = std::strlen(CPU_STAT_PREFIX);
     double usage = ZERO_PERCENT;
-    if (last_total != 0 && last_idle != 0) {
-        uint64_t delta_total = total - last_total;
-        uint64_t delta_idle = total_idle - last_idle;
-        usage = (double)(delta_total - delta_idle) / delta_total * PERCENT_FACTOR;
-        usage = std::round(usage * PERCENT_FACTOR) / PERCENT_FACTOR;
+    size_t core_count = 0;
+    char* p = buf;
+    while (std::strncmp(p, CPU_STAT_PREFIX, prefix_len) == 0) {
+        p += prefix_len;
+        bool aggregate = (*p == ' ');
+        size_t core = aggregate ? 0 : std::strtoul(p, &p, 10);
+
+        // user, nice, system, idle, iowait, irq, softirq, steal
+        uint64_t fields[CPU_STAT_FIELDS] = {};
+        for (int i = 0; i < CPU_STAT_FIELDS; ++i) fields[i] = std::strtoull(p, &p, 10);
+        uint64_t total = 0;
+        for (uint64_t field : fields) total += field;
+        uint64_t total_idle = fields[3] + fields[4];
+
+        if (aggregate) {
+            usage = tickUsage(total, total_idle, last_ticks_);
+        } else {
+            if (core >= last_core_ticks_.size()) {
+                last_core_ticks_.resize(core + 1, {0, 0});
+                core_usage_.resize(core + 1, ZERO_PERCENT);
+            }
+            core_usage_[core] = tickUsage(total, total_idle, last_core_ticks_[core]);
+            core_count = std::max(core_count, core + 1);
+        }
+
+        p = std::strchr(p, '\n');
+        if (!p) break;
+        ++p;
     }
-    last_total = total;
-    last_idle = total_idle;
+    core_usage_.resize(core_count);
     return usage;
 }
 
+/**
+ * @brief Gets per-core CPU usage computed by the last getHostCpuUsagePercentage() call.
+ * @return CPU usage percent per core, indexed by core number.
+ */
+const std::vector<double>& MetricsReader::getHostCoreUsagePercentages() const {
+    return core_usage_;
+}
+
 /**
  * @brief Gets host memory usage percentage.
+ *
+ * Parses the raw buffer in a single pass and stops once all needed keys are found.
+ *
  * @return Memory usage percent.
  */
 double MetricsReader::getHostMemoryUsagePercent() {
-    std::ifstream file(PROC_MEMINFO_PATH);
-    std::string line;
-    uint64_t mem_total = 0, mem_free = 0, buffers = 0, cached = 0;
-    while (std::getline(file, line)) {
-        if (line.find(MEMINFO_TOTAL) == 0)
-            sscanf(line.c_str(), (std::string(MEMINFO_TOTAL) + " " + MEMINFO_FORMAT).c_str(), &mem_total);
-        else if (line.find(MEMINFO_FREE) == 0)
-            sscanf(line.c_str(), (std::string(MEMINFO_FREE) + " " + MEMINFO_FORMAT).c_str(), &mem_free);
-        else if (line.find(MEMINFO_BUFFERS) == 0)
-            sscanf(line.c_str(), (std::string(MEMINFO_BUFFERS) + " " + MEMINFO_FORMAT).c_str(), &buffers);
-        else if (line.find(MEMINFO_CACHED) == 0)
-            sscanf(line.c_str(), (std::string(MEMINFO_CACHED) + " " + MEMINFO_FORMAT).c_str(), &cached);
+    char buf[PROC_MEMINFO_BUF_SIZE];
+    if (preadProcFile(proc_meminfo_fd_, PROC_MEMINFO_PATH, buf, sizeof(buf)) <= 0) return ZERO_PERCENT;
+
+    const char* keys[] = {MEMINFO_TOTAL, MEMINFO_FREE, MEMINFO_BUFFERS, MEMINFO_CACHED};
+    uint64_t values[] = {0, 0, 0, 0};
+    int remaining = 4;
+    for (char* p = buf; p && *p && remaining > 0; ) {
+        for (int i = 0; i < 4; ++i) {
+            size_t key_len = std::strlen(keys[i]);
+            if (std::strncmp(p, keys[i], key_len) == 0) {
+                values[i] = std::strtoull(p + key_len, &p, 10);
+                --remaining;
+                break;
+            }
+        }
+        p = std::strchr(p, '\n');
+        if (p) ++p;
     }
+
+    uint64_t mem_total = values[0], mem_free = values[1], buffers = values[2], cached = values[3];
     uint64_t used = mem_total - mem_free - buffers - cached;
     double percent = (mem_total > 0) ? ((double)used / mem_total * PERCENT_FACTOR) : ZERO_PERCENT;
-    return std::round(percent * PERCENT_FACTOR) / PERCENT_FACTOR;
-}
\ No newline at end of file
+    return round2(percent);
+}
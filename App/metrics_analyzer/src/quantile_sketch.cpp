@@ -0,0 +1,148 @@
+/**
+ * @file quantile_sketch.cpp
+ * @brief Implements the QuantileSketch class, a mergeable log-bucket histogram for streaming percentiles.
+ */
+
+#include "quantile_sketch.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const double SKETCH_GAMMA = (1.0 + QUANTILE_SKETCH_RELATIVE_ACCURACY) / (1.0 - QUANTILE_SKETCH_RELATIVE_ACCURACY); ///< Bucket growth factor.
+const double SKETCH_LOG_GAMMA = std::log(SKETCH_GAMMA);                                                        ///< ln(gamma).
+const double SKETCH_MIN_INDEX = std::ceil(std::log(QUANTILE_SKETCH_MIN_VALUE) / SKETCH_LOG_GAMMA);             ///< Log index of bucket 0.
+
+}
+
+/**
+ * @brief Constructs an empty sketch.
+ */
+QuantileSketch::QuantileSketch() {
+    clear();
+}
+
+/**
+ * @brief Adds a value.
+ * @param value Value to add (negative values count as zero).
+ * @param weight Weight of the value (0 counts as 1).
+ */
+void QuantileSketch::add(double value, uint64_t weight) {
+    if (value < 0.0 || std::isnan(value)) value = 0.0;
+    if (weight == 0) weight = 1;
+    if (value < QUANTILE_SKETCH_MIN_VALUE) {
+        zero_weight_ += weight;
+    } else {
+        buckets_[bucketIndex(value)] += weight;
+    }
+    if (count_ == 0 || value < min_) min_ = value;
+    if (count_ == 0 || value > max_) max_ = value;
+    ++count_;
+    weight_ += weight;
+}
+
+/**
+ * @brief Adds all values of another sketch.
+ * @param other Sketch to merge into this one.
+ */
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.count_ == 0) return;
+    for (size_t i = 0; i < buckets_.size(); ++i) buckets_[i] += other.buckets_[i];
+    zero_weight_ += other.zero_weight_;
+    min_ = (count_ == 0) ? other.min_ : std::min(min_, other.min_);
+    max_ = (count_ == 0) ? other.max_ : std::max(max_, other.max_);
+    count_ += other.count_;
+    weight_ += other.weight_;
+}
+
+/**
+ * @brief Removes all values.
+ */
+void QuantileSketch::clear() {
+    buckets_.fill(0);
+    zero_weight_ = 0;
+    count_ = 0;
+    weight_ = 0;
+    min_ = 0.0;
+    max_ = 0.0;
+}
+
+/**
+ * @brief Returns the number of values added.
+ * @return Number of values.
+ */
+uint64_t QuantileSketch::count() const {
+    return count_;
+}
+
+/**
+ * @brief Returns a percentile.
+ * @param rank Percentile as a fraction in [0, 1].
+ * @return Percentile value (0 if empty).
+ */
+double QuantileSketch::quantile(double rank) const {
+    double value = 0.0;
+    quantiles(&rank, &value, 1);
+    return value;
+}
+
+/**
+ * @brief Returns several percentiles in a single pass over the buckets.
+ *
+ * The percentile at rank q is the value at weight position floor(q x (total weight - 1))
+ * in sorted order, as reported by its bucket; with unit weights that is the 0-based
+ * position among the values.
+ *
+ * @param ranks Percentiles as fractions in [0, 1], in ascending order.
+ * @param values Receives one value per rank.
+ * @param count Number of ranks.
+ */
+void QuantileSketch::quantiles(const double* ranks, double* values, size_t count) const {
+    if (count_ == 0) {
+        std::fill(values, values + count, 0.0);
+        return;
+    }
+    size_t next = 0;
+    uint64_t seen = zero_weight_;
+    auto resolve = [&](double value) {
+        // Report every rank whose position falls within the values seen so far
+        while (next < count) {
+            double clamped = std::min(std::max(ranks[next], 0.0), 1.0);
+            uint64_t position = static_cast<uint64_t>(clamped * static_cast<double>(weight_ - 1));
+            if (position >= seen) return;
+            values[next++] = std::min(std::max(value, min_), max_);
+        }
+    };
+    resolve(0.0);
+    for (size_t i = 0; i < buckets_.size() && next < count; ++i) {
+        if (buckets_[i] == 0) continue;
+        seen += buckets_[i];
+        resolve(bucketValue(i));
+    }
+    while (next < count) values[next++] = max_;
+}
+
+/**
+ * @brief Returns the bucket of a value.
+ * @param value Value of at least QUANTILE_SKETCH_MIN_VALUE.
+ * @return Bucket index.
+ */
+size_t QuantileSketch::bucketIndex(double value) {
+    double index = std::ceil(std::log(value) / SKETCH_LOG_GAMMA) - SKETCH_MIN_INDEX;
+    if (index < 0.0) return 0;
+    return std::min(static_cast<size_t>(index), QUANTILE_SKETCH_BUCKETS - 1);
+}
+
+/**
+ * @brief Returns the value a bucket reports.
+ *
+ * Bucket i holds (gamma^(i-1), gamma^i]; its midpoint 2 gamma^i / (gamma + 1) is within
+ * the relative accuracy of both bounds.
+ *
+ * @param index Bucket index.
+ * @return Value within the relative accuracy of all values in the bucket.
+ */
+double QuantileSketch::bucketValue(size_t index) {
+    double exponent = static_cast<double>(index) + SKETCH_MIN_INDEX;
+    return 2.0 * std::exp(exponent * SKETCH_LOG_GAMMA) / (SKETCH_GAMMA + 1.0);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file sliding_window_extrema.cpp
+ * @brief Implements the SlidingWindowExtrema class for the max and min of a metric over a time window.
+ */
+
+#include "sliding_window_extrema.hpp"
+
+/**
+ * @brief Constructs an empty window.
+ * @param window_ms Window length in milliseconds (0 keeps only the latest sample).
+ */
+SlidingWindowExtrema::SlidingWindowExtrema(int64_t window_ms)
+    : window_ms_(window_ms) {}
+
+/**
+ * @brief Adds a sample and drops samples that fell out of the window.
+ *
+ * A sample that is not greater (or not smaller) than the new one can never become the
+ * maximum (or minimum) again, since it also leaves the window first.
+ *
+ * @param timestamp_ms Sample time in milliseconds (non-decreasing).
+ * @param value Sample value.
+ */
+void SlidingWindowExtrema::push(int64_t timestamp_ms, double value) {
+    while (!max_deque_.empty() && max_deque_.back().value <= value) max_deque_.pop_back();
+    max_deque_.push_back({timestamp_ms, value});
+    while (!min_deque_.empty() && min_deque_.back().value >= value) min_deque_.pop_back();
+    min_deque_.push_back({timestamp_ms, value});
+
+    // The new sample is never expired, so neither deque becomes empty
+    int64_t oldest_ms = timestamp_ms - window_ms_;
+    while (max_deque_.front().timestamp_ms <= oldest_ms && max_deque_.size() > 1) max_deque_.pop_front();
+    while (min_deque_.front().timestamp_ms <= oldest_ms && min_deque_.size() > 1) min_deque_.pop_front();
+}
+
+/**
+ * @brief Removes all samples.
+ */
+void SlidingWindowExtrema::clear() {
+    max_deque_.clear();
+    min_deque_.clear();
+}
+
+/**
+ * @brief Checks whether the window holds no samples.
+ * @return True if empty.
+ */
+bool SlidingWindowExtrema::empty() const {
+    return max_deque_.empty();
+}
+
+/**
+ * @brief Returns the maximum over the window.
+ * @return Maximum value (0 if empty).
+ */
+double SlidingWindowExtrema::max() const {
+    return max_deque_.empty() ? 0.0 : max_deque_.front().value;
+}
+
+/**
+ * @brief Returns the minimum over the window.
+ * @return Minimum value (0 if empty).
+ */
+double SlidingWindowExtrema::min() const {
+    return min_deque_.empty() ? 0.0 : min_deque_.front().value;
+}
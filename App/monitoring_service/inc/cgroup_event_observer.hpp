@@ -0,0 +1,165 @@
+/**
+ * @file cgroup_event_observer.hpp
+ * @brief Declares the CgroupEventObserver base class for kernel notifications on container cgroups.
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "common.hpp"
+#include "container_observer.hpp"
+
+/**
+ * @class CgroupEventObserver
+ * @brief Epoll event loop that arms per-container kernel notifications as containers come and go.
+ *
+ * Observer callbacks only queue the change and wake the loop thread, which applies it.
+ * Containers whose cgroup does not exist yet (created but not started) are retried with
+ * a backoff from CGROUP_PROBE_INITIAL_MS up to CGROUP_PROBE_MAX_MS, like the samplers do.
+ * Derived classes register and release their descriptors and handle the events; all
+ * of this runs on the loop thread. Derived destructors must call stop().
+ */
+class CgroupEventObserver : public IContainerObserver {
+public:
+    /**
+     * @brief Destructor. Joins the loop thread if stop() was not called.
+     */
+    ~CgroupEventObserver() override;
+
+    /**
+     * @brief Stops the event loop thread and releases all containers' notifications.
+     */
+    void stop();
+
+    /**
+     * @brief Queues a container for arming.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     */
+    void onContainerAdded(const std::string& name, const ContainerInfo& info) override;
+
+    /**
+     * @brief Queues a container's notifications for release.
+     * @param name Container name.
+     */
+    void onContainerRemoved(const std::string& name) override;
+
+protected:
+    /**
+     * @brief Constructs the observer without starting the loop.
+     * @param log_tag Prefix of log lines (e.g. "[Pressure]").
+     * @param shutdown_flag Reference to the application's shutdown flag.
+     */
+    CgroupEventObserver(const char* log_tag, std::atomic<bool>& shutdown_flag);
+
+    /**
+     * @brief Creates the epoll instance and starts the event loop thread.
+     * @return True if the loop is running.
+     */
+    bool startLoop();
+
+    /**
+     * @brief Adds a descriptor to the event loop.
+     * @param fd Descriptor.
+     * @param events epoll event mask.
+     * @return True on success.
+     */
+    bool addDescriptor(int fd, uint32_t events);
+
+    /**
+     * @brief Removes a descriptor from the event loop (before it is closed).
+     * @param fd Descriptor.
+     */
+    void removeDescriptor(int fd);
+
+    /**
+     * @brief Releases a container's notifications and arms it again once its cgroup reappears.
+     * @param name Container name.
+     */
+    void rearmLater(const std::string& name);
+
+    /**
+     * @brief Registers a container's notifications.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     * @return True if at least one notification was registered.
+     */
+    virtual bool arm(const std::string& name, const ContainerInfo& info) = 0;
+
+    /**
+     * @brief Releases all notifications of an armed container.
+     * @param name Container name.
+     */
+    virtual void disarm(const std::string& name) = 0;
+
+    /**
+     * @brief Handles a ready descriptor registered by the derived class.
+     * @param fd Descriptor.
+     * @param events epoll event mask.
+     */
+    virtual void handleEvent(int fd, uint32_t events) = 0;
+
+private:
+    /**
+     * @struct WatchedContainer
+     * @brief Arming state of a container, owned by the event loop thread.
+     */
+    struct WatchedContainer {
+        ContainerInfo info;             ///< Container ID and resource limits.
+        bool armed = false;             ///< Whether notifications are registered.
+        int64_t next_attempt_ms = 0;    ///< Earliest time to try arming again.
+        int backoff_ms = 0;             ///< Current retry delay.
+    };
+
+    /**
+     * @struct Request
+     * @brief A queued add or remove from an observer callback.
+     */
+    struct Request {
+        std::string name;               ///< Container name.
+        ContainerInfo info;             ///< Container info (unused for removals).
+        bool remove = false;            ///< True for a removal.
+    };
+
+    /**
+     * @brief Queues a request and wakes the event loop.
+     * @param request Request to queue.
+     */
+    void queue(Request request);
+
+    /**
+     * @brief Event loop thread function.
+     */
+    void eventLoop();
+
+    /**
+     * @brief Applies queued add and remove requests.
+     */
+    void applyRequests();
+
+    /**
+     * @brief Arms containers whose retry delay has elapsed.
+     * @param now_ms Current time in milliseconds.
+     * @return Milliseconds until the next arming attempt, or -1 if none is pending.
+     */
+    int armPending(int64_t now_ms);
+
+    /**
+     * @brief Wakes the event loop thread.
+     */
+    void wake();
+
+    const char* log_tag_;                                        ///< Prefix of log lines.
+    std::atomic<bool>& shutdown_flag_;                           ///< Reference to shutdown flag.
+    std::thread worker_;                                         ///< Event loop thread.
+    std::atomic<bool> running_{false};                           ///< Indicates if the loop is running.
+    int epoll_fd_ = -1;                                          ///< epoll instance.
+    int wake_fd_ = -1;                                           ///< eventfd waking the loop for requests.
+    std::mutex request_mutex_;                                   ///< Mutex for queued requests.
+    std::vector<Request> requests_;                              ///< Requests not yet applied.
+    std::unordered_map<std::string, WatchedContainer> containers_; ///< Watched containers by name.
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * @file cgroup_watcher.hpp
+ * @brief Declares the CgroupWatcher class for runtime-free container discovery.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "common.hpp"
+#include "database_interface.hpp"
+#include "container_runtime_factory_interface.hpp"
+
+/**
+ * @class CgroupWatcher
+ * @brief Discovers containers by watching the runtime's cgroup parent directories with inotify.
+ *
+ * A container is considered started once its directory exists in every controller
+ * hierarchy and stopped as soon as one of them is removed. Limits are read straight
+ * from the cgroup limit files, so no runtime CLI process is ever spawned. Containers
+ * are registered under their short ID, since the runtime name is not known.
+ */
+class CgroupWatcher {
+public:
+    /**
+     * @brief Constructs a CgroupWatcher.
+     * @param cfg Monitor configuration (uses runtime, cgroup and cgroup_root).
+     * @param db Reference to the database interface.
+     * @param shutdown_flag Reference to the application's shutdown flag.
+     */
+    CgroupWatcher(const MonitorConfig& cfg, IDatabaseInterface& db, std::atomic<bool>& shutdown_flag);
+
+    /**
+     * @brief Destructor. Ensures the watcher thread is stopped.
+     */
+    ~CgroupWatcher();
+
+    /**
+     * @brief Starts the watcher thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the watcher thread.
+     */
+    void stop();
+
+private:
+    /**
+     * @struct CgroupState
+     * @brief Tracks in which controller hierarchies a container's cgroup exists.
+     */
+    struct CgroupState {
+        unsigned present_mask = 0;  ///< Bit per controller hierarchy holding the container's directory.
+        bool registered = false;    ///< Whether the container has been saved to the database.
+        int64_t due_ms = 0;         ///< Time at which limits should be read (0 if not pending).
+    };
+
+    /**
+     * @brief Worker thread function. Multiplexes inotify events and pending registrations.
+     */
+    void watchLoop();
+
+    /**
+     * @brief Adds inotify watches for parent directories that exist but are not yet watched.
+     *
+     * Existing sub-directories are scanned after the watch is added, so containers
+     * created in between are seen either by the scan or by an event.
+     *
+     * @param now_ms Current time in milliseconds.
+     */
+    void addMissingWatches(int64_t now_ms);
+
+    /**
+     * @brief Reads and dispatches all pending inotify events.
+     * @param now_ms Current time in milliseconds.
+     */
+    void handleEvents(int64_t now_ms);
+
+    /**
+     * @brief Records that a container's directory exists in a controller hierarchy.
+     * @param id Container ID.
+     * @param controller Index of the controller hierarchy.
+     * @param now_ms Current time in milliseconds.
+     */
+    void markPresent(const std::string& id, size_t controller, int64_t now_ms);
+
+    /**
+     * @brief Records that a container's directory was removed from a controller hierarchy.
+     * @param id Container ID.
+     * @param controller Index of the controller hierarchy.
+     */
+    void markAbsent(const std::string& id, size_t controller);
+
+    /**
+     * @brief Reads limits and registers containers whose settle delay has elapsed.
+     * @param now_ms Current time in milliseconds.
+     * @return Milliseconds until the next pending registration, or -1 if none.
+     */
+    int registerDueContainers(int64_t now_ms);
+
+    const MonitorConfig& cfg_;                                   ///< Monitor configuration.
+    IDatabaseInterface& db_;                                     ///< Reference to database interface.
+    std::atomic<bool>& shutdown_flag_;                           ///< Reference to shutdown flag.
+    std::thread worker_;                                         ///< Watcher thread.
+    std::atomic<bool> running_{false};                           ///< Indicates if the watcher is running.
+    std::unique_ptr<IContainerRuntimePathFactory> pathFactory_;  ///< Path factory for cgroup directories.
+    std::vector<std::string> parent_dirs_;                       ///< Watched parent directories, one per controller.
+    std::vector<int> watch_descriptors_;                         ///< inotify watch per parent directory (-1 if none).
+    int inotify_fd_ = -1;                                        ///< inotify instance.
+    std::unordered_map<std::string, CgroupState> cgroups_;       ///< Known container cgroups by ID.
+};
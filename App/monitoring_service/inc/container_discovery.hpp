@@ -0,0 +1,86 @@
+/**
+ * @file container_discovery.hpp
+ * @brief Declares the ContainerDiscovery class for finding containers that are already running.
+ */
+
+#pragma once
+#include <set>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common.hpp"
+#include "json_processing.hpp"
+#include "database_interface.hpp"
+#include "resource_thread_pool.hpp"
+#include "container_metadata_cache.hpp"
+#include "container_runtime_factory_interface.hpp"
+
+/**
+ * @class ContainerDiscovery
+ * @brief Seeds the container registry with containers running before the monitor started.
+ *
+ * Scans the runtime's cgroup parent directories in parallel (one task per controller
+ * hierarchy), inspects the found containers with bulk runtime queries, and registers
+ * them in the database and the resource thread pool. Run it before the event stream is
+ * processed; the event listener replays events from the scan start time so that
+ * nothing is missed and already-seeded containers are not added twice.
+ *
+ * With a metadata cache, containers whose cached entry is still valid are seeded
+ * straight from the cache and only the remaining ones are inspected.
+ */
+class ContainerDiscovery {
+public:
+    /**
+     * @brief Constructs a ContainerDiscovery.
+     * @param cfg Monitor configuration.
+     * @param db Reference to the database interface.
+     * @param thread_pool Reference to the resource thread pool.
+     * @param metadata_cache Optional metadata cache consulted before inspecting (may be nullptr).
+     */
+    ContainerDiscovery(const MonitorConfig& cfg, IDatabaseInterface& db, ResourceThreadPool& thread_pool,
+                       ContainerMetadataCache* metadata_cache = nullptr);
+
+    /**
+     * @brief Discovers running containers and seeds the registry and thread pool.
+     * @return Number of containers seeded.
+     */
+    size_t discover();
+
+    /**
+     * @brief Lists the container IDs present in all cgroup parent directories.
+     *
+     * Each parent directory is scanned on its own thread.
+     *
+     * @param parent_dirs Cgroup parent directories, one per controller hierarchy.
+     * @return Container IDs found in every hierarchy.
+     */
+    static std::set<std::string> scanCgroupTree(const std::vector<std::string>& parent_dirs);
+
+    /**
+     * @brief Lists container ID sub-directories of a single cgroup parent directory.
+     * @param parent_dir Cgroup parent directory.
+     * @return Container IDs found.
+     */
+    static std::set<std::string> scanParentDir(const std::string& parent_dir);
+
+    /**
+     * @brief Checks whether a cgroup directory name is a full container ID.
+     * @param name Directory name.
+     * @return True if the name is a 64 character hex string.
+     */
+    static bool isContainerId(const std::string& name);
+
+private:
+    /**
+     * @brief Inspects containers with parallel bulk runtime queries.
+     * @param ids Container IDs to inspect.
+     * @return Inspected containers.
+     */
+    std::vector<ContainerEventInfo> inspectAll(const std::set<std::string>& ids) const;
+
+    const MonitorConfig& cfg_;                                   ///< Monitor configuration.
+    IDatabaseInterface& db_;                                     ///< Reference to database interface.
+    ResourceThreadPool& thread_pool_;                            ///< Reference to resource thread pool.
+    ContainerMetadataCache* metadata_cache_;                     ///< Optional metadata cache (may be nullptr).
+    std::unique_ptr<IContainerRuntimePathFactory> pathFactory_;  ///< Path factory for cgroup directories.
+};
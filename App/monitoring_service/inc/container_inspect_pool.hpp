@@ -0,0 +1,83 @@
+/**
+ * @file container_inspect_pool.hpp
+ * @brief Declares the ContainerInspectPool class for concurrent container inspection.
+ */
+
+#pragma once
+#include <queue>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include "json_processing.hpp"
+
+/**
+ * @class ContainerInspectPool
+ * @brief Small worker pool that enriches container "create" events via runtime inspect.
+ *
+ * Each submitted event is inspected on one of the worker threads, so a burst of
+ * container creations is inspected concurrently instead of one after another.
+ * The caller keeps the returned futures in event order to apply results in order.
+ */
+class ContainerInspectPool {
+public:
+    /**
+     * @brief Constructs a ContainerInspectPool.
+     * @param thread_count Number of inspect worker threads.
+     */
+    explicit ContainerInspectPool(int thread_count);
+
+    /**
+     * @brief Destructor. Ensures all worker threads are stopped.
+     */
+    ~ContainerInspectPool();
+
+    /**
+     * @brief Starts the inspect worker threads.
+     */
+    void start();
+
+    /**
+     * @brief Stops the inspect worker threads. Pending jobs are abandoned.
+     */
+    void stop();
+
+    /**
+     * @brief Submits a container event for enrichment.
+     *
+     * If the pool is not running, the inspection is done inline on the caller's thread.
+     *
+     * @param info Parsed container event (typically a "create" event).
+     * @return Future resolving to the enriched event.
+     */
+    std::future<ContainerEventInfo> submit(ContainerEventInfo info);
+
+private:
+    /**
+     * @struct InspectJob
+     * @brief Pending inspection with the promise used to publish its result.
+     */
+    struct InspectJob {
+        ContainerEventInfo info;                  ///< Event to enrich.
+        std::promise<ContainerEventInfo> result;  ///< Promise fulfilled with the enriched event.
+    };
+
+    /**
+     * @brief Worker thread function. Pops jobs and runs the runtime inspect.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Runs the runtime inspect for an event if constraints are missing.
+     * @param info Event to enrich in place.
+     */
+    static void inspect(ContainerEventInfo& info);
+
+    int thread_count_;                        ///< Number of worker threads.
+    bool running_ = false;                    ///< Indicates if the pool is running.
+    std::mutex mutex_;                        ///< Mutex for the job queue.
+    std::condition_variable cv_;              ///< Condition variable for job arrival.
+    std::queue<InspectJob> jobs_;             ///< Pending inspection jobs.
+    std::vector<std::thread> threads_;        ///< Worker threads.
+};
@@ -43,6 +43,16 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Replays runtime events starting at the given wall-clock time.
+     *
+     * Must be called before start(). Used to pick up events that happened while
+     * the startup discovery scan was running, so the scan and the stream overlap.
+     *
+     * @param since_ms Unix timestamp in milliseconds.
+     */
+    void setSince(int64_t since_ms);
+
 private:
     /**
      * @brief Worker thread function. Executes the event command and pushes events to the queue.
@@ -54,4 +64,5 @@ private:
     std::atomic<bool>& shutdown_flag_;    ///< Reference to shutdown flag.
     std::thread event_thread_;            ///< Event listener thread.
     std::atomic<bool> running_;           ///< Indicates if the listener is running.
+    std::string since_ = "0m";            ///< Value passed to the runtime's --since option.
 };
\ No newline at end of file
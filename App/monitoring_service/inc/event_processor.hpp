@@ -1,23 +1,32 @@
 /**
  * @file event_processor.hpp
- * @brief Declares the EventProcessor class for processing container events and host metrics.
+ * @brief Declares the EventProcessor class for processing container events.
  */
 
 #pragma once
 #include <atomic>
+#include <memory>
 #include <thread>
+#include <deque>
+#include <future>
 #include <string>
 #include <unordered_map>
 #include "common.hpp"
 #include "event_queue.hpp"
+#include "json_processing.hpp"
 #include "database_interface.hpp"
+#include "container_inspect_pool.hpp"
+#include "container_metadata_cache.hpp"
+#include "container_runtime_factory_interface.hpp"
 
 /**
  * @class EventProcessor
- * @brief Processes container events and periodically collects host metrics.
+ * @brief Processes container events.
  *
  * Runs in a separate thread, pops events from the event queue, parses them,
- * updates the database, and collects host resource usage at regular intervals.
+ * and updates the database.
+ * Create events are enriched concurrently on a ContainerInspectPool, while results
+ * are applied strictly in event order so a destroy never overtakes its create.
  */
 class EventProcessor {
 public:
@@ -27,8 +36,10 @@ public:
      * @param shutdown_flag Reference to the application's shutdown flag.
      * @param db Reference to the database interface.
      * @param cfg Reference to the monitor configuration.
+     * @param metadata_cache Optional metadata cache kept in sync with events (may be nullptr).
      */
-    EventProcessor(EventQueue& queue, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db, const MonitorConfig& cfg);
+    EventProcessor(EventQueue& queue, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db, const MonitorConfig& cfg,
+                   ContainerMetadataCache* metadata_cache = nullptr);
 
     /**
      * @brief Destructor. Ensures the worker thread is stopped.
@@ -47,10 +58,27 @@ public:
 
 private:
     /**
-     * @brief Worker thread function. Processes events and collects host metrics.
+     * @brief Worker thread function. Processes container events.
      */
     void processLoop();
 
+    /**
+     * @brief Queues a parsed event behind all earlier events, submitting creates for inspection.
+     * @param info Parsed container event.
+     */
+    void enqueueEvent(ContainerEventInfo info);
+
+    /**
+     * @brief Applies all leading pending events whose enrichment has completed.
+     */
+    void applyReadyEvents();
+
+    /**
+     * @brief Applies a single container event to the database and the metadata cache.
+     * @param info Enriched container event.
+     */
+    void applyEvent(const ContainerEventInfo& info);
+
     EventQueue& queue_;                    ///< Reference to the event queue.
     std::atomic<bool>& shutdown_flag_;     ///< Reference to shutdown flag.
     IDatabaseInterface& db_;               ///< Reference to database interface.
@@ -58,4 +86,8 @@ private:
     bool running_ = false;                 ///< Indicates if the processor is running.
     const MonitorConfig& cfg_;             ///< Reference to monitor configuration.
     std::unordered_map<std::string, std::string> name_to_id; ///< Container name to ID mapping.
+    ContainerInspectPool inspect_pool_;    ///< Worker pool for concurrent container inspection.
+    std::deque<std::future<ContainerEventInfo>> pending_events_; ///< Events awaiting in-order application.
+    ContainerMetadataCache* metadata_cache_;  ///< Optional metadata cache (may be nullptr).
+    std::unique_ptr<IContainerRuntimePathFactory> pathFactory_; ///< Path factory for cached resource paths.
 };
\ No newline at end of file
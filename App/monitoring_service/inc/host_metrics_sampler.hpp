@@ -0,0 +1,66 @@
+/**
+ * @file host_metrics_sampler.hpp
+ * @brief Declares the HostMetricsSampler class for periodic host resource sampling.
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include "common.hpp"
+#include "database_interface.hpp"
+
+/**
+ * @class HostMetricsSampler
+ * @brief Samples host CPU and memory usage at a fixed interval on its own thread.
+ *
+ * Samples are taken on a steady-clock schedule independent of container event
+ * traffic, buffered, and inserted into the database in batches of batch_size.
+ */
+class HostMetricsSampler {
+public:
+    /**
+     * @brief Constructs a HostMetricsSampler.
+     * @param cfg Monitor configuration (uses host_sampling_interval_ms and batch_size).
+     * @param db Reference to the database interface.
+     * @param shutdown_flag Reference to the application's shutdown flag.
+     */
+    HostMetricsSampler(const MonitorConfig& cfg, IDatabaseInterface& db, std::atomic<bool>& shutdown_flag);
+
+    /**
+     * @brief Destructor. Ensures the sampler thread is stopped.
+     */
+    ~HostMetricsSampler();
+
+    /**
+     * @brief Starts the sampler thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the sampler thread and flushes buffered samples.
+     */
+    void stop();
+
+private:
+    /**
+     * @brief Worker thread function. Samples host usage on a fixed schedule.
+     */
+    void sampleLoop();
+
+    /**
+     * @brief Inserts buffered samples into the database.
+     */
+    void flush();
+
+    const MonitorConfig& cfg_;              ///< Monitor configuration.
+    IDatabaseInterface& db_;                ///< Reference to database interface.
+    std::atomic<bool>& shutdown_flag_;      ///< Reference to shutdown flag.
+    std::thread worker_;                    ///< Sampler thread.
+    bool running_ = false;                  ///< Indicates if the sampler is running.
+    std::mutex mutex_;                      ///< Mutex for the stop condition.
+    std::condition_variable cv_;            ///< Wakes the sampler on stop.
+    std::vector<HostUsage> buffer_;         ///< Samples not yet inserted.
+};
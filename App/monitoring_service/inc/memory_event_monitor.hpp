@@ -0,0 +1,117 @@
+/**
+ * @file memory_event_monitor.hpp
+ * @brief Declares the MemoryEventMonitor class for kernel-notified container memory events.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "common.hpp"
+#include "cgroup_event_observer.hpp"
+#include "container_runtime_factory_interface.hpp"
+
+/**
+ * @class MemoryEventMonitor
+ * @brief Reports container memory threshold crossings and OOM events as the kernel signals them.
+ *
+ * For every container with a memory limit, eventfd thresholds are registered through
+ * cgroup.event_control at alert_warning and alert_critical percent of the limit, plus
+ * an OOM notification on memory.oom_control. All eventfds are multiplexed in a single
+ * epoll loop, so crossings are reported immediately regardless of the sampling rate.
+ * Registered as a container observer; containers whose cgroup does not exist yet are
+ * armed with a backoff once it appears.
+ */
+class MemoryEventMonitor : public CgroupEventObserver {
+public:
+    /**
+     * @brief Constructs a MemoryEventMonitor.
+     * @param cfg Monitor configuration (uses alert_warning, alert_critical and cgroup settings).
+     * @param shutdown_flag Reference to the application's shutdown flag.
+     */
+    MemoryEventMonitor(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag);
+
+    /**
+     * @brief Destructor. Stops the event loop and releases all registrations.
+     */
+    ~MemoryEventMonitor();
+
+    /**
+     * @brief Starts the event loop thread (no-op if the cgroup version has no cgroup.event_control).
+     */
+    void start();
+
+private:
+    /**
+     * @enum EventKind
+     * @brief Kind of a registered memory notification.
+     */
+    enum class EventKind { Warning, Critical, Oom };
+
+    /**
+     * @struct Registration
+     * @brief A single eventfd registration.
+     */
+    struct Registration {
+        std::string name;               ///< Container name.
+        EventKind kind;                 ///< Notification kind.
+        uint64_t threshold_bytes = 0;   ///< Usage threshold (0 for OOM).
+    };
+
+    /**
+     * @struct ArmedContainer
+     * @brief Open files and eventfds of an armed container, owned by the event loop thread.
+     */
+    struct ArmedContainer {
+        int memory_limit = 0;           ///< Memory limit (MB).
+        int usage_fd = -1;              ///< Open memory usage file the thresholds refer to.
+        int oom_fd = -1;                ///< Open memory.oom_control file.
+        std::vector<int> event_fds;     ///< Registered eventfds.
+    };
+
+    /**
+     * @brief Registers threshold and OOM notifications for a container.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     * @return True if at least one notification was registered.
+     */
+    bool arm(const std::string& name, const ContainerInfo& info) override;
+
+    /**
+     * @brief Registers one eventfd through cgroup.event_control.
+     * @param control_fd Open cgroup.event_control descriptor.
+     * @param target_fd Descriptor of the file the notification refers to.
+     * @param args Extra arguments (threshold), empty for OOM.
+     * @param registration Registration to record.
+     * @param container Container state receiving the eventfd.
+     * @return True on success.
+     */
+    bool registerEvent(int control_fd, int target_fd, const std::string& args,
+                       Registration registration, ArmedContainer& container);
+
+    /**
+     * @brief Releases all notifications of a container.
+     * @param name Container name.
+     */
+    void disarm(const std::string& name) override;
+
+    /**
+     * @brief Closes a container's files and eventfds.
+     * @param container Container state.
+     */
+    void release(ArmedContainer& container);
+
+    /**
+     * @brief Reads a signalled eventfd and reports the event.
+     * @param event_fd The signalled eventfd.
+     * @param events epoll event mask (unused; eventfds only signal EPOLLIN).
+     */
+    void handleEvent(int event_fd, uint32_t events) override;
+
+    const MonitorConfig& cfg_;                                   ///< Monitor configuration.
+    std::unique_ptr<IContainerRuntimePathFactory> pathFactory_;  ///< Path factory for cgroup files.
+    std::unordered_map<std::string, ArmedContainer> armed_;      ///< Armed containers by name.
+    std::unordered_map<int, Registration> registrations_;        ///< Registrations by eventfd.
+};
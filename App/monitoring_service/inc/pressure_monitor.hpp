@@ -0,0 +1,107 @@
+/**
+ * @file pressure_monitor.hpp
+ * @brief Declares the PressureMonitor class for cgroup v2 pressure stall (PSI) triggers.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "common.hpp"
+#include "cgroup_event_observer.hpp"
+#include "database_interface.hpp"
+#include "resource_thread_pool.hpp"
+#include "container_runtime_factory_interface.hpp"
+
+/**
+ * @class PressureMonitor
+ * @brief Registers per-container PSI triggers and reacts when the kernel reports a stall.
+ *
+ * For every container a "some <stall> <window>" trigger is written to its cpu.pressure,
+ * memory.pressure and io.pressure files. All trigger descriptors are multiplexed in a
+ * single epoll loop and cost nothing until contention appears. When a trigger fires,
+ * the current pressure values are recorded in the database and the container's
+ * sampling rate is raised for psi_boost_duration_ms.
+ */
+class PressureMonitor : public CgroupEventObserver {
+public:
+    /**
+     * @brief Constructs a PressureMonitor.
+     * @param cfg Monitor configuration (uses the psi_* settings and cgroup settings).
+     * @param db Database to record pressure samples in.
+     * @param thread_pool Thread pool whose sampling is raised on pressure.
+     * @param shutdown_flag Reference to the application's shutdown flag.
+     */
+    PressureMonitor(const MonitorConfig& cfg, IDatabaseInterface& db, ResourceThreadPool& thread_pool,
+                    std::atomic<bool>& shutdown_flag);
+
+    /**
+     * @brief Destructor. Stops the event loop and releases all triggers.
+     */
+    ~PressureMonitor();
+
+    /**
+     * @brief Starts the event loop thread (no-op if the cgroup version has no PSI files).
+     */
+    void start();
+
+    /**
+     * @brief Parses the content of a pressure file.
+     * @param content Pressure file content ("some avg10=... total=...\nfull avg10=...").
+     * @param sample PressureSample whose some_avg10, full_avg10 and some_total_us are filled in.
+     * @return True if the some line could be parsed.
+     */
+    static bool parsePressure(const char* content, PressureSample& sample);
+
+private:
+    /**
+     * @struct Trigger
+     * @brief A registered PSI trigger.
+     */
+    struct Trigger {
+        std::string name;       ///< Container name.
+        std::string resource;   ///< Resource (cpu, memory or io).
+    };
+
+    /**
+     * @brief Registers cpu, memory and io triggers for a container.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     * @return True if at least one trigger was registered.
+     */
+    bool arm(const std::string& name, const ContainerInfo& info) override;
+
+    /**
+     * @brief Registers a trigger on one pressure file.
+     * @param name Container name.
+     * @param resource Resource name.
+     * @param path Pressure file path.
+     * @param trigger_fds Container's trigger descriptors, receiving the new one.
+     * @return True on success.
+     */
+    bool registerTrigger(const std::string& name, const char* resource, const std::string& path,
+                         std::vector<int>& trigger_fds);
+
+    /**
+     * @brief Releases all triggers of a container.
+     * @param name Container name.
+     */
+    void disarm(const std::string& name) override;
+
+    /**
+     * @brief Handles a fired or failed trigger descriptor.
+     * @param fd Trigger descriptor.
+     * @param events epoll event mask.
+     */
+    void handleEvent(int fd, uint32_t events) override;
+
+    const MonitorConfig& cfg_;                                   ///< Monitor configuration.
+    IDatabaseInterface& db_;                                     ///< Database for pressure samples.
+    ResourceThreadPool& thread_pool_;                            ///< Thread pool to boost.
+    std::unique_ptr<IContainerRuntimePathFactory> pathFactory_;  ///< Path factory for pressure files.
+    std::string trigger_;                                        ///< Trigger line written to each pressure file.
+    std::unordered_map<std::string, std::vector<int>> trigger_fds_; ///< Trigger descriptors of armed containers.
+    std::unordered_map<int, Trigger> triggers_;                  ///< Registered triggers by descriptor.
+};
@@ -9,29 +9,44 @@
 #include <atomic>
 #include <map>
 #include <mutex>
+#include <memory>
 #include <string>
+#include <unistd.h>
 #include <unordered_map>
 #include <condition_variable>
 #include "database_interface.hpp" 
 #include "common.hpp"
+#include "metrics_table.hpp"
+#include "sliding_window_extrema.hpp"
+#include "quantile_sketch.hpp"
+#include "alert_engine.hpp"
+#include "holt_forecaster.hpp"
+#include "anomaly_detector.hpp"
+#include "heavy_hitters.hpp"
+#include "alert_channel.hpp"
+#include "container_observer.hpp"
 #include "container_runtime_factory_interface.hpp"
 
 /**
  * @class ResourceThreadPool
  * @brief Manages a pool of threads for collecting container resource metrics in parallel.
  *
- * Assigns containers to threads, collects metrics, batches data for database insertion,
- * and sends max metrics to the UI via message queue.
+ * Assigns containers to threads, each of which owns the sampling state of its containers.
+ * Every sample is batched for the database, checked against the alert rules and published
+ * to the container's slot in the shared-memory metrics table. As a database observer, it
+ * picks up added and removed containers as soon as they are saved.
  */
-class ResourceThreadPool {
+class ResourceThreadPool : public IContainerObserver {
 public:
     /**
      * @brief Constructs a ResourceThreadPool.
      * @param cfg Monitor configuration.
      * @param shutdown_flag Reference to the application's shutdown flag.
      * @param db Reference to the database interface.
+     * @param alert_channel Channel receiving alerts, or nullptr to disable alerting.
      */
-    ResourceThreadPool(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db);
+    ResourceThreadPool(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db,
+                       AlertChannel* alert_channel = nullptr);
 
     /**
      * @brief Destructor. Ensures all threads are stopped and buffers flushed.
@@ -50,9 +65,14 @@ public:
 
     /**
      * @brief Adds a container to the thread pool for monitoring.
+     *
+     * Adding a container that is already monitored is a no-op.
+     *
      * @param name Container name.
+     * @param info ContainerInfo struct.
+     * @param paths Previously resolved resource paths, or nullptr to resolve them from the container ID.
      */
-    void addContainer(const std::string& name);
+    void addContainer(const std::string& name, const ContainerInfo& info, const ContainerResourcePaths* paths = nullptr);
 
     /**
      * @brief Removes a container from the thread pool.
@@ -61,7 +81,31 @@ public:
     void removeContainer(const std::string& name);
 
     /**
-     * @brief Flushes all metric buffers to the database.
+     * @brief Starts monitoring a container saved to the database.
+     * @param name Container name.
+     * @param info ContainerInfo struct.
+     */
+    void onContainerAdded(const std::string& name, const ContainerInfo& info) override;
+
+    /**
+     * @brief Stops monitoring a container removed from the database.
+     * @param name Container name.
+     */
+    void onContainerRemoved(const std::string& name) override;
+
+    /**
+     * @brief Temporarily raises the sampling rate of a container.
+     *
+     * The container is sampled every psi_boost_interval_ms until the boost expires,
+     * starting right away. Unknown containers are ignored.
+     *
+     * @param name Container name.
+     * @param duration_ms How long the raised rate lasts.
+     */
+    void boostSampling(const std::string& name, int duration_ms);
+
+    /**
+     * @brief Flushes all metric buffers to the database (after the workers have stopped).
      */
     void flushAllBuffers();
 
@@ -71,25 +115,271 @@ public:
      */
     std::map<int, std::vector<std::string>> getAssignments();
 
+    /**
+     * @brief Returns the top CPU and memory consumers.
+     *
+     * Usage is averaged with exponentially decaying weights (half-life HEAVY_HITTER_HALF_LIFE_MS).
+     *
+     * @param k Maximum number of consumers per resource.
+     * @param now_ms Current time in milliseconds.
+     * @param cpu Receives the top consumers by average CPU cores.
+     * @param memory Receives the top consumers by average memory in MB.
+     */
+    void topConsumers(size_t k, int64_t now_ms, std::vector<HeavyHitter>& cpu, std::vector<HeavyHitter>& memory) const;
+
+    /**
+     * @brief Logs the top CPU and memory consumers.
+     * @param k Maximum number of consumers per resource.
+     * @param now_ms Current time in milliseconds.
+     */
+    void logTopConsumers(size_t k, int64_t now_ms) const;
+
 private:
+    /**
+     * @enum ContainerState
+     * @brief Lifecycle state of a monitored container.
+     */
+    enum class ContainerState {
+        Created,    ///< Registered, cgroup not seen yet.
+        Running,    ///< Cgroup exists, container is sampled.
+        Stopped     ///< Cgroup disappeared, waiting for a restart.
+    };
+
+    /**
+     * @struct MetricSketches
+     * @brief Quantile sketches of the three container metrics over one window.
+     */
+    struct MetricSketches {
+        QuantileSketch cpu;         ///< CPU usage percent.
+        QuantileSketch memory;      ///< Memory usage percent.
+        QuantileSketch pids;        ///< PIDs usage percent.
+
+        /**
+         * @brief Adds a sample to all sketches.
+         * @param metrics Sample to add.
+         * @param weight_ms Time the sample stands for, in milliseconds.
+         */
+        void add(const ContainerMetrics& metrics, uint64_t weight_ms) {
+            cpu.add(metrics.cpu_usage_percent, weight_ms);
+            memory.add(metrics.memory_usage_percent, weight_ms);
+            pids.add(metrics.pids_percent, weight_ms);
+        }
+
+        /**
+         * @brief Merges the sketches of another window.
+         * @param other Sketches to merge.
+         */
+        void merge(const MetricSketches& other) {
+            cpu.merge(other.cpu);
+            memory.merge(other.memory);
+            pids.merge(other.pids);
+        }
+
+        /**
+         * @brief Empties all sketches.
+         */
+        void clear() {
+            cpu.clear();
+            memory.clear();
+            pids.clear();
+        }
+    };
+
+    /**
+     * @struct MonitoredContainer
+     * @brief Per-container sampling state, owned by the container's worker thread.
+     */
+    struct MonitoredContainer {
+        ContainerInfo info;                             ///< Container ID and resource limits.
+        ContainerResourcePaths paths;                   ///< Resource file paths (valid once resolved).
+        bool paths_resolved = false;                    ///< Whether paths have been resolved.
+        ContainerState state = ContainerState::Created; ///< Current lifecycle state.
+        int64_t next_probe_ms = 0;                      ///< Earliest time to probe the cgroup again.
+        int probe_backoff_ms = 0;                       ///< Current negative cache delay.
+        bool has_prev_cpu = false;                      ///< Whether a previous CPU sample exists.
+        int64_t prev_cpu_ts = 0;                        ///< Timestamp of the previous CPU sample.
+        uint64_t prev_cpu_ns = 0;                       ///< Cumulative CPU time of the previous sample.
+        int64_t last_sample_ms = 0;                     ///< Timestamp of the last sample (0 before the first).
+        int64_t interval_ms = 0;                        ///< Adaptive sampling interval (0 until the first calm sample).
+        bool has_prev_metrics = false;                  ///< Whether prev_metrics holds a sample.
+        ContainerMetrics prev_metrics{};                ///< Previous sample, used to detect activity.
+        bool has_recorded = false;                      ///< Whether last_recorded holds a stored sample.
+        ContainerMetrics last_recorded{};               ///< Last sample stored (deadband reference).
+        SlidingWindowExtrema cpu_window;                ///< CPU usage over the UI window.
+        SlidingWindowExtrema memory_window;             ///< Memory usage over the UI window.
+        SlidingWindowExtrema pids_window;               ///< PIDs usage over the UI window.
+        SlidingWindowExtrema peak_window;               ///< Kernel memory high-water marks over the UI window.
+        MetricSketches window_sketches;                 ///< Percentile sketches of the open percentile window.
+        MetricSketches rollup_sketches;                 ///< Merged sketches of the closed windows of the open rollup.
+        int64_t window_start_ms = -1;                   ///< Start of the open percentile window (-1 before the first sample).
+        int64_t rollup_start_ms = -1;                   ///< Start of the open rollup (-1 while it is empty).
+        AlertState alert_state;                         ///< Alert rule state.
+        HoltForecaster memory_forecast;                 ///< Memory usage trend.
+        HoltForecaster pids_forecast;                   ///< PIDs usage trend.
+        AnomalyDetector anomaly;                        ///< EWMA z-score test of every sample.
+        int64_t anomaly_seen_ms[ANOMALY_METRICS] = {-1, -1, -1}; ///< Time of the last anomaly per metric (-1 if none).
+        std::atomic<int64_t> boost_until_ms{0};         ///< Raised sampling rate applies until this time.
+        int peak_fd = -1;                               ///< Open memory high-water mark file (-1 if not open).
+        MetricsTable* table = nullptr;                  ///< Metrics table holding the UI slot (nullptr without UI).
+        int table_slot = -1;                            ///< Claimed metrics table slot (-1 if none).
+
+        /**
+         * @brief Closes the high-water mark descriptor.
+         */
+        void closePeak() {
+            if (peak_fd >= 0) close(peak_fd);
+            peak_fd = -1;
+        }
+
+        /**
+         * @brief Destructor. Releases the high-water mark descriptor and the metrics table slot.
+         *
+         * Runs once the last reference is dropped, so the slot never has two writers.
+         */
+        ~MonitoredContainer() {
+            closePeak();
+            if (table && table_slot >= 0) table->release(table_slot);
+        }
+    };
+
+    /**
+     * @struct FlushDeadline
+     * @brief Time by which a DB batch must be flushed, queued per worker in time order.
+     */
+    struct FlushDeadline {
+        int64_t deadline_ms;        ///< Flush time.
+        int64_t started_ms;         ///< Timestamp of the oldest sample, identifies the batch.
+        std::string name;           ///< Container name.
+    };
+
+    /**
+     * @struct ConsumerSummaries
+     * @brief Top-consumer summaries of one worker thread.
+     *
+     * Memory is bounded regardless of container churn. A container recreated on another
+     * worker has counters in both summaries, which topConsumers() sums by name.
+     */
+    struct ConsumerSummaries {
+        mutable std::mutex mutex;       ///< Guards the summaries against readers.
+        HeavyHitters cpu;               ///< CPU core-milliseconds per container.
+        HeavyHitters memory;            ///< Memory MB-milliseconds per container.
+
+        /**
+         * @brief Constructs empty summaries.
+         * @param capacity Counters per summary.
+         */
+        explicit ConsumerSummaries(size_t capacity) : cpu(capacity), memory(capacity) {}
+    };
+
+    /**
+     * @brief Adds a sample to a container's UI windows and publishes the window extremes.
+     * @param name Container name.
+     * @param container Container state.
+     * @param metrics Latest sample.
+     * @param forecast Time-to-limit forecast including the sample.
+     */
+    void publishSample(const std::string& name, MonitoredContainer& container, const ContainerMetrics& metrics,
+                       const ContainerForecast& forecast);
+
+    /**
+     * @brief Adds a sample to a container's memory and PIDs trends and forecasts their limits.
+     * @param container Container state.
+     * @param metrics Latest sample.
+     * @return Time-to-limit forecast.
+     */
+    static ContainerForecast updateForecast(MonitoredContainer& container, const ContainerMetrics& metrics);
+
+    /**
+     * @brief Adds a sample to a container's percentile window, closing the previous window first.
+     * @param name Container name.
+     * @param container Container state.
+     * @param metrics Latest sample.
+     * @param weight_ms Time the sample stands for, in milliseconds.
+     */
+    void recordPercentiles(const std::string& name, MonitoredContainer& container, const ContainerMetrics& metrics,
+                           int64_t weight_ms);
+
+    /**
+     * @brief Stores the percentiles of a container's open window and merges it into the rollup.
+     *
+     * The rollup is stored as well once the next window belongs to a different rollup.
+     *
+     * @param name Container name.
+     * @param container Container state.
+     * @param next_window_start_ms Start of the window that follows, or -1 to close the rollup too.
+     */
+    void closePercentileWindow(const std::string& name, MonitoredContainer& container, int64_t next_window_start_ms);
+
+    /**
+     * @brief Appends the percentiles of a window's sketches, one row per metric.
+     * @param rows Rows to append to.
+     * @param sketches Sketches of the window.
+     * @param window_start_ms Start of the window.
+     * @param window_ms Window length.
+     */
+    static void appendPercentiles(std::vector<ContainerPercentiles>& rows, const MetricSketches& sketches,
+                                  int64_t window_start_ms, int64_t window_ms);
+
     /**
      * @brief Worker thread function for collecting metrics.
      * @param thread_index Index of the worker thread.
      */
     void workerLoop(int thread_index);
 
+    /**
+     * @brief Adapts a container's sampling interval to its latest sample.
+     *
+     * The interval grows geometrically toward max_sampling_interval_ms while the metrics
+     * are flat and well below alert_warning, and snaps back to the regular period when a
+     * value changes by adaptive_change_threshold or approaches the threshold.
+     *
+     * @param container Container state.
+     * @param metrics Latest sample.
+     * @param regular_period_ms Regular (minimum) sampling period.
+     */
+    void adaptInterval(MonitoredContainer& container, const ContainerMetrics& metrics, int64_t regular_period_ms);
+
+    /**
+     * @brief Checks a sample against the deadband of the last stored sample.
+     *
+     * A sample is stored if any metric moved by more than the larger of deadband_absolute
+     * and deadband_relative x last stored value, if deadband_heartbeat_ms passed since
+     * the last stored sample, or if the sample is flagged as anomalous.
+     *
+     * @param container Container state.
+     * @param metrics Latest sample.
+     * @return True if the sample should be stored.
+     */
+    bool isRecordable(const MonitoredContainer& container, const ContainerMetrics& metrics) const;
+
+    /**
+     * @brief Checks whether a non-running container's cgroup exists and resolves its paths.
+     *
+     * On a miss the next probe is pushed back with an exponential backoff.
+     *
+     * @param name Container name.
+     * @param container Container state.
+     * @param now_ms Current time in milliseconds.
+     * @return True if the container is now running, false otherwise.
+     */
+    bool probeContainer(const std::string& name, MonitoredContainer& container, int64_t now_ms);
+
     std::atomic<bool>& shutdown_flag_;                ///< Reference to shutdown flag.
-    bool running_ = false;                            ///< Indicates if the pool is running.
+    std::atomic<bool> running_{false};                ///< Indicates if the pool is running.
     IDatabaseInterface& db_;                          ///< Reference to database interface.
     std::mutex assign_mutex_;                         ///< Mutex for assignments and buffers.
     const MonitorConfig& cfg_;                        ///< Monitor configuration.
     std::condition_variable cv_;                      ///< Condition variable for thread coordination.
+    uint64_t wake_generation_ = 0;                    ///< Bumped to wake workers before their wait expires.
     std::vector<std::thread> threads_;                ///< Worker threads.
     std::vector<std::vector<std::string>> thread_containers_;   ///< Containers assigned to each thread.
     std::unordered_map<std::string, int> container_to_thread_;  ///< Container to thread index mapping.
     std::unique_ptr<IContainerRuntimePathFactory> pathFactory_; ///< Path factory for resource files.
-    std::vector<std::map<std::string, ContainerInfo>> thread_local_info_;               ///< Per-thread container info.
-    std::unordered_map<std::string, std::pair<int64_t, uint64_t>> prev_cpu_usage_;      ///< Previous CPU usage for delta calculation.
-    std::vector<std::map<std::string, ContainerResourcePaths>> thread_local_paths_;     ///< Per-thread resource paths.
+    std::unique_ptr<MetricsTable> metrics_table_;     ///< UI metrics table (nullptr without UI), outlives container state.
+    AlertEngine alert_engine_;                        ///< Compiled alert rules.
+    AlertChannel* alert_channel_;                     ///< Alert channel (nullptr if alerting is disabled).
+    std::vector<std::map<std::string, std::shared_ptr<MonitoredContainer>>> thread_local_state_; ///< Per-thread container state.
     std::vector<std::map<std::string, std::vector<ContainerMetrics>>> thread_buffers_;  ///< Per-thread metric buffers.
+    std::vector<std::vector<std::pair<std::string, std::shared_ptr<MonitoredContainer>>>> retired_; ///< Removed containers whose open windows are still to be stored, per thread.
+    std::vector<std::unique_ptr<ConsumerSummaries>> consumers_; ///< Per-thread top-consumer summaries.
 };
\ No newline at end of file
@@ -0,0 +1,233 @@
+/**
+ * @file cgroup_event_observer.cpp
+ * @brief Implements the CgroupEventObserver base class for kernel notifications on container cgroups.
+ */
+
+#include "cgroup_event_observer.hpp"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "logger.hpp"
+
+/**
+ * @brief Returns the current monotonic time in milliseconds.
+ * @return Milliseconds since an arbitrary epoch.
+ */
+static int64_t steadyMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Constructs the observer without starting the loop.
+ * @param log_tag Prefix of log lines (e.g. "[Pressure]").
+ * @param shutdown_flag Reference to the application's shutdown flag.
+ */
+CgroupEventObserver::CgroupEventObserver(const char* log_tag, std::atomic<bool>& shutdown_flag)
+    : log_tag_(log_tag), shutdown_flag_(shutdown_flag) {}
+
+/**
+ * @brief Destructor. Joins the loop thread if stop() was not called.
+ *
+ * Notifications cannot be released here because the derived part is already destroyed;
+ * closing the epoll instance only stops the loop from watching them.
+ */
+CgroupEventObserver::~CgroupEventObserver() {
+    running_ = false;
+    wake();
+    if (worker_.joinable()) worker_.join();
+    if (wake_fd_ >= 0) close(wake_fd_);
+    if (epoll_fd_ >= 0) close(epoll_fd_);
+}
+
+/**
+ * @brief Creates the epoll instance and starts the event loop thread.
+ * @return True if the loop is running.
+ */
+bool CgroupEventObserver::startLoop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        CM_LOG_ERROR << log_tag_ << " Failed to create epoll/eventfd: " << strerror(errno) << "\n";
+        return false;
+    }
+    addDescriptor(wake_fd_, EPOLLIN);
+
+    running_ = true;
+    worker_ = std::thread(&CgroupEventObserver::eventLoop, this);
+    return true;
+}
+
+/**
+ * @brief Stops the event loop thread and releases all containers' notifications.
+ */
+void CgroupEventObserver::stop() {
+    running_ = false;
+    wake();
+    if (worker_.joinable()) worker_.join();
+
+    for (auto& [name, container] : containers_) {
+        if (container.armed) disarm(name);
+    }
+    containers_.clear();
+    if (wake_fd_ >= 0) close(wake_fd_);
+    if (epoll_fd_ >= 0) close(epoll_fd_);
+    wake_fd_ = epoll_fd_ = -1;
+}
+
+/**
+ * @brief Queues a container for arming.
+ * @param name Container name.
+ * @param info ContainerInfo struct.
+ */
+void CgroupEventObserver::onContainerAdded(const std::string& name, const ContainerInfo& info) {
+    queue({name, info, false});
+}
+
+/**
+ * @brief Queues a container's notifications for release.
+ * @param name Container name.
+ */
+void CgroupEventObserver::onContainerRemoved(const std::string& name) {
+    queue({name, {}, true});
+}
+
+/**
+ * @brief Adds a descriptor to the event loop.
+ * @param fd Descriptor.
+ * @param events epoll event mask.
+ * @return True on success.
+ */
+bool CgroupEventObserver::addDescriptor(int fd, uint32_t events) {
+    struct epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+/**
+ * @brief Removes a descriptor from the event loop (before it is closed).
+ * @param fd Descriptor.
+ */
+void CgroupEventObserver::removeDescriptor(int fd) {
+    if (epoll_fd_ >= 0) epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+/**
+ * @brief Releases a container's notifications and arms it again once its cgroup reappears.
+ *
+ * Called by derived classes when the kernel reports that the cgroup was removed while
+ * the container is still registered (e.g. it stopped and may start again).
+ *
+ * @param name Container name.
+ */
+void CgroupEventObserver::rearmLater(const std::string& name) {
+    auto it = containers_.find(name);
+    if (it == containers_.end() || !it->second.armed) return;
+    // The key outlives disarm(), unlike a name owned by a released registration
+    disarm(it->first);
+    it->second.armed = false;
+    it->second.next_attempt_ms = steadyMs() + CGROUP_PROBE_INITIAL_MS;
+}
+
+/**
+ * @brief Queues a request and wakes the event loop.
+ * @param request Request to queue.
+ */
+void CgroupEventObserver::queue(Request request) {
+    {
+        std::lock_guard<std::mutex> lock(request_mutex_);
+        requests_.push_back(std::move(request));
+    }
+    wake();
+}
+
+/**
+ * @brief Event loop thread function.
+ *
+ * - Applies queued container additions and removals.
+ * - Arms containers whose cgroup has appeared.
+ * - Waits on all registered descriptors and hands ready ones to the derived class.
+ */
+void CgroupEventObserver::eventLoop() {
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    while (running_ && !shutdown_flag_) {
+        applyRequests();
+        int timeout_ms = armPending(steadyMs());
+        if (timeout_ms < 0 || timeout_ms > SLEEP_MS_MEDIUM) timeout_ms = SLEEP_MS_MEDIUM;
+
+        int ready = epoll_wait(epoll_fd_, events, EPOLL_MAX_EVENTS, timeout_ms);
+        if (ready < 0 && errno != EINTR) {
+            CM_LOG_ERROR << log_tag_ << " epoll_wait failed: " << strerror(errno) << "\n";
+            break;
+        }
+        for (int i = 0; i < ready; ++i) {
+            if (events[i].data.fd == wake_fd_) {
+                uint64_t count;
+                (void)!read(wake_fd_, &count, sizeof(count));
+            } else {
+                handleEvent(events[i].data.fd, events[i].events);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Applies queued add and remove requests.
+ */
+void CgroupEventObserver::applyRequests() {
+    std::vector<Request> requests;
+    {
+        std::lock_guard<std::mutex> lock(request_mutex_);
+        requests.swap(requests_);
+    }
+    for (auto& request : requests) {
+        auto it = containers_.find(request.name);
+        if (request.remove) {
+            if (it == containers_.end()) continue;
+            if (it->second.armed) disarm(it->first);
+            containers_.erase(it);
+        } else if (it == containers_.end()) {
+            containers_[request.name].info = std::move(request.info);
+        }
+    }
+}
+
+/**
+ * @brief Arms containers whose retry delay has elapsed.
+ * @param now_ms Current time in milliseconds.
+ * @return Milliseconds until the next arming attempt, or -1 if none is pending.
+ */
+int CgroupEventObserver::armPending(int64_t now_ms) {
+    int64_t next = -1;
+    for (auto& [name, container] : containers_) {
+        if (container.armed) continue;
+        if (container.next_attempt_ms <= now_ms) {
+            if (arm(name, container.info)) {
+                container.armed = true;
+                container.backoff_ms = 0;
+                continue;
+            }
+            // Cgroup not there yet (created but not started)
+            container.backoff_ms = container.backoff_ms == 0
+                ? CGROUP_PROBE_INITIAL_MS : std::min(container.backoff_ms * 2, CGROUP_PROBE_MAX_MS);
+            container.next_attempt_ms = now_ms + container.backoff_ms;
+        }
+        if (next < 0 || container.next_attempt_ms < next) next = container.next_attempt_ms;
+    }
+    return next < 0 ? -1 : static_cast<int>(std::max<int64_t>(next - now_ms, 0));
+}
+
+/**
+ * @brief Wakes the event loop thread.
+ */
+void CgroupEventObserver::wake() {
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        (void)!write(wake_fd_, &one, sizeof(one));
+    }
+}
\ No newline at end of file
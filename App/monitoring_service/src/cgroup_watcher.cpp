@@ -0,0 +1,228 @@
+/**
+ * @file cgroup_watcher.cpp
+ * @brief Implements the CgroupWatcher class for runtime-free container discovery.
+ */
+
+#include "cgroup_watcher.hpp"
+#include <poll.h>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include "logger.hpp"
+#include "metrics_reader.hpp"
+#include "container_discovery.hpp"
+#include "container_runtime_configuration.hpp"
+
+/**
+ * @brief Returns the current wall-clock time in milliseconds.
+ * @return Milliseconds since the Unix epoch.
+ */
+static int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Constructs a CgroupWatcher.
+ * @param cfg Monitor configuration (uses runtime, cgroup and cgroup_root).
+ * @param db Reference to the database interface.
+ * @param shutdown_flag Reference to the application's shutdown flag.
+ */
+CgroupWatcher::CgroupWatcher(const MonitorConfig& cfg, IDatabaseInterface& db, std::atomic<bool>& shutdown_flag)
+    : cfg_(cfg), db_(db), shutdown_flag_(shutdown_flag),
+      pathFactory_(createPathFactory(cfg.runtime, cfg.cgroup, cfg.cgroup_root))
+{
+    parent_dirs_ = pathFactory_->getParentDirs();
+    watch_descriptors_.assign(parent_dirs_.size(), -1);
+}
+
+/**
+ * @brief Destructor. Ensures the watcher thread is stopped.
+ */
+CgroupWatcher::~CgroupWatcher() {
+    stop();
+}
+
+/**
+ * @brief Starts the watcher thread.
+ */
+void CgroupWatcher::start() {
+    if (!running_) {
+        running_ = true;
+        worker_ = std::thread(&CgroupWatcher::watchLoop, this);
+    }
+}
+
+/**
+ * @brief Stops the watcher thread.
+ */
+void CgroupWatcher::stop() {
+    running_ = false;
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+/**
+ * @brief Worker thread function. Multiplexes inotify events and pending registrations.
+ *
+ * - Adds watches for parent directories as soon as they exist.
+ * - Waits on the inotify descriptor, bounded by the next pending registration.
+ * - Registers containers once their settle delay has elapsed.
+ * - Handles shutdown and closes the inotify instance.
+ */
+void CgroupWatcher::watchLoop() {
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        CM_LOG_ERROR << "[CgroupWatcher] inotify_init1 failed: " << strerror(errno) << "\n";
+        return;
+    }
+
+    while (running_ && !shutdown_flag_) {
+        addMissingWatches(nowMs());
+        int next_due_ms = registerDueContainers(nowMs());
+
+        int timeout_ms = SLEEP_MS_MEDIUM;
+        if (next_due_ms >= 0 && next_due_ms < timeout_ms) timeout_ms = next_due_ms;
+
+        struct pollfd pfd{inotify_fd_, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready < 0 && errno != EINTR) {
+            CM_LOG_ERROR << "[CgroupWatcher] poll failed: " << strerror(errno) << "\n";
+            break;
+        }
+        if (ready > 0 && (pfd.revents & POLLIN)) {
+            handleEvents(nowMs());
+        }
+    }
+
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+}
+
+/**
+ * @brief Adds inotify watches for parent directories that exist but are not yet watched.
+ * @param now_ms Current time in milliseconds.
+ */
+void CgroupWatcher::addMissingWatches(int64_t now_ms) {
+    for (size_t i = 0; i < parent_dirs_.size(); ++i) {
+        if (watch_descriptors_[i] >= 0) continue;
+        int wd = inotify_add_watch(inotify_fd_, parent_dirs_[i].c_str(), IN_CREATE | IN_DELETE | IN_ONLYDIR);
+        if (wd < 0) continue; // Parent not created yet, retried on the next loop
+        watch_descriptors_[i] = wd;
+        CM_LOG_INFO << "[CgroupWatcher] Watching " << parent_dirs_[i] << "\n";
+        for (const auto& id : ContainerDiscovery::scanParentDir(parent_dirs_[i])) {
+            markPresent(id, i, now_ms);
+        }
+    }
+}
+
+/**
+ * @brief Reads and dispatches all pending inotify events.
+ * @param now_ms Current time in milliseconds.
+ */
+void CgroupWatcher::handleEvents(int64_t now_ms) {
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t len = read(inotify_fd_, buffer, sizeof(buffer));
+        if (len <= 0) break; // EAGAIN: queue drained
+
+        for (char* ptr = buffer; ptr < buffer + len; ) {
+            auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            size_t controller = 0;
+            while (controller < watch_descriptors_.size() && watch_descriptors_[controller] != event->wd) ++controller;
+            if (controller == watch_descriptors_.size()) continue;
+
+            if (event->mask & IN_IGNORED) {
+                // Parent directory itself went away; re-added once it reappears
+                watch_descriptors_[controller] = -1;
+                continue;
+            }
+            if (!(event->mask & IN_ISDIR) || event->len == 0) continue;
+
+            std::string id(event->name);
+            if (!ContainerDiscovery::isContainerId(id)) continue;
+            if (event->mask & IN_CREATE) {
+                markPresent(id, controller, now_ms);
+            } else if (event->mask & IN_DELETE) {
+                markAbsent(id, controller);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Records that a container's directory exists in a controller hierarchy.
+ *
+ * Once present in every hierarchy, the container is scheduled for registration after
+ * CGROUP_SETTLE_MS, giving the runtime time to write its limit files.
+ *
+ * @param id Container ID.
+ * @param controller Index of the controller hierarchy.
+ * @param now_ms Current time in milliseconds.
+ */
+void CgroupWatcher::markPresent(const std::string& id, size_t controller, int64_t now_ms) {
+    auto& state = cgroups_[id];
+    state.present_mask |= 1u << controller;
+    unsigned all_mask = (1u << parent_dirs_.size()) - 1;
+    if (state.present_mask == all_mask && !state.registered && state.due_ms == 0) {
+        state.due_ms = now_ms + CGROUP_SETTLE_MS;
+    }
+}
+
+/**
+ * @brief Records that a container's directory was removed from a controller hierarchy.
+ * @param id Container ID.
+ * @param controller Index of the controller hierarchy.
+ */
+void CgroupWatcher::markAbsent(const std::string& id, size_t controller) {
+    auto it = cgroups_.find(id);
+    if (it == cgroups_.end()) return;
+    auto& state = it->second;
+    state.present_mask &= ~(1u << controller);
+    state.due_ms = 0;
+    if (state.registered) {
+        std::string name = id.substr(0, SHORT_CONTAINER_ID_LENGTH);
+        db_.removeContainer(name);
+        state.registered = false;
+        CM_LOG_INFO << "[CgroupWatcher] Container stopped: " << name << "\n";
+    }
+    if (state.present_mask == 0) cgroups_.erase(it);
+}
+
+/**
+ * @brief Reads limits and registers containers whose settle delay has elapsed.
+ * @param now_ms Current time in milliseconds.
+ * @return Milliseconds until the next pending registration, or -1 if none.
+ */
+int CgroupWatcher::registerDueContainers(int64_t now_ms) {
+    int64_t next_due = -1;
+    for (auto& [id, state] : cgroups_) {
+        if (state.due_ms == 0) continue;
+        if (state.due_ms > now_ms) {
+            if (next_due < 0 || state.due_ms < next_due) next_due = state.due_ms;
+            continue;
+        }
+
+        ContainerInfo info{id, 0.0, 0, 0};
+        if (!MetricsReader::readContainerLimits(pathFactory_->getLimitPaths(id), info)) {
+            // Limit files not readable yet, try again after another settle delay
+            state.due_ms = now_ms + CGROUP_SETTLE_MS;
+            if (next_due < 0 || state.due_ms < next_due) next_due = state.due_ms;
+            continue;
+        }
+        std::string name = id.substr(0, SHORT_CONTAINER_ID_LENGTH);
+        db_.saveContainer(name, info);
+        state.registered = true;
+        state.due_ms = 0;
+        CM_LOG_INFO << "[CgroupWatcher] Container started: " << name
+                    << ", CPUs: " << info.cpu_limit
+                    << ", Memory: " << info.memory_limit << "MB"
+                    << ", PIDs limit: " << info.pid_limit << "\n";
+    }
+    return next_due < 0 ? -1 : static_cast<int>(next_due - now_ms);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file container_discovery.cpp
+ * @brief Implements the ContainerDiscovery class for finding containers that are already running.
+ */
+
+#include "container_discovery.hpp"
+#include <cctype>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+#include "logger.hpp"
+#include "json_processing.hpp"
+#include "container_runtime_configuration.hpp"
+
+/**
+ * @brief Constructs a ContainerDiscovery.
+ * @param cfg Monitor configuration.
+ * @param db Reference to the database interface.
+ * @param thread_pool Reference to the resource thread pool.
+ * @param metadata_cache Optional metadata cache consulted before inspecting (may be nullptr).
+ */
+ContainerDiscovery::ContainerDiscovery(const MonitorConfig& cfg, IDatabaseInterface& db, ResourceThreadPool& thread_pool,
+                                       ContainerMetadataCache* metadata_cache)
+    : cfg_(cfg), db_(db), thread_pool_(thread_pool), metadata_cache_(metadata_cache),
+      pathFactory_(createPathFactory(cfg.runtime, cfg.cgroup, cfg.cgroup_root)) {}
+
+/**
+ * @brief Discovers running containers and seeds the registry and thread pool.
+ *
+ * - Scans the cgroup parent directories in parallel.
+ * - Seeds containers with a valid metadata cache entry without querying the runtime.
+ * - Inspects the remaining containers with parallel bulk runtime queries.
+ * - Saves each container to the database, which assigns it to the thread pool.
+ * - Logs the time to full coverage.
+ *
+ * @return Number of containers seeded.
+ */
+size_t ContainerDiscovery::discover() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::set<std::string> ids = scanCgroupTree(pathFactory_->getParentDirs());
+    auto scanned = std::chrono::steady_clock::now();
+
+    std::vector<CachedContainer> cached;
+    std::set<std::string> misses;
+    for (const auto& id : ids) {
+        CachedContainer entry;
+        if (metadata_cache_ && metadata_cache_->lookup(id, entry)) {
+            cached.push_back(std::move(entry));
+        } else {
+            misses.insert(id);
+        }
+    }
+
+    std::vector<ContainerEventInfo> infos = inspectAll(misses);
+    auto inspected = std::chrono::steady_clock::now();
+
+    size_t seeded = 0;
+    for (const auto& entry : cached) {
+        try {
+            // Assign with the cached paths first; the save notification is then a no-op
+            thread_pool_.addContainer(entry.name, entry.info, &entry.paths);
+            db_.saveContainer(entry.name, entry.info);
+            ++seeded;
+        } catch (const std::exception& e) {
+            CM_LOG_WARN << "[Discovery] Skipping cached container " << entry.name << ": " << e.what() << "\n";
+        }
+    }
+    for (const auto& info : infos) {
+        try {
+            ContainerInfo container = toContainerInfo(info);
+            db_.saveContainer(info.name, container);
+            if (metadata_cache_) {
+                metadata_cache_->put(info.name, container, pathFactory_->getPaths(info.id),
+                                     pathFactory_->getCgroupDir(info.id));
+            }
+            ++seeded;
+        } catch (const std::exception& e) {
+            CM_LOG_WARN << "[Discovery] Skipping container " << info.name << ": " << e.what() << "\n";
+        }
+    }
+    auto done = std::chrono::steady_clock::now();
+
+    auto ms = [](auto from, auto to) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+    CM_LOG_INFO << "[Discovery] Seeded " << seeded << " of " << ids.size() << " running containers"
+                << " (" << cached.size() << " from cache)"
+                << " | time to full coverage: " << ms(start, done) << " ms"
+                << " (scan: " << ms(start, scanned) << " ms"
+                << ", inspect: " << ms(scanned, inspected) << " ms"
+                << ", seed: " << ms(inspected, done) << " ms)\n";
+    return seeded;
+}
+
+/**
+ * @brief Lists the container IDs present in all cgroup parent directories.
+ * @param parent_dirs Cgroup parent directories, one per controller hierarchy.
+ * @return Container IDs found in every hierarchy.
+ */
+std::set<std::string> ContainerDiscovery::scanCgroupTree(const std::vector<std::string>& parent_dirs) {
+    std::vector<std::future<std::set<std::string>>> scans;
+    for (const auto& dir : parent_dirs) {
+        scans.push_back(std::async(std::launch::async, &ContainerDiscovery::scanParentDir, dir));
+    }
+
+    std::set<std::string> ids;
+    bool first = true;
+    for (auto& scan : scans) {
+        std::set<std::string> found = scan.get();
+        if (first) {
+            ids = std::move(found);
+            first = false;
+            continue;
+        }
+        // A container is only complete once it exists in every controller hierarchy
+        std::set<std::string> common;
+        std::set_intersection(ids.begin(), ids.end(), found.begin(), found.end(),
+                              std::inserter(common, common.begin()));
+        ids = std::move(common);
+    }
+    return ids;
+}
+
+/**
+ * @brief Lists container ID sub-directories of a single cgroup parent directory.
+ * @param parent_dir Cgroup parent directory.
+ * @return Container IDs found.
+ */
+std::set<std::string> ContainerDiscovery::scanParentDir(const std::string& parent_dir) {
+    std::set<std::string> ids;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(parent_dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_directory(ec)) continue;
+        std::string name = it->path().filename().string();
+        if (isContainerId(name)) ids.insert(std::move(name));
+    }
+    if (ec) {
+        CM_LOG_WARN << "[Discovery] Cannot scan " << parent_dir << ": " << ec.message() << "\n";
+    }
+    return ids;
+}
+
+/**
+ * @brief Checks whether a cgroup directory name is a full container ID.
+ * @param name Directory name.
+ * @return True if the name is a 64 character hex string.
+ */
+bool ContainerDiscovery::isContainerId(const std::string& name) {
+    return name.size() == CONTAINER_ID_LENGTH &&
+           std::all_of(name.begin(), name.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+}
+
+/**
+ * @brief Inspects containers with parallel bulk runtime queries.
+ *
+ * IDs are split into batches of INSPECT_BATCH_SIZE; up to inspect_thread_count
+ * batches are inspected concurrently.
+ *
+ * @param ids Container IDs to inspect.
+ * @return Inspected containers.
+ */
+std::vector<ContainerEventInfo> ContainerDiscovery::inspectAll(const std::set<std::string>& ids) const {
+    std::vector<std::vector<std::string>> batches;
+    for (const auto& id : ids) {
+        if (batches.empty() || batches.back().size() >= INSPECT_BATCH_SIZE) batches.emplace_back();
+        batches.back().push_back(id);
+    }
+
+    std::vector<ContainerEventInfo> infos;
+    size_t parallel = static_cast<size_t>(std::max(1, cfg_.inspect_thread_count));
+    for (size_t first = 0; first < batches.size(); first += parallel) {
+        std::vector<std::future<std::vector<ContainerEventInfo>>> queries;
+        for (size_t i = first; i < std::min(first + parallel, batches.size()); ++i) {
+            queries.push_back(std::async(std::launch::async, [&batch = batches[i]]() {
+                std::vector<ContainerEventInfo> result;
+                if (!inspectContainers(batch, result)) {
+                    CM_LOG_WARN << "[Discovery] Bulk inspect failed for " << batch.size() << " containers\n";
+                }
+                return result;
+            }));
+        }
+        for (auto& query : queries) {
+            for (auto& info : query.get()) infos.push_back(std::move(info));
+        }
+    }
+    return infos;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file container_inspect_pool.cpp
+ * @brief Implements the ContainerInspectPool class for concurrent container inspection.
+ */
+
+#include "container_inspect_pool.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Constructs a ContainerInspectPool.
+ * @param thread_count Number of inspect worker threads.
+ */
+ContainerInspectPool::ContainerInspectPool(int thread_count)
+    : thread_count_(thread_count > 0 ? thread_count : 1) {}
+
+/**
+ * @brief Destructor. Ensures all worker threads are stopped.
+ */
+ContainerInspectPool::~ContainerInspectPool() {
+    stop();
+}
+
+/**
+ * @brief Starts the inspect worker threads.
+ */
+void ContainerInspectPool::start() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) return;
+        running_ = true;
+    }
+    for (int i = 0; i < thread_count_; ++i) {
+        threads_.emplace_back(&ContainerInspectPool::workerLoop, this);
+    }
+    CM_LOG_INFO << "[InspectPool] Started " << thread_count_ << " inspect threads\n";
+}
+
+/**
+ * @brief Stops the inspect worker threads. Pending jobs are abandoned.
+ */
+void ContainerInspectPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+    threads_.clear();
+}
+
+/**
+ * @brief Submits a container event for enrichment.
+ * @param info Parsed container event (typically a "create" event).
+ * @return Future resolving to the enriched event.
+ */
+std::future<ContainerEventInfo> ContainerInspectPool::submit(ContainerEventInfo info) {
+    InspectJob job{std::move(info), {}};
+    auto future = job.result.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            jobs_.push(std::move(job));
+            cv_.notify_one();
+            return future;
+        }
+    }
+    inspect(job.info);
+    job.result.set_value(std::move(job.info));
+    return future;
+}
+
+/**
+ * @brief Runs the runtime inspect for an event if constraints are missing.
+ * @param info Event to enrich in place.
+ */
+void ContainerInspectPool::inspect(ContainerEventInfo& info) {
+    if (!hasResourceConstraints(info) && !getResourceConstraintsFromInspect(info.id, info)) {
+        CM_LOG_WARN << "[InspectPool] Inspect failed for container: " << info.name << "\n";
+    }
+}
+
+/**
+ * @brief Worker thread function. Pops jobs and runs the runtime inspect.
+ */
+void ContainerInspectPool::workerLoop() {
+    while (true) {
+        InspectJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !jobs_.empty() || !running_; });
+            if (!running_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop();
+        }
+        inspect(job.info);
+        job.result.set_value(std::move(job.info));
+    }
+}
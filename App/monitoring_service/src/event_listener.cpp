@@ -7,6 +7,7 @@
 #include "logger.hpp"
 #include <chrono>
 #include <cstdio>
+#include <string>
 
 /**
  * @brief Constructs a RuntimeEventListener.
@@ -42,6 +43,17 @@ void RuntimeEventListener::stop() {
     }
 }
 
+/**
+ * @brief Replays runtime events starting at the given wall-clock time.
+ * @param since_ms Unix timestamp in milliseconds.
+ */
+void RuntimeEventListener::setSince(int64_t since_ms) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%03lld",
+                  static_cast<long long>(since_ms / 1000), static_cast<long long>(since_ms % 1000));
+    since_ = buf;
+}
+
 /**
  * @brief Worker thread function. Executes the event command and pushes events to the queue.
  *
@@ -54,9 +66,9 @@ void RuntimeEventListener::stop() {
 void RuntimeEventListener::eventThreadFunc() {
     std::string runtime_cmd;
     if (config_.runtime == "docker") {
-        runtime_cmd = "docker events --format '{{json .}}' --since 0m";
+        runtime_cmd = "docker events --format '{{json .}}' --since " + since_;
     } else if (config_.runtime == "podman") {
-        runtime_cmd = "podman events --format '{{json .}}' --since 0m";
+        runtime_cmd = "podman events --format '{{json .}}' --since " + since_;
     } else {
         CM_LOG_ERROR << "Unsupported container runtime: " << config_.runtime << "\n";
         return;
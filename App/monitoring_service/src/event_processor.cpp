@@ -1,13 +1,13 @@
 /**
  * @file event_processor.cpp
- * @brief Implements the EventProcessor class for processing container events and host metrics.
+ * @brief Implements the EventProcessor class for processing container events.
  */
 
 #include "event_processor.hpp"
 #include <iostream>
 #include "logger.hpp"
 #include "json_processing.hpp"
-#include "metrics_reader.hpp"
+#include "container_runtime_configuration.hpp"
 
 /**
  * @brief Constructs an EventProcessor.
@@ -15,9 +15,13 @@
  * @param shutdown_flag Reference to the application's shutdown flag.
  * @param db Reference to the database interface.
  * @param cfg Reference to the monitor configuration.
+ * @param metadata_cache Optional metadata cache kept in sync with events (may be nullptr).
  */
-EventProcessor::EventProcessor(EventQueue& queue, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db, const MonitorConfig& cfg)
-    : queue_(queue), shutdown_flag_(shutdown_flag), db_(db), cfg_(cfg) {}
+EventProcessor::EventProcessor(EventQueue& queue, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db, const MonitorConfig& cfg,
+                               ContainerMetadataCache* metadata_cache)
+    : queue_(queue), shutdown_flag_(shutdown_flag), db_(db), cfg_(cfg),
+      inspect_pool_(cfg.inspect_thread_count), metadata_cache_(metadata_cache),
+      pathFactory_(createPathFactory(cfg.runtime, cfg.cgroup, cfg.cgroup_root)) {}
 
 /**
  * @brief Destructor. Ensures the worker thread is stopped.
@@ -29,6 +33,7 @@ EventProcessor::~EventProcessor() { stop(); }
  */
 void EventProcessor::start() {
     running_ = true;
+    inspect_pool_.start();
     worker_ = std::thread(&EventProcessor::processLoop, this);
 }
 
@@ -39,62 +44,91 @@ void EventProcessor::stop() {
     running_ = false;
     queue_.shutdown();
     if (worker_.joinable()) worker_.join();
+    inspect_pool_.stop();
 }
 
 /**
- * @brief Worker thread function. Processes events and collects host metrics.
+ * @brief Worker thread function. Processes container events.
  *
- * - Periodically collects host CPU and memory usage and saves to the database.
- * - Pops container events from the event queue, parses them, and updates the database.
- * - Handles container creation and destruction events.
+ * - Pops container events from the event queue, parses them, and queues them in order.
+ * - Applies enriched container creation and destruction events in event order.
  * - Handles shutdown and cleans up resources.
  */
 void EventProcessor::processLoop() {
     std::string event;
     int refresh_interval = cfg_.container_event_refresh_interval_ms;
-    MetricsReader metrics_reader({}, 0);
-    HostInfo host_info = metrics_reader.getHostInfo();
-    CM_LOG_INFO << "[Host Info] CPUs: " << host_info.num_cpus
-                << ", Total Memory: " << host_info.total_memory_mb << " MB\n";
-    // db_.saveHostInfo(host_info);
 
     while (running_ && !shutdown_flag_) {
-        // Host usage collection
-        auto now = std::chrono::system_clock::now();
-        auto timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-    
-        double cpu_usage_percentage = metrics_reader.getHostCpuUsagePercentage();
-        double mem_usage_percentage = metrics_reader.getHostMemoryUsagePercent();
-        db_.saveHostUsage(timestamp_ms, cpu_usage_percentage, mem_usage_percentage);
-
-        if ((queue_.pop(event, refresh_interval))) {
-            try {
-                ContainerEventInfo info;
-                if (parseContainerEvent(event, info)) {
-                    CM_LOG_INFO << "[Container Event] "
-                                << "Name: " << info.name
-                                << ", ID: " << info.id
-                                << ", Status: " << info.status
-                                << ", Time (ns): " << info.timeNano;
-                    if (info.status == "create") {
-                        CM_LOG_INFO << ", CPUs: " << info.cpus
-                                    << ", Memory: " << info.memory
-                                    << ", PIDs limit: " << info.pids_limit;
-                        double cpus = std::stod(info.cpus);
-                        int memory = std::stoi(info.memory);
-                        int pids_limit = std::stoi(info.pids_limit);
-                        db_.saveContainer(info.name, ContainerInfo{info.id, cpus, memory, pids_limit});
-                    } else if (info.status == "destroy") {
-                        db_.removeContainer(info.name);
-                        CM_LOG_INFO << " [Container Removed]";
-                    }
-                    CM_LOG_INFO << "\n";
-                }
-            } catch (const std::exception& e) {
-                CM_LOG_ERROR << "Event processing error: " << e.what() << "\n";
-            } catch (...) {
-                CM_LOG_ERROR << "Unknown error during event processing. \n";
+        // Poll quickly while inspections are in flight so results are applied promptly
+        int timeout_ms = pending_events_.empty() ? refresh_interval : SLEEP_MS_SHORT;
+        if (queue_.pop(event, timeout_ms)) {
+            ContainerEventInfo info;
+            if (parseContainerEvent(event, info)) {
+                enqueueEvent(std::move(info));
             }
-        }        
+        }
+        applyReadyEvents();
+    }
+}
+
+/**
+ * @brief Queues a parsed event behind all earlier events, submitting creates for inspection.
+ * @param info Parsed container event.
+ */
+void EventProcessor::enqueueEvent(ContainerEventInfo info) {
+    if (info.status == "create" && !hasResourceConstraints(info)) {
+        pending_events_.push_back(inspect_pool_.submit(std::move(info)));
+        return;
+    }
+    std::promise<ContainerEventInfo> ready;
+    ready.set_value(std::move(info));
+    pending_events_.push_back(ready.get_future());
+}
+
+/**
+ * @brief Applies all leading pending events whose enrichment has completed.
+ *
+ * Stops at the first event still being inspected, so later events (including a
+ * destroy of the same container) wait until everything before them is applied.
+ */
+void EventProcessor::applyReadyEvents() {
+    while (!pending_events_.empty()) {
+        auto& front = pending_events_.front();
+        if (front.wait_for(std::chrono::seconds(0)) != std::future_status::ready) break;
+        try {
+            applyEvent(front.get());
+        } catch (const std::exception& e) {
+            CM_LOG_ERROR << "Event processing error: " << e.what() << "\n";
+        } catch (...) {
+            CM_LOG_ERROR << "Unknown error during event processing. \n";
+        }
+        pending_events_.pop_front();
+    }
+}
+
+/**
+ * @brief Applies a single container event to the database and the metadata cache.
+ * @param info Enriched container event.
+ */
+void EventProcessor::applyEvent(const ContainerEventInfo& info) {
+    CM_LOG_INFO << "[Container Event] "
+                << "Name: " << info.name
+                << ", ID: " << info.id
+                << ", Status: " << info.status
+                << ", Time (ns): " << info.timeNano;
+    if (info.status == "create") {
+        CM_LOG_INFO << ", CPUs: " << info.cpus
+                    << ", Memory: " << info.memory
+                    << ", PIDs limit: " << info.pids_limit;
+        ContainerInfo container = toContainerInfo(info);
+        db_.saveContainer(info.name, container);
+        if (metadata_cache_) {
+            metadata_cache_->put(info.name, container, pathFactory_->getPaths(info.id), pathFactory_->getCgroupDir(info.id));
+        }
+    } else if (info.status == "destroy") {
+        db_.removeContainer(info.name);
+        if (metadata_cache_) metadata_cache_->erase(info.id);
+        CM_LOG_INFO << " [Container Removed]";
     }
+    CM_LOG_INFO << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file host_metrics_sampler.cpp
+ * @brief Implements the HostMetricsSampler class for periodic host resource sampling.
+ */
+
+#include "host_metrics_sampler.hpp"
+#include <chrono>
+#include <algorithm>
+#include "logger.hpp"
+#include "metrics_reader.hpp"
+
+/**
+ * @brief Constructs a HostMetricsSampler.
+ * @param cfg Monitor configuration (uses host_sampling_interval_ms and batch_size).
+ * @param db Reference to the database interface.
+ * @param shutdown_flag Reference to the application's shutdown flag.
+ */
+HostMetricsSampler::HostMetricsSampler(const MonitorConfig& cfg, IDatabaseInterface& db, std::atomic<bool>& shutdown_flag)
+    : cfg_(cfg), db_(db), shutdown_flag_(shutdown_flag) {}
+
+/**
+ * @brief Destructor. Ensures the sampler thread is stopped.
+ */
+HostMetricsSampler::~HostMetricsSampler() {
+    stop();
+}
+
+/**
+ * @brief Starts the sampler thread.
+ */
+void HostMetricsSampler::start() {
+    running_ = true;
+    worker_ = std::thread(&HostMetricsSampler::sampleLoop, this);
+}
+
+/**
+ * @brief Stops the sampler thread and flushes buffered samples.
+ */
+void HostMetricsSampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+/**
+ * @brief Worker thread function. Samples host usage on a fixed schedule.
+ *
+ * - Logs host information once.
+ * - Samples host CPU (total and per core) and memory usage every host_sampling_interval_ms.
+ * - Inserts samples into the database once batch_size have accumulated.
+ * - Flushes the remaining samples on shutdown.
+ */
+void HostMetricsSampler::sampleLoop() {
+    MetricsReader metrics_reader({}, 0);
+    HostInfo host_info = metrics_reader.getHostInfo();
+    CM_LOG_INFO << "[Host Info] CPUs: " << host_info.num_cpus
+                << ", Total Memory: " << host_info.total_memory_mb << " MB\n";
+
+    size_t batch_size = static_cast<size_t>(std::max(1, cfg_.batch_size));
+    buffer_.reserve(batch_size);
+    auto interval = std::chrono::milliseconds(cfg_.host_sampling_interval_ms);
+    auto next_sample = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_ && !shutdown_flag_) {
+        HostUsage usage;
+        usage.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        usage.cpu_usage_percent = metrics_reader.getHostCpuUsagePercentage();
+        usage.memory_usage_percent = metrics_reader.getHostMemoryUsagePercent();
+        usage.core_usage_percent = metrics_reader.getHostCoreUsagePercentages();
+        buffer_.push_back(usage);
+        if (buffer_.size() >= batch_size) flush();
+
+        // Fixed-rate schedule; skip missed slots instead of sampling in a burst
+        next_sample += interval;
+        auto now = std::chrono::steady_clock::now();
+        if (next_sample < now) next_sample = now;
+        cv_.wait_until(lock, next_sample, [this]() { return !running_; });
+    }
+    flush();
+}
+
+/**
+ * @brief Inserts buffered samples into the database.
+ */
+void HostMetricsSampler::flush() {
+    if (buffer_.empty()) return;
+    db_.insertHostBatch(buffer_);
+    buffer_.clear();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file memory_event_monitor.cpp
+ * @brief Implements the MemoryEventMonitor class for kernel-notified container memory events.
+ */
+
+#include "memory_event_monitor.hpp"
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "logger.hpp"
+#include "container_runtime_configuration.hpp"
+
+/**
+ * @brief Constructs a MemoryEventMonitor.
+ * @param cfg Monitor configuration (uses alert_warning, alert_critical and cgroup settings).
+ * @param shutdown_flag Reference to the application's shutdown flag.
+ */
+MemoryEventMonitor::MemoryEventMonitor(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag)
+    : CgroupEventObserver("[MemoryEvents]", shutdown_flag), cfg_(cfg),
+      pathFactory_(createPathFactory(cfg.runtime, cfg.cgroup, cfg.cgroup_root)) {}
+
+/**
+ * @brief Destructor. Stops the event loop and releases all registrations.
+ */
+MemoryEventMonitor::~MemoryEventMonitor() {
+    stop();
+}
+
+/**
+ * @brief Starts the event loop thread (no-op if the cgroup version has no cgroup.event_control).
+ */
+void MemoryEventMonitor::start() {
+    if (pathFactory_->getMemoryEventPaths("").event_control_path.empty()) {
+        CM_LOG_INFO << "[MemoryEvents] Cgroup " << cfg_.cgroup << " has no cgroup.event_control, notifications disabled\n";
+        return;
+    }
+    startLoop();
+}
+
+/**
+ * @brief Registers threshold and OOM notifications for a container.
+ * @param name Container name.
+ * @param info ContainerInfo struct.
+ * @return True if at least one notification was registered.
+ */
+bool MemoryEventMonitor::arm(const std::string& name, const ContainerInfo& info) {
+    ContainerMemoryEventPaths paths = pathFactory_->getMemoryEventPaths(info.id);
+    if (paths.event_control_path.empty()) return false;
+
+    int control_fd = open(paths.event_control_path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (control_fd < 0) return false;
+    ArmedContainer container;
+    container.memory_limit = info.memory_limit;
+    container.usage_fd = open(paths.usage_path.c_str(), O_RDONLY | O_CLOEXEC);
+    container.oom_fd = open(paths.oom_control_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (container.usage_fd >= 0 && container.memory_limit > 0) {
+        uint64_t limit_bytes = static_cast<uint64_t>(container.memory_limit) * BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE;
+        uint64_t warning = static_cast<uint64_t>(limit_bytes * cfg_.alert_warning / PERCENT_FACTOR);
+        uint64_t critical = static_cast<uint64_t>(limit_bytes * cfg_.alert_critical / PERCENT_FACTOR);
+        registerEvent(control_fd, container.usage_fd, std::to_string(warning), {name, EventKind::Warning, warning}, container);
+        registerEvent(control_fd, container.usage_fd, std::to_string(critical), {name, EventKind::Critical, critical}, container);
+    }
+    if (container.oom_fd >= 0) {
+        registerEvent(control_fd, container.oom_fd, "", {name, EventKind::Oom, 0}, container);
+    }
+    close(control_fd);
+
+    if (container.event_fds.empty()) {
+        release(container);
+        return false;
+    }
+    CM_LOG_INFO << "[MemoryEvents] Armed " << container.event_fds.size()
+                << " memory notifications for container " << name << "\n";
+    armed_[name] = std::move(container);
+    return true;
+}
+
+/**
+ * @brief Registers one eventfd through cgroup.event_control.
+ * @param control_fd Open cgroup.event_control descriptor.
+ * @param target_fd Descriptor of the file the notification refers to.
+ * @param args Extra arguments (threshold), empty for OOM.
+ * @param registration Registration to record.
+ * @param container Container state receiving the eventfd.
+ * @return True on success.
+ */
+bool MemoryEventMonitor::registerEvent(int control_fd, int target_fd, const std::string& args,
+                                       Registration registration, ArmedContainer& container) {
+    int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) return false;
+
+    // "<event_fd> <target_fd> [args]" registers the notification with the kernel
+    std::string line = std::to_string(event_fd) + " " + std::to_string(target_fd);
+    if (!args.empty()) line += " " + args;
+    if (write(control_fd, line.c_str(), line.size()) < 0 || !addDescriptor(event_fd, EPOLLIN)) {
+        CM_LOG_WARN << "[MemoryEvents] Failed to register notification for " << registration.name
+                    << ": " << strerror(errno) << "\n";
+        close(event_fd);
+        return false;
+    }
+    registrations_[event_fd] = std::move(registration);
+    container.event_fds.push_back(event_fd);
+    return true;
+}
+
+/**
+ * @brief Releases all notifications of a container.
+ * @param name Container name.
+ */
+void MemoryEventMonitor::disarm(const std::string& name) {
+    auto it = armed_.find(name);
+    if (it == armed_.end()) return;
+    release(it->second);
+    armed_.erase(it);
+}
+
+/**
+ * @brief Closes a container's files and eventfds.
+ *
+ * Closing an eventfd makes the kernel drop its registration.
+ *
+ * @param container Container state.
+ */
+void MemoryEventMonitor::release(ArmedContainer& container) {
+    for (int event_fd : container.event_fds) {
+        removeDescriptor(event_fd);
+        registrations_.erase(event_fd);
+        close(event_fd);
+    }
+    container.event_fds.clear();
+    if (container.usage_fd >= 0) close(container.usage_fd);
+    if (container.oom_fd >= 0) close(container.oom_fd);
+    container.usage_fd = container.oom_fd = -1;
+}
+
+/**
+ * @brief Reads a signalled eventfd and reports the event.
+ *
+ * Threshold eventfds fire on crossings in both directions, so the current usage is
+ * read to tell whether the container went above or below. A failed usage read means
+ * the cgroup was removed (the kernel signals all eventfds then); the container is
+ * disarmed and re-armed if it starts again.
+ *
+ * @param event_fd The signalled eventfd.
+ * @param events epoll event mask (unused; eventfds only signal EPOLLIN).
+ */
+void MemoryEventMonitor::handleEvent(int event_fd, uint32_t /*events*/) {
+    uint64_t count = 0;
+    if (read(event_fd, &count, sizeof(count)) != sizeof(count)) return;
+    auto reg_it = registrations_.find(event_fd);
+    if (reg_it == registrations_.end()) return;
+    const Registration& registration = reg_it->second;
+    auto it = armed_.find(registration.name);
+    if (it == armed_.end()) return;
+    const ArmedContainer& container = it->second;
+
+    char buf[32];
+    ssize_t len = container.usage_fd >= 0 ? pread(container.usage_fd, buf, sizeof(buf) - 1, 0) : -1;
+    if (len <= 0) {
+        CM_LOG_INFO << "[MemoryEvents] Cgroup of container " << registration.name << " removed, notifications released\n";
+        rearmLater(registration.name);
+        return;
+    }
+    buf[len] = '\0';
+    uint64_t usage_bytes = std::strtoull(buf, nullptr, 10);
+    uint64_t usage_mb = usage_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE);
+
+    if (registration.kind == EventKind::Oom) {
+        CM_LOG_WARN << "[MemoryEvents] OOM event in container " << registration.name
+                    << " (usage: " << usage_mb << " MB, limit: " << container.memory_limit << " MB)\n";
+        return;
+    }
+    // Compared in bytes: within the same MB, truncated values would report a drop as a rise
+    bool above = usage_bytes >= registration.threshold_bytes;
+    uint64_t threshold_mb = registration.threshold_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE);
+    const char* level = (registration.kind == EventKind::Critical) ? "critical" : "warning";
+    if (above) {
+        CM_LOG_WARN << "[MemoryEvents] Container " << registration.name << " crossed above " << level
+                    << " memory threshold: " << usage_mb << " MB >= " << threshold_mb << " MB\n";
+    } else {
+        CM_LOG_INFO << "[MemoryEvents] Container " << registration.name << " dropped below " << level
+                    << " memory threshold: " << usage_mb << " MB < " << threshold_mb << " MB\n";
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * @file pressure_monitor.cpp
+ * @brief Implements the PressureMonitor class for cgroup v2 pressure stall (PSI) triggers.
+ */
+
+#include "pressure_monitor.hpp"
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include "logger.hpp"
+#include "container_runtime_configuration.hpp"
+
+/**
+ * @brief Constructs a PressureMonitor.
+ * @param cfg Monitor configuration (uses the psi_* settings and cgroup settings).
+ * @param db Database to record pressure samples in.
+ * @param thread_pool Thread pool whose sampling is raised on pressure.
+ * @param shutdown_flag Reference to the application's shutdown flag.
+ */
+PressureMonitor::PressureMonitor(const MonitorConfig& cfg, IDatabaseInterface& db, ResourceThreadPool& thread_pool,
+                                 std::atomic<bool>& shutdown_flag)
+    : CgroupEventObserver("[Pressure]", shutdown_flag), cfg_(cfg), db_(db), thread_pool_(thread_pool),
+      pathFactory_(createPathFactory(cfg.runtime, cfg.cgroup, cfg.cgroup_root)),
+      trigger_(std::string(PSI_TRIGGER_TYPE) + " " + std::to_string(cfg.psi_stall_threshold_us) + " " +
+               std::to_string(cfg.psi_window_us)) {}
+
+/**
+ * @brief Destructor. Stops the event loop and releases all triggers.
+ */
+PressureMonitor::~PressureMonitor() {
+    stop();
+}
+
+/**
+ * @brief Starts the event loop thread (no-op if the cgroup version has no PSI files).
+ */
+void PressureMonitor::start() {
+    if (pathFactory_->getPressurePaths("").cpu_pressure_path.empty()) {
+        CM_LOG_INFO << "[Pressure] Cgroup " << cfg_.cgroup << " has no per-container PSI files, triggers disabled\n";
+        return;
+    }
+    if (!startLoop()) return;
+    CM_LOG_INFO << "[Pressure] Registering trigger \"" << trigger_ << "\" per container\n";
+}
+
+/**
+ * @brief Parses the content of a pressure file.
+ * @param content Pressure file content ("some avg10=... total=...\nfull avg10=...").
+ * @param sample PressureSample whose some_avg10, full_avg10 and some_total_us are filled in.
+ * @return True if the some line could be parsed.
+ */
+bool PressureMonitor::parsePressure(const char* content, PressureSample& sample) {
+    unsigned long long total = 0;
+    if (std::strncmp(content, PSI_SOME_PREFIX, std::strlen(PSI_SOME_PREFIX)) != 0 ||
+        std::sscanf(content, "some avg10=%lf avg60=%*f avg300=%*f total=%llu", &sample.some_avg10, &total) != 2) {
+        return false;
+    }
+    sample.some_total_us = total;
+
+    // The full line is missing for cpu.pressure on older kernels
+    sample.full_avg10 = 0.0;
+    const char* full = std::strstr(content, PSI_FULL_PREFIX);
+    if (full) std::sscanf(full, "full avg10=%lf", &sample.full_avg10);
+    return true;
+}
+
+/**
+ * @brief Registers cpu, memory and io triggers for a container.
+ * @param name Container name.
+ * @param info ContainerInfo struct.
+ * @return True if at least one trigger was registered.
+ */
+bool PressureMonitor::arm(const std::string& name, const ContainerInfo& info) {
+    ContainerPressurePaths paths = pathFactory_->getPressurePaths(info.id);
+    std::vector<int> trigger_fds;
+    registerTrigger(name, "cpu", paths.cpu_pressure_path, trigger_fds);
+    registerTrigger(name, "memory", paths.memory_pressure_path, trigger_fds);
+    registerTrigger(name, "io", paths.io_pressure_path, trigger_fds);
+    if (trigger_fds.empty()) return false;
+    CM_LOG_INFO << "[Pressure] Armed " << trigger_fds.size() << " pressure triggers for container " << name << "\n";
+    trigger_fds_[name] = std::move(trigger_fds);
+    return true;
+}
+
+/**
+ * @brief Registers a trigger on one pressure file.
+ * @param name Container name.
+ * @param resource Resource name.
+ * @param path Pressure file path.
+ * @param trigger_fds Container's trigger descriptors, receiving the new one.
+ * @return True on success.
+ */
+bool PressureMonitor::registerTrigger(const std::string& name, const char* resource, const std::string& path,
+                                      std::vector<int>& trigger_fds) {
+    if (path.empty()) return false;
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // The trigger stays active as long as the descriptor is open; the kernel signals POLLPRI
+    if (write(fd, trigger_.c_str(), trigger_.size() + 1) < 0 || !addDescriptor(fd, EPOLLPRI)) {
+        CM_LOG_WARN << "[Pressure] Failed to register " << resource << " trigger for " << name
+                    << ": " << strerror(errno) << "\n";
+        close(fd);
+        return false;
+    }
+    triggers_[fd] = {name, resource};
+    trigger_fds.push_back(fd);
+    return true;
+}
+
+/**
+ * @brief Releases all triggers of a container.
+ * @param name Container name.
+ */
+void PressureMonitor::disarm(const std::string& name) {
+    auto it = trigger_fds_.find(name);
+    if (it == trigger_fds_.end()) return;
+    for (int fd : it->second) {
+        removeDescriptor(fd);
+        triggers_.erase(fd);
+        close(fd);
+    }
+    trigger_fds_.erase(it);
+}
+
+/**
+ * @brief Handles a fired or failed trigger descriptor.
+ *
+ * EPOLLERR means the cgroup was removed; the container's triggers are released and
+ * re-armed if it starts again.
+ *
+ * @param fd Trigger descriptor.
+ * @param events epoll event mask.
+ */
+void PressureMonitor::handleEvent(int fd, uint32_t events) {
+    auto trigger_it = triggers_.find(fd);
+    if (trigger_it == triggers_.end()) return;
+    const Trigger trigger = trigger_it->second;
+
+    if (events & EPOLLERR) {
+        CM_LOG_INFO << "[Pressure] Cgroup of container " << trigger.name << " removed, triggers released\n";
+        rearmLater(trigger.name);
+        return;
+    }
+
+    PressureSample sample;
+    char buf[PSI_BUF_SIZE];
+    ssize_t len = pread(fd, buf, sizeof(buf) - 1, 0);
+    buf[len > 0 ? len : 0] = '\0';
+    sample.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    sample.container_name = trigger.name;
+    sample.resource = trigger.resource;
+    if (!parsePressure(buf, sample)) return;
+
+    CM_LOG_WARN << "[Pressure] " << trigger.resource << " pressure in container " << trigger.name
+                << ": some avg10=" << sample.some_avg10 << "%, full avg10=" << sample.full_avg10 << "%\n";
+    db_.savePressureSample(sample);
+    thread_pool_.boostSampling(trigger.name, cfg_.psi_boost_duration_ms);
+}
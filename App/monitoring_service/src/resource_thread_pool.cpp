@@ -7,16 +7,18 @@
 #include <map>
 #include <cmath> 
 #include <mutex>
+#include <deque>
 #include <vector>
+#include <sstream>
 #include <chrono>
 #include <cstring>
-#include <mqueue.h>
+#include <sys/stat.h>
 #include <algorithm>
 #include <unordered_map>
 #include "common.hpp"
 #include "logger.hpp"
 #include "metrics_reader.hpp"
-#include "docker_cgroup_v1_path.hpp"
+#include "container_runtime_configuration.hpp"
 
 std::mutex cout_mutex;
 
@@ -25,14 +27,29 @@ std::mutex cout_mutex;
  * @param cfg Monitor configuration.
  * @param shutdown_flag Reference to the application's shutdown flag.
  * @param db Reference to the database interface.
+ * @param alert_channel Channel receiving alerts, or nullptr to disable alerting.
  */
-ResourceThreadPool::ResourceThreadPool(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db)
+ResourceThreadPool::ResourceThreadPool(const MonitorConfig& cfg, std::atomic<bool>& shutdown_flag, IDatabaseInterface& db,
+                                       AlertChannel* alert_channel)
     : cfg_(cfg), shutdown_flag_(shutdown_flag), db_(db), thread_containers_(cfg.thread_count),
-      thread_buffers_(cfg.thread_count), thread_local_paths_(cfg.thread_count), thread_local_info_(cfg.thread_count)
+      thread_buffers_(cfg.thread_count), thread_local_state_(cfg.thread_count), retired_(cfg.thread_count),
+      alert_engine_(cfg), alert_channel_(alert_channel)
 {
     // Initialize the factory once
-    if (cfg_.runtime == "docker" && cfg_.cgroup == "v1") {
-        pathFactory_ = std::make_unique<DockerCgroupV1PathFactory>();
+    pathFactory_ = createPathFactory(cfg_.runtime, cfg_.cgroup, cfg_.cgroup_root);
+
+    // Every worker owns its top-consumer summaries; a container recreated on another worker has
+    // counters in both, which topConsumers() combines
+    size_t counters = static_cast<size_t>(std::max(cfg_.heavy_hitter_top_k, 1)) * HEAVY_HITTER_COUNTERS_PER_K;
+    for (int i = 0; i < cfg_.thread_count; ++i) {
+        consumers_.push_back(std::make_unique<ConsumerSummaries>(counters));
+    }
+
+    // A removed container keeps its UI slot until its worker drops the last reference,
+    // so the table holds twice as many slots as the pool can monitor
+    if (cfg_.ui_enabled) {
+        size_t capacity = static_cast<size_t>(cfg_.thread_count) * cfg_.thread_capacity;
+        metrics_table_ = MetricsTable::create(METRICS_TABLE_NAME, capacity * 2);
     }
 }
 
@@ -57,21 +74,27 @@ void ResourceThreadPool::start() {
  * @brief Stops all worker threads and flushes buffers.
  */
 void ResourceThreadPool::stop() {
-    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(assign_mutex_);
+        running_ = false;
+    }
     cv_.notify_all();
-    flushAllBuffers();
     for (auto& t : threads_) {
         if (t.joinable()) t.join();
     }
+    // Buffers are owned by the workers while they run
+    flushAllBuffers();
 }
 
 /**
  * @brief Adds a container to the thread pool for monitoring.
  * @param name Container name.
+ * @param info ContainerInfo struct.
+ * @param paths Previously resolved resource paths, or nullptr to resolve them from the container ID.
  */
-void ResourceThreadPool::addContainer(const std::string& name) {
+void ResourceThreadPool::addContainer(const std::string& name, const ContainerInfo& info, const ContainerResourcePaths* paths) {
     std::unique_lock<std::mutex> lock(assign_mutex_);
-    flushAllBuffers();
+    if (container_to_thread_.count(name)) return; // Already monitored (e.g. seeded at startup)
     int min_thread = -1, min_load = cfg_.thread_capacity + 1;
     for (int i = 0; i < cfg_.thread_count; ++i) {
         if (thread_containers_[i].size() < cfg_.thread_capacity && thread_containers_[i].size() < min_load) {
@@ -86,18 +109,28 @@ void ResourceThreadPool::addContainer(const std::string& name) {
     thread_containers_[min_thread].push_back(name);
     container_to_thread_[name] = min_thread;
 
-    // Fetch full container info from database
-    ContainerInfo info = db_.getContainer(name);
-    thread_local_info_[min_thread][name] = info;
-    ContainerResourcePaths paths = pathFactory_->getPaths(info.id);
-    thread_local_paths_[min_thread][name] = paths;
-
-    CM_LOG_INFO << "[ThreadPool] Paths for container " << name << ":\n"
-                << "  CPU: " << paths.cpu_path << "\n"
-                << "  Memory: " << paths.memory_path << "\n"
-                << "  PIDs: " << paths.pids_path << "\n";
-    
+    // Paths are resolved once the cgroup exists
+    auto container = std::make_shared<MonitoredContainer>();
+    container->info = info;
+    container->cpu_window = SlidingWindowExtrema(cfg_.ui_window_ms);
+    container->memory_window = SlidingWindowExtrema(cfg_.ui_window_ms);
+    container->pids_window = SlidingWindowExtrema(cfg_.ui_window_ms);
+    container->peak_window = SlidingWindowExtrema(cfg_.ui_window_ms);
+    container->alert_state = alert_engine_.makeState();
+    container->anomaly = AnomalyDetector(cfg_.anomaly_sigma);
+    if (paths) {
+        container->paths = *paths;
+        container->paths_resolved = true;
+    }
+    if (metrics_table_) {
+        container->table = metrics_table_.get();
+        container->table_slot = metrics_table_->claim();
+        if (container->table_slot < 0) CM_LOG_WARN << "[ThreadPool] Metrics table full, container " << name << " not shown in UI\n";
+    }
+    thread_local_state_[min_thread][name] = container;
+
     CM_LOG_INFO << "[ThreadPool] Assigned container " << name << " to thread " << min_thread << "\n";
+    ++wake_generation_;
     cv_.notify_all();
 }
 
@@ -107,22 +140,66 @@ void ResourceThreadPool::addContainer(const std::string& name) {
  */
 void ResourceThreadPool::removeContainer(const std::string& name) {
     std::unique_lock<std::mutex> lock(assign_mutex_);
-    flushAllBuffers();
     auto it = container_to_thread_.find(name);
     if (it != container_to_thread_.end()) {
         int thread_idx = it->second;
         auto& vec = thread_containers_[thread_idx];
         vec.erase(std::remove(vec.begin(), vec.end(), name), vec.end());
         container_to_thread_.erase(it);
-        thread_local_info_[thread_idx].erase(name);
-        thread_local_paths_[thread_idx].erase(name);
+        // The worker stores the open percentile windows before dropping the state
+        auto state = thread_local_state_[thread_idx].find(name);
+        if (state != thread_local_state_[thread_idx].end()) {
+            retired_[thread_idx].emplace_back(name, state->second);
+            thread_local_state_[thread_idx].erase(state);
+        }
         CM_LOG_INFO << "[ThreadPool] Removed container " << name << " from thread " << thread_idx << "\n";
+        // Wake the worker now, so the windows are stored, the UI slot is released and alerts clear without delay
+        ++wake_generation_;
         cv_.notify_all();
     }
 }
 
+/**
+ * @brief Starts monitoring a container saved to the database.
+ * @param name Container name.
+ * @param info ContainerInfo struct.
+ */
+void ResourceThreadPool::onContainerAdded(const std::string& name, const ContainerInfo& info) {
+    addContainer(name, info);
+}
+
+/**
+ * @brief Stops monitoring a container removed from the database.
+ * @param name Container name.
+ */
+void ResourceThreadPool::onContainerRemoved(const std::string& name) {
+    removeContainer(name);
+}
+
+/**
+ * @brief Temporarily raises the sampling rate of a container.
+ * @param name Container name.
+ * @param duration_ms How long the raised rate lasts.
+ */
+void ResourceThreadPool::boostSampling(const std::string& name, int duration_ms) {
+    std::unique_lock<std::mutex> lock(assign_mutex_);
+    auto it = container_to_thread_.find(name);
+    if (it == container_to_thread_.end()) return;
+    auto state = thread_local_state_[it->second].find(name);
+    if (state == thread_local_state_[it->second].end()) return;
+
+    int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    state->second->boost_until_ms = now_ms + duration_ms;
+    ++wake_generation_;
+    cv_.notify_all();
+}
+
 /**
  * @brief Flushes all metric buffers to the database.
+ *
+ * Only called once the workers have stopped; while running, each worker flushes
+ * its own buffers by size and age (including those of removed containers).
  */
 void ResourceThreadPool::flushAllBuffers() {
     for (int i = 0; i < cfg_.thread_count; ++i) {
@@ -147,87 +224,428 @@ std::map<int, std::vector<std::string>> ResourceThreadPool::getAssignments() {
     return result;
 }
 
+/**
+ * @brief Returns the top CPU and memory consumers.
+ *
+ * A container that was destroyed and recreated may have been placed on another worker,
+ * so its weight can be split across summaries; entries are summed by name (weight and
+ * error bound) before ranking. Weights are sums of usage x milliseconds with exponential
+ * decay; dividing by the mean decay time (half-life / ln 2) turns them into average usage.
+ *
+ * @param k Maximum number of consumers per resource.
+ * @param now_ms Current time in milliseconds.
+ * @param cpu Receives the top consumers by average CPU cores.
+ * @param memory Receives the top consumers by average memory in MB.
+ */
+void ResourceThreadPool::topConsumers(size_t k, int64_t now_ms, std::vector<HeavyHitter>& cpu, std::vector<HeavyHitter>& memory) const {
+    // Every tracked counter is merged, not just each worker's top k, so a split weight still adds up
+    std::unordered_map<std::string, HeavyHitter> cpu_by_name, memory_by_name;
+    auto merge = [](std::unordered_map<std::string, HeavyHitter>& by_name, const std::vector<HeavyHitter>& entries) {
+        for (const auto& entry : entries) {
+            auto [it, inserted] = by_name.try_emplace(entry.name, entry);
+            if (!inserted) {
+                it->second.weight += entry.weight;
+                it->second.error += entry.error;
+            }
+        }
+    };
+    for (const auto& summaries : consumers_) {
+        std::lock_guard<std::mutex> lock(summaries->mutex);
+        merge(cpu_by_name, summaries->cpu.top(summaries->cpu.size(), now_ms));
+        merge(memory_by_name, summaries->memory.top(summaries->memory.size(), now_ms));
+    }
+    cpu.clear();
+    memory.clear();
+    for (auto& [name, entry] : cpu_by_name) cpu.push_back(std::move(entry));
+    for (auto& [name, entry] : memory_by_name) memory.push_back(std::move(entry));
+
+    double mean_decay_ms = HEAVY_HITTER_HALF_LIFE_MS / std::log(2.0);
+    for (auto* list : {&cpu, &memory}) {
+        std::sort(list->begin(), list->end(), [](const HeavyHitter& a, const HeavyHitter& b) { return a.weight > b.weight; });
+        if (list->size() > k) list->resize(k);
+        for (auto& entry : *list) {
+            entry.weight /= mean_decay_ms;
+            entry.error /= mean_decay_ms;
+        }
+    }
+}
+
+/**
+ * @brief Logs the top CPU and memory consumers.
+ * @param k Maximum number of consumers per resource.
+ * @param now_ms Current time in milliseconds.
+ */
+void ResourceThreadPool::logTopConsumers(size_t k, int64_t now_ms) const {
+    std::vector<HeavyHitter> cpu, memory;
+    topConsumers(k, now_ms, cpu, memory);
+    if (cpu.empty() && memory.empty()) return;
+    std::ostringstream line;
+    line << "[ThreadPool] Top CPU consumers (avg cores):";
+    for (const auto& entry : cpu) line << " " << entry.name << "=" << entry.weight;
+    line << " | top memory consumers (avg MB):";
+    for (const auto& entry : memory) line << " " << entry.name << "=" << entry.weight;
+    CM_LOG_INFO << line.str() << "\n";
+}
+
+/**
+ * @brief Checks whether a non-running container's cgroup exists and resolves its paths.
+ * @param name Container name.
+ * @param container Container state.
+ * @param now_ms Current time in milliseconds.
+ * @return True if the container is now running, false otherwise.
+ */
+bool ResourceThreadPool::probeContainer(const std::string& name, MonitoredContainer& container, int64_t now_ms) {
+    struct stat st;
+    if (stat(pathFactory_->getCgroupDir(container.info.id).c_str(), &st) != 0) {
+        // Negative cache: back off exponentially until the cgroup shows up
+        container.probe_backoff_ms = container.probe_backoff_ms == 0
+            ? CGROUP_PROBE_INITIAL_MS : std::min(container.probe_backoff_ms * 2, CGROUP_PROBE_MAX_MS);
+        container.next_probe_ms = now_ms + container.probe_backoff_ms;
+        return false;
+    }
+
+    if (!container.paths_resolved) {
+        container.paths = pathFactory_->getPaths(container.info.id);
+        container.paths_resolved = true;
+        CM_LOG_INFO << "[ThreadPool] Paths for container " << name << ":\n"
+                    << "  CPU: " << container.paths.cpu_path << "\n"
+                    << "  Memory: " << container.paths.memory_path << "\n"
+                    << "  PIDs: " << container.paths.pids_path << "\n";
+    }
+    container.state = ContainerState::Running;
+    container.probe_backoff_ms = 0;
+    container.has_prev_cpu = false;
+    container.last_sample_ms = 0;
+    container.interval_ms = 0;
+    container.has_prev_metrics = false;
+    container.has_recorded = false;
+    container.cpu_window.clear();
+    container.memory_window.clear();
+    container.pids_window.clear();
+    container.peak_window.clear();
+    container.alert_state.has_prev = false;
+    container.memory_forecast.clear();
+    container.pids_forecast.clear();
+    container.anomaly.clear();
+
+    // Start the first peak reading now rather than at the container's start
+    uint64_t peak_bytes = 0;
+    if (MetricsReader::readMemoryPeak(container.peak_fd, container.paths.memory_peak_path, peak_bytes)) {
+        MetricsReader::resetMemoryPeak(container.peak_fd);
+    }
+    CM_LOG_INFO << "[ThreadPool] Container " << name << " is running, sampling started\n";
+    return true;
+}
+
+/**
+ * @brief Adapts a container's sampling interval to its latest sample.
+ *
+ * Idle containers back off toward max_sampling_interval_ms and return to the regular
+ * period as soon as they become active or approach the alert thresholds. Boosted
+ * containers are sampled every psi_boost_interval_ms regardless.
+ *
+ * @param container Container state.
+ * @param metrics Latest sample.
+ * @param regular_period_ms Regular (minimum) sampling period.
+ */
+void ResourceThreadPool::adaptInterval(MonitoredContainer& container, const ContainerMetrics& metrics, int64_t regular_period_ms) {
+    int64_t max_interval_ms = std::max<int64_t>(cfg_.max_sampling_interval_ms, regular_period_ms);
+    bool active = !container.has_prev_metrics;
+    if (!active) {
+        const ContainerMetrics& prev = container.prev_metrics;
+        double change = std::max({std::fabs(metrics.cpu_usage_percent - prev.cpu_usage_percent),
+                                  std::fabs(metrics.memory_usage_percent - prev.memory_usage_percent),
+                                  std::fabs(metrics.pids_percent - prev.pids_percent)});
+        double level = std::max({metrics.cpu_usage_percent, metrics.memory_usage_percent, metrics.pids_percent});
+        active = change >= cfg_.adaptive_change_threshold ||
+                 level >= cfg_.alert_warning * ADAPTIVE_NEAR_THRESHOLD_FRACTION;
+    }
+
+    if (active) {
+        container.interval_ms = regular_period_ms;
+    } else {
+        int64_t current = std::max(container.interval_ms, regular_period_ms);
+        container.interval_ms = std::min(current * ADAPTIVE_BACKOFF_FACTOR, max_interval_ms);
+    }
+    container.prev_metrics = metrics;
+    container.has_prev_metrics = true;
+}
+
+/**
+ * @brief Adds a sample to a container's UI windows and publishes the window extremes.
+ *
+ * The container's metrics table slot is overwritten in place with the max and min over
+ * the last ui_window_ms, the percentiles of the open percentile window and the
+ * time-to-limit forecast, so the UI sees every sample without waiting for a batch.
+ *
+ * The kernel memory high-water mark is read and reset with every sample and kept in its
+ * own window, so spikes between samples still show up in the peak. Metrics with an
+ * anomalous sample within ui_window_ms are flagged.
+ *
+ * @param name Container name.
+ * @param container Container state.
+ * @param metrics Latest sample.
+ * @param forecast Time-to-limit forecast including the sample.
+ */
+void ResourceThreadPool::publishSample(const std::string& name, MonitoredContainer& container, const ContainerMetrics& metrics,
+                                       const ContainerForecast& forecast) {
+    if (container.table_slot < 0) return;
+    container.cpu_window.push(metrics.timestamp, metrics.cpu_usage_percent);
+    container.memory_window.push(metrics.timestamp, metrics.memory_usage_percent);
+    container.pids_window.push(metrics.timestamp, metrics.pids_percent);
+
+    // Kernel high-water mark catches spikes since the previous sample; reset it for the next one
+    uint64_t peak_bytes = 0;
+    if (MetricsReader::readMemoryPeak(container.peak_fd, container.paths.memory_peak_path, peak_bytes)) {
+        double peak_mb = static_cast<double>(peak_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE));
+        double peak_mem = (container.info.memory_limit > 0)
+            ? std::round(peak_mb / container.info.memory_limit * PERCENT_FACTOR * PERCENT_FACTOR) / PERCENT_FACTOR
+            : ZERO_PERCENT;
+        container.peak_window.push(metrics.timestamp, peak_mem);
+        MetricsReader::resetMemoryPeak(container.peak_fd);
+    }
+
+    ContainerMaxMetricsMsg max_msg;
+    std::memset(&max_msg, 0, sizeof(max_msg));
+    max_msg.max_cpu_usage_percent = container.cpu_window.max();
+    max_msg.max_memory_usage_percent = container.memory_window.max();
+    max_msg.peak_memory_usage_percent = container.peak_window.empty() ? PEAK_UNAVAILABLE : container.peak_window.max();
+    max_msg.max_pids_percent = container.pids_window.max();
+    max_msg.min_cpu_usage_percent = container.cpu_window.min();
+    max_msg.min_memory_usage_percent = container.memory_window.min();
+    max_msg.min_pids_percent = container.pids_window.min();
+    container.window_sketches.cpu.quantiles(PERCENTILE_RANKS, max_msg.cpu_percentiles, PERCENTILE_COUNT);
+    container.window_sketches.memory.quantiles(PERCENTILE_RANKS, max_msg.memory_percentiles, PERCENTILE_COUNT);
+    container.window_sketches.pids.quantiles(PERCENTILE_RANKS, max_msg.pids_percentiles, PERCENTILE_COUNT);
+    max_msg.memory_seconds_to_limit = forecast.memory_seconds_to_limit;
+    max_msg.pids_seconds_to_limit = forecast.pids_seconds_to_limit;
+    for (size_t i = 0; i < ANOMALY_METRICS; ++i) {
+        if (container.anomaly_seen_ms[i] >= 0 && metrics.timestamp - container.anomaly_seen_ms[i] <= cfg_.ui_window_ms) {
+            max_msg.anomaly_flags |= static_cast<uint8_t>(1 << i);
+        }
+    }
+    std::strncpy(max_msg.container_id, name.c_str(), sizeof(max_msg.container_id) - 1);
+    container.table->write(container.table_slot, max_msg, metrics.timestamp);
+}
+
+/**
+ * @brief Adds a sample to a container's memory and PIDs trends and forecasts their limits.
+ *
+ * Holt's linear smoothing is O(1) per sample and keeps no history. The forecast is
+ * published to the UI and checked by the forecast alert rules.
+ *
+ * @param container Container state.
+ * @param metrics Latest sample.
+ * @return Time-to-limit forecast.
+ */
+ContainerForecast ResourceThreadPool::updateForecast(MonitoredContainer& container, const ContainerMetrics& metrics) {
+    container.memory_forecast.update(metrics.timestamp, metrics.memory_usage_percent);
+    container.pids_forecast.update(metrics.timestamp, metrics.pids_percent);
+    return {container.memory_forecast.secondsUntil(FORECAST_LIMIT_PERCENT),
+            container.pids_forecast.secondsUntil(FORECAST_LIMIT_PERCENT)};
+}
+
+/**
+ * @brief Adds a sample to a container's percentile window, closing the previous window first.
+ *
+ * Windows are aligned to multiples of percentile_window_ms, so the windows of all
+ * containers line up; a window without samples is simply skipped. Closed windows are
+ * merged into a rollup stored every PERCENTILE_ROLLUP_WINDOWS windows, so longer windows
+ * never re-read samples.
+ *
+ * Every sample is weighted by the time it stands for, so the percentiles are over time,
+ * not over samples: with adaptive sampling, busy periods are sampled far more often than
+ * idle ones and would otherwise dominate.
+ *
+ * @param name Container name.
+ * @param container Container state.
+ * @param metrics Latest sample.
+ * @param weight_ms Time the sample stands for, in milliseconds.
+ */
+void ResourceThreadPool::recordPercentiles(const std::string& name, MonitoredContainer& container, const ContainerMetrics& metrics,
+                                           int64_t weight_ms) {
+    int64_t window_ms = std::max(cfg_.percentile_window_ms, 1);
+    int64_t window_start_ms = metrics.timestamp - metrics.timestamp % window_ms;
+    if (container.window_start_ms >= 0 && container.window_start_ms != window_start_ms) {
+        closePercentileWindow(name, container, window_start_ms);
+    }
+    container.window_start_ms = window_start_ms;
+    container.window_sketches.add(metrics, static_cast<uint64_t>(std::max<int64_t>(weight_ms, 1)));
+}
+
+/**
+ * @brief Stores the percentiles of a container's open window and merges it into the rollup.
+ * @param name Container name.
+ * @param container Container state.
+ * @param next_window_start_ms Start of the window that follows, or -1 to close the rollup too.
+ */
+void ResourceThreadPool::closePercentileWindow(const std::string& name, MonitoredContainer& container, int64_t next_window_start_ms) {
+    if (container.window_start_ms < 0) return;
+    int64_t window_ms = std::max(cfg_.percentile_window_ms, 1);
+    int64_t rollup_ms = window_ms * PERCENTILE_ROLLUP_WINDOWS;
+    std::vector<ContainerPercentiles> rows;
+    appendPercentiles(rows, container.window_sketches, container.window_start_ms, window_ms);
+
+    // Windows merge exactly, so the rollup never needs the samples again
+    container.rollup_start_ms = container.window_start_ms - container.window_start_ms % rollup_ms;
+    container.rollup_sketches.merge(container.window_sketches);
+    container.window_sketches.clear();
+    container.window_start_ms = -1;
+    if (next_window_start_ms < 0 || next_window_start_ms - next_window_start_ms % rollup_ms != container.rollup_start_ms) {
+        appendPercentiles(rows, container.rollup_sketches, container.rollup_start_ms, rollup_ms);
+        container.rollup_sketches.clear();
+        container.rollup_start_ms = -1;
+    }
+    db_.insertPercentiles(name, rows);
+}
+
+/**
+ * @brief Appends the percentiles of a window's sketches, one row per metric.
+ * @param rows Rows to append to.
+ * @param sketches Sketches of the window.
+ * @param window_start_ms Start of the window.
+ * @param window_ms Window length.
+ */
+void ResourceThreadPool::appendPercentiles(std::vector<ContainerPercentiles>& rows, const MetricSketches& sketches,
+                                           int64_t window_start_ms, int64_t window_ms) {
+    const std::pair<const char*, const QuantileSketch*> metrics[] = {
+        {PERCENTILE_METRIC_CPU, &sketches.cpu},
+        {PERCENTILE_METRIC_MEMORY, &sketches.memory},
+        {PERCENTILE_METRIC_PIDS, &sketches.pids},
+    };
+    for (const auto& [metric, sketch] : metrics) {
+        if (sketch->count() == 0) continue;
+        ContainerPercentiles row;
+        row.window_start = window_start_ms;
+        row.window_ms = window_ms;
+        row.metric = metric;
+        row.samples = sketch->count();
+        sketch->quantiles(PERCENTILE_RANKS, row.values, PERCENTILE_COUNT);
+        rows.push_back(row);
+    }
+}
+
+/**
+ * @brief Checks a sample against the deadband of the last stored sample.
+ *
+ * Anomalous samples are always stored. The UI windows and percentiles still cover every
+ * sample, including the ones that are not stored.
+ *
+ * @param container Container state.
+ * @param metrics Latest sample.
+ * @return True if the sample should be stored.
+ */
+bool ResourceThreadPool::isRecordable(const MonitoredContainer& container, const ContainerMetrics& metrics) const {
+    if (!container.has_recorded || metrics.anomaly_flags != 0) return true;
+    const ContainerMetrics& last = container.last_recorded;
+    if (metrics.timestamp - last.timestamp >= cfg_.deadband_heartbeat_ms) return true;
+
+    auto outside = [this](double value, double reference) {
+        double band = std::max(cfg_.deadband_absolute, cfg_.deadband_relative * std::fabs(reference));
+        return std::fabs(value - reference) > band;
+    };
+    return outside(metrics.cpu_usage_percent, last.cpu_usage_percent) ||
+           outside(metrics.memory_usage_percent, last.memory_usage_percent) ||
+           outside(metrics.pids_percent, last.pids_percent);
+}
+
 /**
  * @brief Worker thread function for collecting metrics.
  * @param thread_index Index of the worker thread.
  *
- * - Collects metrics for assigned containers.
- * - Batches metrics and sends max values to the UI via message queue.
- * - Inserts batches into the database.
- * - Waits for the configured sampling interval.
- * - Handles shutdown and buffer flushing.
+ * - Probes created or stopped containers whose backoff has elapsed.
+ * - Samples running containers that are due; a failed read marks the container stopped.
+ * - Feeds every sample to the anomaly test, forecast, top consumers, alert rules, percentiles and UI table.
+ * - Batches metrics and inserts them into the database once full or once the oldest sample reaches flush_max_age_ms.
+ * - Waits until the next container is due, or until a container is added, removed or boosted.
+ * - Handles removed containers, shutdown and buffer flushing.
  */
 void ResourceThreadPool::workerLoop(int thread_index) {
     auto& buffers = thread_buffers_[thread_index];
-    auto& local_paths = thread_local_paths_[thread_index];
-
-    // Print METRIC_MQ_MSG_SIZE for debugging
-    CM_LOG_INFO << "[Thread " << thread_index << "] METRIC_MQ_MSG_SIZE: " << METRIC_MQ_MSG_SIZE << "\n";
-
-    // Open message queue (shared, fixed size)
-    mqd_t mq;
-    struct mq_attr attr;
-    attr.mq_flags = 0;
-    attr.mq_maxmsg = METRIC_MQ_MAX_MSG;
-    attr.mq_msgsize = METRIC_MQ_MSG_SIZE;
-    attr.mq_curmsgs = 0;
-
-    CM_LOG_INFO << "[Thread " << thread_index << "] Attempting mq_open with name: " << METRIC_MQ_NAME << "\n";
-    CM_LOG_INFO << "[Thread " << thread_index << "] mq_attr: "
-                << "mq_flags=" << attr.mq_flags
-                << ", mq_maxmsg=" << attr.mq_maxmsg
-                << ", mq_msgsize=" << attr.mq_msgsize
-                << ", mq_curmsgs=" << attr.mq_curmsgs << "\n";
-
-    mq = mq_open(METRIC_MQ_NAME.data(), O_RDWR | O_CREAT, 0644, &attr);
-
-    if (mq == (mqd_t)-1) {
-        CM_LOG_ERROR << "[Thread " << thread_index << "] Failed to open message queue: " << strerror(errno)
-                     << " (errno=" << errno << ")" << "\n";
-    } else {
-        CM_LOG_INFO << "[Thread " << thread_index << "] Message queue opened successfully. \n";
-    }
+    ConsumerSummaries& consumers = *consumers_[thread_index];
+    std::deque<FlushDeadline> db_deadlines;     // Oldest unflushed sample per DB batch
+    std::vector<AlertEvent> alerts;             // Alerts of the current sample, reused
 
     while (running_ && !shutdown_flag_) {
-        std::vector<std::string> containers;
+        std::vector<std::pair<std::string, std::shared_ptr<MonitoredContainer>>> containers;
+        std::vector<std::pair<std::string, std::shared_ptr<MonitoredContainer>>> retired;
+        uint64_t wake_generation;
         {
             std::unique_lock<std::mutex> lock(assign_mutex_);
-            containers = thread_containers_[thread_index];
+            wake_generation = wake_generation_;
+            retired.swap(retired_[thread_index]);
+            for (const auto& name : thread_containers_[thread_index]) {
+                auto it = thread_local_state_[thread_index].find(name);
+                if (it != thread_local_state_[thread_index].end()) containers.emplace_back(name, it->second);
+            }
         }
-        
-        // Add this check right here:
-        if (containers.empty()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MS_MEDIUM)); // or 1000ms
-            continue;
+        for (const auto& [name, container] : retired) {
+            closePercentileWindow(name, *container, -1);
+            if (alert_channel_) {
+                alerts.clear();
+                alert_engine_.clearAll(name, container->alert_state, container->last_sample_ms, alerts);
+                for (const auto& alert : alerts) alert_channel_->push(alert);
+            }
         }
+        retired.clear();
 
-        for (const auto& name : containers) {
+        // Each container is sampled once per sampling interval x number of running containers
+        size_t running_count = std::count_if(containers.begin(), containers.end(),
+            [](const auto& entry) { return entry.second->state == ContainerState::Running; });
+        int64_t regular_period_ms = static_cast<int64_t>(std::max<size_t>(running_count, 1)) * cfg_.resource_sampling_interval_ms;
+        int64_t next_wake_ms = -1;
+        for (const auto& [name, container] : containers) {
             ContainerMetrics metrics;
             metrics.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count();
 
-            auto it = local_paths.find(name);
-            if (it == local_paths.end()) continue;
-            MetricsReader reader(it->second, 1);
+            // Containers without a cgroup stay out of the schedule until their probe is due
+            if (container->state != ContainerState::Running &&
+                (container->next_probe_ms > metrics.timestamp || !probeContainer(name, *container, metrics.timestamp))) {
+                if (next_wake_ms < 0 || container->next_probe_ms < next_wake_ms) next_wake_ms = container->next_probe_ms;
+                continue;
+            }
 
-            // Fetch container limits from local cache
-            auto info_it = thread_local_info_[thread_index].find(name);
-            if (info_it == thread_local_info_[thread_index].end()) continue;
-            const ContainerInfo& info = info_it->second;
+            // Containers under pressure are sampled at the boost interval until the boost expires,
+            // otherwise at their adaptive interval (never faster than the regular period)
+            int64_t period_ms = regular_period_ms;
+            if (cfg_.adaptive_sampling_enabled) period_ms = std::max(container->interval_ms, regular_period_ms);
+            if (container->boost_until_ms > metrics.timestamp) period_ms = cfg_.psi_boost_interval_ms;
+            int64_t due_ms = container->last_sample_ms + period_ms;
+            if (due_ms > metrics.timestamp) {
+                if (next_wake_ms < 0 || due_ms < next_wake_ms) next_wake_ms = due_ms;
+                continue;
+            }
 
-            // Memory and pids as percent
-            metrics.memory_usage_percent = reader.getMemoryUsagePercent(info);
-            metrics.pids_percent = reader.getPidsPercent(info);
+            const ContainerInfo& info = container->info;
+            MetricsReader reader(container->paths, 1);
+
+            // Memory and pids as percent; a failed read means the cgroup is gone
+            uint64_t curr_cpu_ns = 0;
+            uint64_t memory_bytes = 0;
+            if (!reader.readUsage(info, curr_cpu_ns, metrics.memory_usage_percent, memory_bytes, metrics.pids_percent)) {
+                container->state = ContainerState::Stopped;
+                container->probe_backoff_ms = 0;
+                container->closePeak();
+                container->next_probe_ms = metrics.timestamp + CGROUP_PROBE_INITIAL_MS;
+                if (next_wake_ms < 0 || container->next_probe_ms < next_wake_ms) next_wake_ms = container->next_probe_ms;
+                CM_LOG_INFO << "[ThreadPool] Container " << name << " stopped, sampling paused\n";
+                continue;
+            }
+            int64_t previous_sample_ms = container->last_sample_ms;
+            container->last_sample_ms = metrics.timestamp;
 
             // CPU usage delta calculation
-            uint64_t curr_cpu_ns = reader.readUintFromFile(it->second.cpu_path);
-            auto prev_it = prev_cpu_usage_.find(name);
             metrics.cpu_usage_percent = ZERO_PERCENT;
-            if (prev_it != prev_cpu_usage_.end()) {
-                int64_t prev_ts = prev_it->second.first;
-                uint64_t prev_ns = prev_it->second.second;
-                int64_t delta_ms = metrics.timestamp - prev_ts;
-                int64_t delta_ns = static_cast<int64_t>(curr_cpu_ns) - static_cast<int64_t>(prev_ns);
+            double cores = 0.0;     // Cores used since the previous sample, also without a CPU limit
+            int64_t cpu_interval_ms = 0;
+            if (container->has_prev_cpu) {
+                int64_t delta_ms = metrics.timestamp - container->prev_cpu_ts;
+                int64_t delta_ns = static_cast<int64_t>(curr_cpu_ns) - static_cast<int64_t>(container->prev_cpu_ns);
+                if (delta_ms > 0 && delta_ns > 0) {
+                    cores = static_cast<double>(delta_ns) / (static_cast<double>(delta_ms) * NANOSECONDS_PER_MILLISECOND);
+                    cpu_interval_ms = delta_ms;
+                }
                 if (delta_ms > 0 && delta_ns > 0 && info.cpu_limit > 0) {
                     double cpu_sec = (double)delta_ns / NANOSECONDS_PER_SECOND;
                     double interval_sec = (double)delta_ms / MILLISECONDS_PER_SECOND;
@@ -237,48 +655,106 @@ void ResourceThreadPool::workerLoop(int thread_index) {
                     metrics.cpu_usage_percent = ZERO_PERCENT;
                 }
             }
-            prev_cpu_usage_[name] = {metrics.timestamp, curr_cpu_ns};
-
-            buffers[name].push_back(metrics);
-
-            if (buffers[name].size() >= cfg_.batch_size) {
-                if (cfg_.ui_enabled) { 
-                    double max_cpu = ZERO_PERCENT;
-                    double max_mem = ZERO_PERCENT;
-                    double max_pids = ZERO_PERCENT;
-                    for (const auto& m : buffers[name]) {
-                        max_cpu = std::max(max_cpu, m.cpu_usage_percent);
-                        max_mem = std::max(max_mem, m.memory_usage_percent);
-                        max_pids = std::max(max_pids, m.pids_percent);
-                    }
-
-                // Prepare message
-                    ContainerMaxMetricsMsg max_msg;
-                    std::memset(&max_msg, 0, sizeof(max_msg));
-                    max_msg.max_cpu_usage_percent = max_cpu;
-                    max_msg.max_memory_usage_percent = max_mem;
-                    max_msg.max_pids_percent = max_pids;
-                    std::memset(max_msg.container_id, 0, sizeof(max_msg.container_id));
-                    std::strncpy(max_msg.container_id, name.c_str(), sizeof(max_msg.container_id));
-
-                    mq_send(mq, reinterpret_cast<const char*>(&max_msg), METRIC_MQ_MSG_SIZE, 0);
+            container->has_prev_cpu = true;
+            container->prev_cpu_ts = metrics.timestamp;
+            container->prev_cpu_ns = curr_cpu_ns;
+
+            // Constant-time z-score test of the sample against the container's EWMA statistics
+            metrics.anomaly_flags = cfg_.anomaly_detection_enabled ? container->anomaly.update(metrics) : 0;
+            for (size_t i = 0; i < ANOMALY_METRICS; ++i) {
+                if (metrics.anomaly_flags & (1 << i)) container->anomaly_seen_ms[i] = metrics.timestamp;
+            }
+
+            if (cfg_.adaptive_sampling_enabled) {
+                adaptInterval(*container, metrics, regular_period_ms);
+                if (container->boost_until_ms <= metrics.timestamp) period_ms = container->interval_ms;
+            }
+            if (next_wake_ms < 0 || metrics.timestamp + period_ms < next_wake_ms) next_wake_ms = metrics.timestamp + period_ms;
+
+            // Usage over the interval since the previous sample, in absolute units (not percent of
+            // a limit), so containers compare and containers without limits are ranked too
+            if (previous_sample_ms > 0) {
+                double interval_ms = static_cast<double>(metrics.timestamp - previous_sample_ms);
+                double memory_mb = static_cast<double>(memory_bytes) / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE);
+                std::lock_guard<std::mutex> lock(consumers.mutex);
+                consumers.cpu.add(name, cores * static_cast<double>(cpu_interval_ms), metrics.timestamp);
+                consumers.memory.add(name, memory_mb * interval_ms, metrics.timestamp);
+            }
+
+            // O(1) trend update per sample, no history kept
+            ContainerForecast forecast = updateForecast(*container, metrics);
+
+            // Alerts are detected on the sample itself and queued without locking
+            if (alert_channel_) {
+                alerts.clear();
+                alert_engine_.evaluate(name, metrics, forecast, container->alert_state, alerts);
+                for (const auto& alert : alerts) {
+                    if (!alert_channel_->push(alert)) CM_LOG_WARN << "[ThreadPool] Alert channel full, alert for " << name << " dropped\n";
                 }
+            }
+
+            // Percentiles and UI windows cover every sample, including the ones the deadband does not store.
+            // A sample stands for the time since the previous one, capped at the longest regular interval
+            // so a container resuming after a stop does not count its pause.
+            int64_t longest_interval_ms = std::max<int64_t>(cfg_.max_sampling_interval_ms, regular_period_ms);
+            int64_t weight_ms = (previous_sample_ms > 0)
+                ? std::min(metrics.timestamp - previous_sample_ms, longest_interval_ms) : regular_period_ms;
+            recordPercentiles(name, *container, metrics, weight_ms);
+            publishSample(name, *container, metrics, forecast);
 
+            // With the deadband, unchanged samples are dropped; stored rows form a step function
+            if (cfg_.deadband_enabled && !isRecordable(*container, metrics)) continue;
+            container->last_recorded = metrics;
+            container->has_recorded = true;
+
+            auto& buffer = buffers[name];
+            if (buffer.empty() && cfg_.flush_max_age_ms > 0) {
+                db_deadlines.push_back({metrics.timestamp + cfg_.flush_max_age_ms, metrics.timestamp, name});
+            }
+            buffer.push_back(metrics);
+            if (buffer.size() >= cfg_.batch_size) {
                 // Insert batch to DB and clear buffer
-                db_.insertBatch(name, buffers[name]);
-                buffers[name].clear();
+                db_.insertBatch(name, buffer);
+                buffer.clear();
+            }
+        }
+
+        // Age-based flushes; deadlines are queued in time order, so only the fronts are checked.
+        // Entries of batches that were already flushed by size no longer match and are dropped.
+        int64_t flush_now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        while (!db_deadlines.empty() && db_deadlines.front().deadline_ms <= flush_now_ms) {
+            const FlushDeadline& deadline = db_deadlines.front();
+            auto it = buffers.find(deadline.name);
+            if (it != buffers.end() && !it->second.empty() && it->second.front().timestamp == deadline.started_ms) {
+                db_.insertBatch(deadline.name, it->second);
+                it->second.clear();
             }
+            db_deadlines.pop_front();
         }
-        // Wait for per-container sampling time × number of containers
-        int total_wait_ms = containers.size() * cfg_.resource_sampling_interval_ms;
+        if (!db_deadlines.empty() && (next_wake_ms < 0 || db_deadlines.front().deadline_ms < next_wake_ms)) {
+            next_wake_ms = db_deadlines.front().deadline_ms;
+        }
+
+        // Wait until the next container sample or cgroup probe is due; adding, removing or boosting a container wakes the thread early
+        int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        int64_t total_wait_ms = (next_wake_ms < 0) ? SLEEP_MS_MEDIUM : std::max<int64_t>(next_wake_ms - now_ms, 1);
         std::unique_lock<std::mutex> lock(assign_mutex_);
-        cv_.wait_for(lock, std::chrono::milliseconds(total_wait_ms), [this]() { return !running_; });
+        cv_.wait_for(lock, std::chrono::milliseconds(total_wait_ms),
+                     [this, wake_generation]() { return !running_ || wake_generation_ != wake_generation; });
     }
 
-    mq_close(mq);
-    
-    // On shutdown, flush all buffers for this thread
+    // On shutdown, flush all buffers for this thread and store the open percentile windows
     for (auto& [name, buffer] : buffers) {
         if (!buffer.empty()) db_.insertBatch(name, buffer);
+        buffer.clear();
+    }
+    std::vector<std::pair<std::string, std::shared_ptr<MonitoredContainer>>> open_windows;
+    {
+        std::unique_lock<std::mutex> lock(assign_mutex_);
+        open_windows.swap(retired_[thread_index]);
+        open_windows.insert(open_windows.end(), thread_local_state_[thread_index].begin(), thread_local_state_[thread_index].end());
     }
+    for (const auto& [name, container] : open_windows) closePercentileWindow(name, *container, -1);
 }
\ No newline at end of file
@@ -4,12 +4,13 @@
  */
 
 #pragma once
+#include <set>
 #include <vector>
 #include <mutex>
 #include <string>
 #include <atomic>
 #include <thread>
-#include <condition_variable>
+#include <unordered_map>
 #include "common.hpp"
 
 /**
@@ -20,14 +21,45 @@ struct ContainerMetricsEntry {
     std::string container_id;
     ContainerMaxMetricsMsg metrics;
     int64_t timestamp;
+    uint64_t created_seq;   ///< Arrival order, breaks ties between equal sort values.
 };
 
 /**
  * @class MonitorDashboard
  * @brief Displays live container metrics in a color-coded ncurses UI.
  *
- * Receives metrics via message queue, updates the display, and removes stale containers.
+ * Receives metrics from the live metric aggregator, updates the display, and removes stale containers.
  * Supports dynamic column alignment and color coding based on alert thresholds.
+ *
+ * Rows are kept in creation order with a hash index from container ID to row, so updates
+ * do not scan the list. Rendering is differential: each frame is formatted into a back
+ * buffer of screen cells for the visible page only, compared with the front buffer of what
+ * is on screen, and only the cells that changed are written (no full clear). The list is
+ * paged with the arrow, PgUp/PgDn and Home/End keys.
+ *
+ * Besides creation order, rows can be sorted by max CPU, memory or PIDs (keys c, m, p;
+ * o restores creation order), and t limits the view to the top ui_top_n containers. The
+ * active ordering is kept incrementally in a ranked set: an update moves only the changed
+ * container, and a frame walks the set to the visible page instead of sorting all rows.
+ *
+ * The q key switches the columns between the window maxima and the p50/p95/p99 of CPU
+ * and memory over the open percentile window.
+ *
+ * The last column shows the forecast time until memory or PIDs reach their limit,
+ * highlighted when it is within forecast_horizon_ms.
+ *
+ * With anomaly detection, a max value is marked with '*' while the window contains an
+ * anomalous sample of that metric.
+ *
+ * The h key switches to the top CPU and memory consumers reported by the thread pool,
+ * ranked by decayed average usage, including containers that have already exited.
+ *
+ * Alerts from the alert dispatcher color the name of containers with active alerts
+ * (yellow for warning, red for critical) and the latest one is shown above the status line.
+ *
+ * The UI thread sleeps in poll() on the
+ * terminal and a wake eventfd, and frames triggered by new data are paced to at most one
+ * per DASHBOARD_FRAME_INTERVAL_MS.
  */
 class MonitorDashboard {
 public:
@@ -55,6 +87,26 @@ public:
      */
     void pushMetricsRemoved(const std::string& container_id);
 
+    /**
+     * @brief Applies a batch of updated and removed containers as a single update.
+     * @param metrics Latest metrics of updated containers.
+     * @param removed_ids Identifiers of removed containers.
+     */
+    void pushUpdate(const std::vector<ContainerMaxMetricsMsg>& metrics, const std::vector<std::string>& removed_ids);
+
+    /**
+     * @brief Shows an alert that fired or cleared.
+     * @param event Alert event.
+     */
+    void pushAlert(const AlertEvent& event);
+
+    /**
+     * @brief Replaces the top CPU and memory consumers.
+     * @param cpu Top consumers by average CPU cores.
+     * @param memory Top consumers by average memory in MB.
+     */
+    void pushTopConsumers(const std::vector<HeavyHitter>& cpu, const std::vector<HeavyHitter>& memory);
+
     /**
      * @brief Starts the dashboard UI thread.
      */
@@ -66,19 +118,202 @@ public:
     void stop();
 
 private:
+    /**
+     * @enum SortMode
+     * @brief Row ordering of the dashboard.
+     */
+    enum class SortMode {
+        Creation,   ///< Order in which containers appeared.
+        Cpu,        ///< Descending max CPU usage.
+        Memory,     ///< Descending max memory usage.
+        Pids        ///< Descending max PIDs usage.
+    };
+
+    /**
+     * @struct RankKey
+     * @brief Position of a container in the sorted view.
+     */
+    struct RankKey {
+        double value;           ///< Sort value of the container.
+        uint64_t seq;           ///< Arrival order of the container.
+        std::string id;         ///< Container ID.
+
+        /**
+         * @brief Orders by descending value, then by arrival.
+         * @param other Key to compare with.
+         * @return True if this key ranks first.
+         */
+        bool operator<(const RankKey& other) const {
+            if (value != other.value) return value > other.value;
+            return seq < other.seq;
+        }
+    };
+
+    /**
+     * @struct ScreenCell
+     * @brief A formatted cell of a screen line.
+     */
+    struct ScreenCell {
+        int x;                  ///< Column of the first character.
+        int width;              ///< Width the text is padded to (0: rest of the line is cleared).
+        int color;              ///< Color pair (0 for the default color).
+        std::string text;       ///< Formatted text.
+
+        /**
+         * @brief Compares two cells.
+         * @param other Cell to compare with.
+         * @return True if both cells render identically.
+         */
+        bool operator==(const ScreenCell& other) const {
+            return x == other.x && width == other.width && color == other.color && text == other.text;
+        }
+    };
+
+    using ScreenLine = std::vector<ScreenCell>; ///< Cells of one screen line, left to right.
+
+    /**
+     * @struct AlertCounts
+     * @brief Active alerts of a container by severity.
+     */
+    struct AlertCounts {
+        int warning = 0;        ///< Active warning alerts.
+        int critical = 0;       ///< Active critical alerts.
+    };
+
     /**
      * @brief Worker thread function. Handles ncurses UI rendering and updates.
      */
     void run();
 
+    /**
+     * @brief Handles pending key presses.
+     * @return True if the view changed and a frame should be rendered.
+     */
+    bool handleInput();
+
+    /**
+     * @brief Renders a frame, writing only the cells that changed since the previous frame.
+     */
+    void render();
+
+    /**
+     * @brief Formats the lines of the current page into the back buffer.
+     * @param lines Receives one line per screen row.
+     */
+    void buildFrame(std::vector<ScreenLine>& lines);
+
+    /**
+     * @brief Formats the cells of a container row.
+     * @param entry Container metrics.
+     * @param name_width Width of the name column.
+     * @param alert_color Color pair of the name (0 without active alerts).
+     * @return Cells of the row.
+     */
+    ScreenLine formatRow(const ContainerMetricsEntry& entry, int name_width, int alert_color) const;
+
+    /**
+     * @brief Formats the top consumers view into the back buffer.
+     * @param lines Screen lines (header and footer lines are overwritten).
+     * @param cpu Top consumers by average CPU cores.
+     * @param memory Top consumers by average memory in MB.
+     */
+    void buildTopConsumers(std::vector<ScreenLine>& lines, const std::vector<HeavyHitter>& cpu,
+                           const std::vector<HeavyHitter>& memory) const;
+
+    /**
+     * @brief Formats a forecast time until a limit, e.g. "42s", "7m05s" or "3h20m".
+     * @param seconds Seconds until the limit (negative if not approaching).
+     * @param buffer Output buffer.
+     * @param size Buffer size.
+     */
+    static void formatDuration(double seconds, char* buffer, size_t size);
+
+    /**
+     * @brief Returns the color pair for the active alerts of a container (data_mutex_ must be held).
+     * @param container_id Container identifier.
+     * @return 3 with a critical alert, 2 with a warning alert, else 0.
+     */
+    int alertColor(const std::string& container_id) const;
+
+    /**
+     * @brief Returns the color pair for a metric value.
+     * @param value Metric value in percent.
+     * @return Color pair index.
+     */
+    int colorFor(double value) const;
+
+    /**
+     * @brief Switches the row ordering and top-N view, rebuilding the ranking.
+     * @param mode New sort mode.
+     * @param top_n Whether only the top ui_top_n rows are shown.
+     */
+    void setView(SortMode mode, bool top_n);
+
+    /**
+     * @brief Returns the value a container is sorted by in a sort mode.
+     * @param metrics Container metrics.
+     * @param mode Sort mode (not Creation).
+     * @return Sort value.
+     */
+    static double sortValue(const ContainerMaxMetricsMsg& metrics, SortMode mode);
+
+    /**
+     * @brief Returns the display name of a sort mode.
+     * @param mode Sort mode.
+     * @return Name shown in the status line.
+     */
+    static const char* sortName(SortMode mode);
+
+    /**
+     * @brief Returns the number of container rows that fit on the screen.
+     * @return Rows per page (at least 1).
+     */
+    size_t pageSize() const;
+
+    /**
+     * @brief Wakes the UI thread.
+     */
+    void wake();
+
+    /**
+     * @brief Stores metrics for a container (data_mutex_ must be held).
+     * @param metrics ContainerMaxMetricsMsg struct.
+     * @param now Current time in milliseconds.
+     */
+    void applyMetrics(const ContainerMaxMetricsMsg& metrics, int64_t now);
+
+    /**
+     * @brief Drops the metrics of a container (data_mutex_ must be held).
+     * @param container_id Container identifier.
+     * @return True if the container was shown.
+     */
+    bool applyRemoval(const std::string& container_id);
+
     std::atomic<bool>& shutdown_flag_;      ///< Reference to shutdown flag.
     const MonitorConfig& cfg_;              ///< Monitor configuration.
     std::thread worker_;                    ///< UI worker thread.
-    bool running_ = false;                  ///< Indicates if the dashboard is running.
+    std::atomic<bool> running_{false};      ///< Indicates if the dashboard is running.
+    int wake_fd_ = -1;                      ///< eventfd waking the UI thread for new data or shutdown.
 
     std::mutex data_mutex_;                 ///< Mutex for metrics data.
-    std::condition_variable data_cv_;       ///< Condition variable for UI updates.
-    bool data_updated_ = false;             ///< Indicates if data was updated.
-    bool printed_empty_ = false;            ///< Tracks if "No containers" message was printed.
+    bool data_updated_ = false;             ///< Indicates if data was updated since the last frame.
     std::vector<ContainerMetricsEntry> metrics_vec_; ///< Container metrics vector (ordered by creation).
+    std::unordered_map<std::string, size_t> row_index_; ///< Container ID to position in metrics_vec_.
+    size_t name_width_ = 0;                 ///< Longest container name seen (grows only while rows exist).
+    uint64_t next_seq_ = 0;                 ///< Arrival counter for new rows.
+    SortMode sort_mode_ = SortMode::Creation; ///< Active row ordering.
+    bool top_n_ = false;                    ///< Whether only the top ui_top_n rows are shown.
+    std::set<RankKey> ranking_;             ///< Rows in sort order (empty in creation order).
+    std::unordered_map<std::string, AlertCounts> active_alerts_; ///< Containers with active alerts.
+    AlertEvent last_alert_{};               ///< Latest alert shown in the alert line.
+    bool has_alert_ = false;                ///< Whether an alert was received.
+    std::vector<HeavyHitter> top_cpu_;      ///< Top consumers by average CPU cores.
+    std::vector<HeavyHitter> top_memory_;   ///< Top consumers by average memory in MB.
+
+    // UI thread state
+    size_t first_row_ = 0;                  ///< Index of the first row shown (scroll position).
+    bool percentiles_ = false;              ///< Whether percentile columns are shown instead of the maxima.
+    bool top_consumers_ = false;            ///< Whether the top consumers are shown instead of the containers.
+    std::vector<ScreenLine> screen_;        ///< Front buffer: cells currently on screen.
+    std::vector<ScreenLine> frame_;         ///< Back buffer: cells of the frame being built.
 };
\ No newline at end of file
@@ -5,9 +5,15 @@
 
 #include "monitor_dashboard.hpp"
 #include <ncurses.h>
+#include <poll.h>
 #include <chrono>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include "logger.hpp"
 #include "common.hpp"
 
@@ -19,6 +25,10 @@
 MonitorDashboard::MonitorDashboard(std::atomic<bool>& shutdown_flag, const MonitorConfig& cfg)
     : shutdown_flag_(shutdown_flag), cfg_(cfg) {
     CM_LOG_INFO << "[MonitorDashboard] ui_refresh_interval_ms_: " << cfg_.ui_refresh_interval_ms << "\n";
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        CM_LOG_ERROR << "[MonitorDashboard] eventfd failed: " << strerror(errno) << "\n";
+    }
 }
 
 /**
@@ -26,6 +36,7 @@ MonitorDashboard::MonitorDashboard(std::atomic<bool>& shutdown_flag, const Monit
  */
 MonitorDashboard::~MonitorDashboard() {
     stop();
+    if (wake_fd_ >= 0) close(wake_fd_);
 }
 
 /**
@@ -33,53 +44,202 @@ MonitorDashboard::~MonitorDashboard() {
  * @param metrics ContainerMaxMetricsMsg struct.
  */
 void MonitorDashboard::pushMetrics(const ContainerMaxMetricsMsg& metrics) {
+    pushUpdate({metrics}, {});
+}
+
+/**
+ * @brief Removes metrics for a container.
+ * @param container_id Container identifier.
+ */
+void MonitorDashboard::pushMetricsRemoved(const std::string& container_id) {
+    pushUpdate({}, {container_id});
+}
+
+/**
+ * @brief Applies a batch of updated and removed containers as a single update.
+ *
+ * The data lock is taken once for the whole batch, and the UI thread is only woken
+ * if no earlier update is still waiting to be rendered.
+ *
+ * @param metrics Latest metrics of updated containers.
+ * @param removed_ids Identifiers of removed containers.
+ */
+void MonitorDashboard::pushUpdate(const std::vector<ContainerMaxMetricsMsg>& metrics, const std::vector<std::string>& removed_ids) {
     int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
+    bool changed = !metrics.empty();
+    bool notify = false;
     {
         std::lock_guard<std::mutex> lock(data_mutex_);
-        CM_LOG_INFO << "[MonitorDashboard] pushMetrics: " << metrics.container_id
-                    << " | CPU: " << metrics.max_cpu_usage_percent
-                    << " | Mem: " << metrics.max_memory_usage_percent
-                    << " | PIDs: " << metrics.max_pids_percent << "\n";
-        // Check if container already exists, update if found, else append
-        bool found = false;
-        for (auto& entry : metrics_vec_) {
-            if (entry.container_id == metrics.container_id) {
-                entry.metrics = metrics;
-                entry.timestamp = now;
-                found = true;
-                break;
-            }
+        for (const auto& entry : metrics) {
+            applyMetrics(entry, now);
         }
-        if (!found) {
-            metrics_vec_.push_back({metrics.container_id, metrics, now});
+        for (const auto& container_id : removed_ids) {
+            changed = applyRemoval(container_id) || changed;
         }
+        if (!changed) return;
+        notify = !data_updated_;
         data_updated_ = true;
     }
-    data_cv_.notify_one();
+    if (notify) wake();
 }
 
 /**
- * @brief Removes metrics for a container.
- * @param container_id Container identifier.
+ * @brief Shows an alert that fired or cleared.
+ *
+ * Updates the container's active alert counts and the alert line, and wakes the UI
+ * thread right away so the alert is not held back until the next metrics update.
+ *
+ * @param event Alert event.
  */
-void MonitorDashboard::pushMetricsRemoved(const std::string& container_id) {
+void MonitorDashboard::pushAlert(const AlertEvent& event) {
+    bool notify = false;
     {
         std::lock_guard<std::mutex> lock(data_mutex_);
-        auto it = std::remove_if(metrics_vec_.begin(), metrics_vec_.end(),
-                                 [&](const ContainerMetricsEntry& entry) {
-                                     return entry.container_id == container_id;
-                                 });
-        if (it != metrics_vec_.end()) {
-            metrics_vec_.erase(it, metrics_vec_.end());
-            CM_LOG_INFO << "[MonitorDashboard] pushMetricsRemoved: " << container_id << "\n";
-            data_updated_ = true;
-        } else {
-            CM_LOG_INFO << "[MonitorDashboard] pushMetricsRemoved: container_id not found: " << container_id << "\n";
-            data_updated_ = false;
+        std::string id(event.container_name);
+        AlertCounts& counts = active_alerts_[id];
+        int& count = (event.severity == AlertSeverity::Critical) ? counts.critical : counts.warning;
+        count = std::max(count + (event.raised ? 1 : -1), 0);
+        if (counts.warning == 0 && counts.critical == 0) active_alerts_.erase(id);
+        last_alert_ = event;
+        has_alert_ = true;
+        notify = !data_updated_;
+        data_updated_ = true;
+    }
+    if (notify) wake();
+}
+
+/**
+ * @brief Replaces the top CPU and memory consumers.
+ * @param cpu Top consumers by average CPU cores.
+ * @param memory Top consumers by average memory in MB.
+ */
+void MonitorDashboard::pushTopConsumers(const std::vector<HeavyHitter>& cpu, const std::vector<HeavyHitter>& memory) {
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        top_cpu_ = cpu;
+        top_memory_ = memory;
+        notify = !data_updated_;
+        data_updated_ = true;
+    }
+    if (notify) wake();
+}
+
+/**
+ * @brief Stores metrics for a container (data_mutex_ must be held).
+ * @param metrics ContainerMaxMetricsMsg struct.
+ * @param now Current time in milliseconds.
+ */
+void MonitorDashboard::applyMetrics(const ContainerMaxMetricsMsg& metrics, int64_t now) {
+    // Update the indexed row if the container exists, else append
+    std::string id(metrics.container_id);
+    auto it = row_index_.find(id);
+    if (it != row_index_.end()) {
+        ContainerMetricsEntry& entry = metrics_vec_[it->second];
+        if (sort_mode_ != SortMode::Creation) {
+            // Move only this container within the ranking
+            double old_value = sortValue(entry.metrics, sort_mode_);
+            double new_value = sortValue(metrics, sort_mode_);
+            if (old_value != new_value) {
+                ranking_.erase({old_value, entry.created_seq, id});
+                ranking_.insert({new_value, entry.created_seq, id});
+            }
         }
+        entry.metrics = metrics;
+        entry.timestamp = now;
+        return;
     }
-    data_cv_.notify_one();
+    uint64_t seq = next_seq_++;
+    if (sort_mode_ != SortMode::Creation) ranking_.insert({sortValue(metrics, sort_mode_), seq, id});
+    row_index_.emplace(id, metrics_vec_.size());
+    name_width_ = std::max(name_width_, id.length());
+    metrics_vec_.push_back({std::move(id), metrics, now, seq});
+}
+
+/**
+ * @brief Drops the metrics of a container (data_mutex_ must be held).
+ *
+ * Rows after the removed one move up to keep the creation order.
+ *
+ * @param container_id Container identifier.
+ * @return True if the container was shown.
+ */
+bool MonitorDashboard::applyRemoval(const std::string& container_id) {
+    auto it = row_index_.find(container_id);
+    if (it == row_index_.end()) return false;
+    size_t position = it->second;
+    const ContainerMetricsEntry& entry = metrics_vec_[position];
+    if (sort_mode_ != SortMode::Creation) {
+        ranking_.erase({sortValue(entry.metrics, sort_mode_), entry.created_seq, container_id});
+    }
+    row_index_.erase(it);
+    active_alerts_.erase(container_id);
+    metrics_vec_.erase(metrics_vec_.begin() + position);
+    for (size_t i = position; i < metrics_vec_.size(); ++i) {
+        row_index_[metrics_vec_[i].container_id] = i;
+    }
+    if (metrics_vec_.empty()) name_width_ = 0;
+    return true;
+}
+
+/**
+ * @brief Switches the row ordering and top-N view, rebuilding the ranking.
+ *
+ * Rebuilding is the only full sort; afterwards updates keep the ranking in order.
+ *
+ * @param mode New sort mode.
+ * @param top_n Whether only the top ui_top_n rows are shown.
+ */
+void MonitorDashboard::setView(SortMode mode, bool top_n) {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    if (mode != sort_mode_) {
+        ranking_.clear();
+        if (mode != SortMode::Creation) {
+            for (const auto& entry : metrics_vec_) {
+                ranking_.insert({sortValue(entry.metrics, mode), entry.created_seq, entry.container_id});
+            }
+        }
+        sort_mode_ = mode;
+    }
+    top_n_ = top_n;
+    first_row_ = 0;
+}
+
+/**
+ * @brief Returns the value a container is sorted by in a sort mode.
+ * @param metrics Container metrics.
+ * @param mode Sort mode (not Creation).
+ * @return Sort value.
+ */
+double MonitorDashboard::sortValue(const ContainerMaxMetricsMsg& metrics, SortMode mode) {
+    switch (mode) {
+        case SortMode::Cpu:    return metrics.max_cpu_usage_percent;
+        case SortMode::Memory: return metrics.max_memory_usage_percent;
+        case SortMode::Pids:   return metrics.max_pids_percent;
+        default:               return ZERO_PERCENT;
+    }
+}
+
+/**
+ * @brief Returns the display name of a sort mode.
+ * @param mode Sort mode.
+ * @return Name shown in the status line.
+ */
+const char* MonitorDashboard::sortName(SortMode mode) {
+    switch (mode) {
+        case SortMode::Cpu:    return "max CPU";
+        case SortMode::Memory: return "max memory";
+        case SortMode::Pids:   return "max PIDs";
+        default:               return "creation";
+    }
+}
+
+/**
+ * @brief Wakes the UI thread.
+ */
+void MonitorDashboard::wake() {
+    if (wake_fd_ >= 0) eventfd_write(wake_fd_, 1);
 }
 
 /**
@@ -97,7 +257,7 @@ void MonitorDashboard::start() {
  */
 void MonitorDashboard::stop() {
     running_ = false;
-    data_cv_.notify_one();
+    wake();
     if (worker_.joinable()) {
         worker_.join();
     }
@@ -107,7 +267,8 @@ void MonitorDashboard::stop() {
  * @brief Worker thread function. Handles ncurses UI rendering and updates.
  *
  * - Initializes ncurses and color pairs.
- * - Waits for metric updates or refresh interval.
+ * - Sleeps in poll() until a key is pressed, data is updated or the refresh interval passes.
+ * - Renders key-triggered frames (scrolling, sort and top-N switches) at once and paces data-triggered frames.
  * - Dynamically aligns columns based on container name length.
  * - Displays metrics with color coding for alert thresholds.
  * - Handles shutdown and cleans up ncurses.
@@ -117,6 +278,8 @@ void MonitorDashboard::run() {
     cbreak();
     noecho();
     curs_set(0);
+    keypad(stdscr, TRUE);
+    nodelay(stdscr, TRUE);
 
     // Initialize color support
     if (has_colors()) {
@@ -126,62 +289,390 @@ void MonitorDashboard::run() {
         init_pair(3, COLOR_RED, COLOR_BLACK);    // Critical
     }
 
+    struct pollfd fds[2];
+    fds[0] = {STDIN_FILENO, POLLIN, 0};
+    fds[1] = {wake_fd_, POLLIN, 0};
+    bool pending = true;
+    int64_t last_frame_ms = 0;
+
     while (running_ && !shutdown_flag_) {
-        std::unique_lock<std::mutex> lock(data_mutex_);
-        data_cv_.wait_for(lock, std::chrono::milliseconds(cfg_.ui_refresh_interval_ms), [this] { return data_updated_ || !running_ || shutdown_flag_; });
+        int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int timeout_ms = cfg_.ui_refresh_interval_ms;
+        if (pending) {
+            int64_t wait_ms = last_frame_ms + DASHBOARD_FRAME_INTERVAL_MS - now_ms;
+            if (wait_ms <= 0) {
+                render();
+                last_frame_ms = now_ms;
+                pending = false;
+            } else {
+                timeout_ms = static_cast<int>(wait_ms);
+            }
+        }
 
+        int ready = poll(fds, 2, timeout_ms);
         if (!running_ || shutdown_flag_) break;
+        if (ready < 0 && errno != EINTR) {
+            CM_LOG_ERROR << "[MonitorDashboard] poll failed: " << strerror(errno) << "\n";
+            break;
+        }
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            uint64_t count;
+            if (read(wake_fd_, &count, sizeof(count)) > 0) pending = true;
+        }
+        // Key presses (and resizes, which interrupt poll) are rendered without pacing
+        if ((ready < 0 || (fds[0].revents & POLLIN)) && handleInput()) {
+            pending = true;
+            last_frame_ms = 0;
+        }
+    }
+    endwin();
+}
+
+/**
+ * @brief Handles pending key presses.
+ * @return True if the view changed and a frame should be rendered.
+ */
+bool MonitorDashboard::handleInput() {
+    bool changed = false;
+    size_t page = pageSize();
+    for (int key = getch(); key != ERR; key = getch()) {
+        size_t previous = first_row_;
+        SortMode mode;
+        bool top_n;
+        {
+            std::lock_guard<std::mutex> lock(data_mutex_);
+            mode = sort_mode_;
+            top_n = top_n_;
+        }
+        switch (key) {
+            case 'c': setView(SortMode::Cpu, top_n); changed = true; break;
+            case 'm': setView(SortMode::Memory, top_n); changed = true; break;
+            case 'p': setView(SortMode::Pids, top_n); changed = true; break;
+            case 'o': setView(SortMode::Creation, false); changed = true; break;
+            // Top-N needs an ordering; from creation order it starts with max CPU
+            case 't': setView(mode == SortMode::Creation ? SortMode::Cpu : mode, !top_n); changed = true; break;
+            case 'q': percentiles_ = !percentiles_; changed = true; break;
+            case 'h': top_consumers_ = !top_consumers_; changed = true; break;
+            case KEY_UP:    if (first_row_ > 0) --first_row_; break;
+            case KEY_DOWN:  ++first_row_; break;
+            case KEY_PPAGE: first_row_ = (first_row_ > page) ? first_row_ - page : 0; break;
+            case KEY_NPAGE: first_row_ += page; break;
+            case KEY_HOME:  first_row_ = 0; break;
+            case KEY_END:   first_row_ = SIZE_MAX; break;
+            case KEY_RESIZE:
+                // Everything on screen is stale after a resize
+                screen_.clear();
+                erase();
+                changed = true;
+                page = pageSize();
+                break;
+            default: break;
+        }
+        changed = changed || first_row_ != previous;
+    }
+    return changed;
+}
+
+/**
+ * @brief Returns the number of container rows that fit on the screen.
+ * @return Rows per page (at least 1).
+ */
+size_t MonitorDashboard::pageSize() const {
+    return static_cast<size_t>(std::max(LINES - DASHBOARD_HEADER_LINES - DASHBOARD_FOOTER_LINES, 1));
+}
+
+/**
+ * @brief Returns the color pair for a metric value.
+ * @param value Metric value in percent.
+ * @return Color pair index.
+ */
+int MonitorDashboard::colorFor(double value) const {
+    if (value <= cfg_.alert_warning) return 1; // green
+    if (value <= cfg_.alert_critical) return 2; // yellow
+    return 3; // red
+}
+
+/**
+ * @brief Formats a forecast time until a limit, e.g. "42s", "7m05s" or "3h20m".
+ * @param seconds Seconds until the limit (negative if not approaching).
+ * @param buffer Output buffer.
+ * @param size Buffer size.
+ */
+void MonitorDashboard::formatDuration(double seconds, char* buffer, size_t size) {
+    if (seconds < 0) {
+        std::snprintf(buffer, size, "-");
+        return;
+    }
+    long long total = static_cast<long long>(seconds);
+    if (total < 60) {
+        std::snprintf(buffer, size, "%llds", total);
+    } else if (total < 3600) {
+        std::snprintf(buffer, size, "%lldm%02llds", total / 60, total % 60);
+    } else if (total < 86400) {
+        std::snprintf(buffer, size, "%lldh%02lldm", total / 3600, total % 3600 / 60);
+    } else {
+        std::snprintf(buffer, size, "%lldd%02lldh", total / 86400, total % 86400 / 3600);
+    }
+}
+
+/**
+ * @brief Returns the color pair for the active alerts of a container (data_mutex_ must be held).
+ * @param container_id Container identifier.
+ * @return 3 with a critical alert, 2 with a warning alert, else 0.
+ */
+int MonitorDashboard::alertColor(const std::string& container_id) const {
+    auto it = active_alerts_.find(container_id);
+    if (it == active_alerts_.end()) return 0;
+    return (it->second.critical > 0) ? 3 : 2;
+}
+
+/**
+ * @brief Formats the cells of a container row.
+ * @param entry Container metrics.
+ * @param name_width Width of the name column.
+ * @param alert_color Color pair of the name (0 without active alerts).
+ * @return Cells of the row.
+ */
+MonitorDashboard::ScreenLine MonitorDashboard::formatRow(const ContainerMetricsEntry& entry, int name_width, int alert_color) const {
+    const auto& metrics = entry.metrics;
+    char buffer[CONTAINER_ID_BUF_SIZE + 8];
+    ScreenLine line;
+    line.reserve(5);
+
+    // Container name (colored by its active alerts)
+    std::snprintf(buffer, sizeof(buffer), "%-*s |", name_width, entry.container_id.c_str());
+    line.push_back({0, name_width + 2, alert_color, buffer});
 
-        size_t max_name_len = std::string(COL_CONTAINER_NAME).length();
-        for (const auto& entry : metrics_vec_) {
-            if (entry.container_id.length() > max_name_len) max_name_len = entry.container_id.length();
+    // Percentile view: CPU and memory p50/p95/p99 of the open percentile window
+    if (percentiles_) {
+        const double* columns[] = {metrics.cpu_percentiles, metrics.memory_percentiles};
+        int x = name_width + 3;
+        for (const double* values : columns) {
+            for (size_t i = 0; i < PERCENTILE_COUNT; ++i, x += 13) {
+                std::snprintf(buffer, sizeof(buffer), "%10.2f", values[i]);
+                line.push_back({x, 10, colorFor(values[i]), buffer});
+            }
         }
-        max_name_len += 2;  // Added some padding
+        return line;
+    }
 
-        std::string header_fmt = "%-" + std::to_string(max_name_len) + "s | %10s | %13s | %10s";
-        std::string row_fmt    = "%-" + std::to_string(max_name_len) + "s | %10.2f | %13.2f | %10.2f";
+    // CPU, memory, kernel memory high-water mark (n/a without a peak file) and PIDs with color;
+    // '*' marks a metric with an anomalous sample in the window
+    auto mark = [&metrics](uint8_t flag) { return (metrics.anomaly_flags & flag) ? '*' : ' '; };
+    std::snprintf(buffer, sizeof(buffer), "%9.2f%c", metrics.max_cpu_usage_percent, mark(ANOMALY_FLAG_CPU));
+    line.push_back({name_width + 3, 10, colorFor(metrics.max_cpu_usage_percent), buffer});
+    std::snprintf(buffer, sizeof(buffer), "%12.2f%c", metrics.max_memory_usage_percent, mark(ANOMALY_FLAG_MEMORY));
+    line.push_back({name_width + 16, 13, colorFor(metrics.max_memory_usage_percent), buffer});
+    if (metrics.peak_memory_usage_percent < ZERO_PERCENT) {
+        line.push_back({name_width + 32, 14, 0, "           n/a"});
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%14.2f", metrics.peak_memory_usage_percent);
+        line.push_back({name_width + 32, 14, colorFor(metrics.peak_memory_usage_percent), buffer});
+    }
+    std::snprintf(buffer, sizeof(buffer), "%9.2f%c", metrics.max_pids_percent, mark(ANOMALY_FLAG_PIDS));
+    line.push_back({name_width + 49, 10, colorFor(metrics.max_pids_percent), buffer});
 
-        clear();
-        mvprintw(0, 0, header_fmt.c_str(), COL_CONTAINER_NAME, COL_MAX_CPU, COL_MAX_MEM, COL_MAX_PIDS);
-        int row = 1;
+    // Nearest forecast limit, yellow within the forecast horizon
+    double seconds = metrics.memory_seconds_to_limit;
+    if (metrics.pids_seconds_to_limit >= 0 && (seconds < 0 || metrics.pids_seconds_to_limit < seconds)) {
+        seconds = metrics.pids_seconds_to_limit;
+    }
+    char duration[16];
+    formatDuration(seconds, duration, sizeof(duration));
+    std::snprintf(buffer, sizeof(buffer), "%10s", duration);
+    bool near = seconds >= 0 && cfg_.forecast_horizon_ms > 0 && seconds * MILLISECONDS_PER_SECOND <= cfg_.forecast_horizon_ms;
+    line.push_back({name_width + 62, 10, near ? 2 : 0, buffer});
+    return line;
+}
 
-        if (metrics_vec_.empty()) {
-            mvprintw(row++, 0, "No containers to display.");
+/**
+ * @brief Formats the top consumers view into the back buffer.
+ *
+ * One row per rank, the CPU and memory rankings side by side.
+ *
+ * @param lines Screen lines (header and footer lines are overwritten).
+ * @param cpu Top consumers by average CPU cores.
+ * @param memory Top consumers by average memory in MB.
+ */
+void MonitorDashboard::buildTopConsumers(std::vector<ScreenLine>& lines, const std::vector<HeavyHitter>& cpu,
+                                         const std::vector<HeavyHitter>& memory) const {
+    int width = static_cast<int>(std::max(std::strlen(COL_TOP_CPU), std::strlen(COL_TOP_MEM)));
+    for (const auto* list : {&cpu, &memory}) {
+        for (const auto& entry : *list) width = std::max(width, static_cast<int>(entry.name.length()));
+    }
+    char buffer[2 * CONTAINER_ID_BUF_SIZE + 64];
+    std::snprintf(buffer, sizeof(buffer), "%4s | %-*s | %10s | %-*s | %10s",
+                  COL_RANK, width, COL_TOP_CPU, COL_AVG_CORES, width, COL_TOP_MEM, COL_AVG_MB);
+    lines[0] = {{0, static_cast<int>(std::strlen(buffer)), 0, buffer}};
+
+    size_t count = std::max(cpu.size(), memory.size());
+    if (count == 0 && lines.size() > DASHBOARD_HEADER_LINES) {
+        lines[DASHBOARD_HEADER_LINES].push_back({0, 0, 0, "No consumers recorded yet."});
+    }
+    count = std::min(count, pageSize());
+    for (size_t i = 0; i < count && DASHBOARD_HEADER_LINES + i < lines.size(); ++i) {
+        char cpu_value[16] = "", memory_value[16] = "";
+        if (i < cpu.size()) std::snprintf(cpu_value, sizeof(cpu_value), "%.2f", cpu[i].weight);
+        if (i < memory.size()) std::snprintf(memory_value, sizeof(memory_value), "%.1f", memory[i].weight);
+        std::snprintf(buffer, sizeof(buffer), "%4zu | %-*s | %10s | %-*s | %10s", i + 1,
+                      width, i < cpu.size() ? cpu[i].name.c_str() : "", cpu_value,
+                      width, i < memory.size() ? memory[i].name.c_str() : "", memory_value);
+        lines[DASHBOARD_HEADER_LINES + i] = {{0, 0, 0, buffer}};
+    }
+    if (lines.size() > DASHBOARD_HEADER_LINES + DASHBOARD_FOOTER_LINES) {
+        std::snprintf(buffer, sizeof(buffer),
+                      "Top %d CPU and memory consumers, decayed with a %.0f min half-life  [h: containers]",
+                      cfg_.heavy_hitter_top_k, HEAVY_HITTER_HALF_LIFE_MS / MILLISECONDS_PER_MINUTE);
+        lines.back() = {{0, 0, 0, buffer}};
+    }
+}
+
+/**
+ * @brief Formats the lines of the current page into the back buffer.
+ *
+ * Only the rows of the visible page are copied out under the data lock.
+ *
+ * @param lines Receives one line per screen row.
+ */
+void MonitorDashboard::buildFrame(std::vector<ScreenLine>& lines) {
+    size_t page = pageSize();
+    std::vector<ContainerMetricsEntry> rows;
+    std::vector<int> alert_colors;
+    size_t active_alerts = 0;
+    AlertEvent last_alert{};
+    bool has_alert = false;
+    std::vector<HeavyHitter> top_cpu, top_memory;
+    size_t total = 0;
+    size_t containers = 0;
+    int name_width = 0;
+    SortMode mode;
+    bool top_n;
+    {
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        mode = sort_mode_;
+        top_n = top_n_;
+        containers = metrics_vec_.size();
+        total = top_n ? std::min(containers, static_cast<size_t>(std::max(cfg_.ui_top_n, 1))) : containers;
+        first_row_ = (total > page) ? std::min(first_row_, total - page) : 0;
+        size_t end = std::min(total, first_row_ + page);
+        if (mode == SortMode::Creation) {
+            rows.assign(metrics_vec_.begin() + first_row_, metrics_vec_.begin() + end);
         } else {
-            for (const auto& entry : metrics_vec_) {
-                const auto& metrics = entry.metrics;
-                const auto& id = entry.container_id;
-
-                // Determine color for each metric
-                auto color_for = [&](double value) {
-                    if (value <= cfg_.alert_warning) return 1; // green
-                    if (value <= cfg_.alert_critical) return 2; // yellow
-                    return 3; // red
-                };
-
-                // Print container name (default color)
-                mvprintw(row, 0, ("%-" + std::to_string(max_name_len) + "s |").c_str(), id.c_str());
-
-                // Print CPU usage with color
-                attron(COLOR_PAIR(color_for(metrics.max_cpu_usage_percent)));
-                mvprintw(row, max_name_len + 3, "%10.2f", metrics.max_cpu_usage_percent);
-                attroff(COLOR_PAIR(color_for(metrics.max_cpu_usage_percent)));
-
-                // Print Memory usage with color
-                attron(COLOR_PAIR(color_for(metrics.max_memory_usage_percent)));
-                mvprintw(row, max_name_len + 16, "%13.2f", metrics.max_memory_usage_percent);
-                attroff(COLOR_PAIR(color_for(metrics.max_memory_usage_percent)));
-
-                // Print PIDs usage with color
-                attron(COLOR_PAIR(color_for(metrics.max_pids_percent)));
-                mvprintw(row, max_name_len + 30, "%10.2f", metrics.max_pids_percent);
-                attroff(COLOR_PAIR(color_for(metrics.max_pids_percent)));
-
-                row++;
+            // Walk the ranking to the page; no sorting per frame
+            rows.reserve(end - first_row_);
+            auto it = std::next(ranking_.begin(), static_cast<std::ptrdiff_t>(first_row_));
+            for (size_t i = first_row_; i < end && it != ranking_.end(); ++i, ++it) {
+                rows.push_back(metrics_vec_[row_index_.at(it->id)]);
             }
         }
-        refresh();
+        name_width = static_cast<int>(std::max(name_width_, std::string(COL_CONTAINER_NAME).length())) + DASHBOARD_NAME_PADDING;
+        alert_colors.reserve(rows.size());
+        for (const auto& row : rows) alert_colors.push_back(alertColor(row.container_id));
+        for (const auto& [id, counts] : active_alerts_) active_alerts += counts.warning + counts.critical;
+        last_alert = last_alert_;
+        has_alert = has_alert_;
+        if (top_consumers_) {
+            top_cpu = top_cpu_;
+            top_memory = top_memory_;
+        }
         data_updated_ = false;
     }
-    endwin();
+
+    lines.assign(static_cast<size_t>(std::max(LINES, 0)), ScreenLine{});
+    if (lines.empty()) return;
+    char buffer[256];
+    if (percentiles_) {
+        std::snprintf(buffer, sizeof(buffer), "%-*s | %10s | %10s | %10s | %10s | %10s | %10s",
+                      name_width, COL_CONTAINER_NAME, COL_CPU_PERCENTILES[0], COL_CPU_PERCENTILES[1], COL_CPU_PERCENTILES[2],
+                      COL_MEM_PERCENTILES[0], COL_MEM_PERCENTILES[1], COL_MEM_PERCENTILES[2]);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%-*s | %10s | %13s | %14s | %10s | %10s",
+                      name_width, COL_CONTAINER_NAME, COL_MAX_CPU, COL_MAX_MEM, COL_PEAK_MEM, COL_MAX_PIDS, COL_LIMIT_IN);
+    }
+    lines[0].push_back({0, static_cast<int>(std::strlen(buffer)), 0, buffer});
+
+    // Alert line: active count and the latest alert, red/yellow when raised, green when cleared
+    if (has_alert && lines.size() > DASHBOARD_HEADER_LINES + DASHBOARD_FOOTER_LINES) {
+        int length = std::snprintf(buffer, sizeof(buffer), "Alerts: %zu active | last: %s %s %s %s of %s",
+                                   active_alerts, ALERT_SEVERITY_NAMES[static_cast<size_t>(last_alert.severity)],
+                                   ALERT_KIND_NAMES[static_cast<size_t>(last_alert.kind)],
+                                   last_alert.raised ? "raised on" : "cleared on",
+                                   ALERT_METRIC_NAMES[static_cast<size_t>(last_alert.metric)], last_alert.container_name);
+        if (last_alert.kind == AlertKind::Forecast) {
+            char duration[16];
+            formatDuration(last_alert.value, duration, sizeof(duration));
+            std::snprintf(buffer + length, sizeof(buffer) - length, ", limit in %s", duration);
+        } else {
+            std::snprintf(buffer + length, sizeof(buffer) - length, " at %.2f%s", last_alert.value,
+                          (last_alert.kind == AlertKind::Rate) ? " %/s" : " %");
+        }
+        int color = !last_alert.raised ? 1 : (last_alert.severity == AlertSeverity::Critical ? 3 : 2);
+        lines[lines.size() - 2].push_back({0, 0, color, buffer});
+    }
+
+    if (top_consumers_) {
+        buildTopConsumers(lines, top_cpu, top_memory);
+        return;
+    }
+
+    if (rows.empty()) {
+        if (lines.size() > DASHBOARD_HEADER_LINES) {
+            lines[DASHBOARD_HEADER_LINES].push_back({0, 0, 0, "No containers to display."});
+        }
+        return;
+    }
+    for (size_t i = 0; i < rows.size() && DASHBOARD_HEADER_LINES + i < lines.size(); ++i) {
+        lines[DASHBOARD_HEADER_LINES + i] = formatRow(rows[i], name_width, alert_colors[i]);
+    }
+    if (lines.size() > DASHBOARD_HEADER_LINES + DASHBOARD_FOOTER_LINES) {
+        int length = top_n
+            ? std::snprintf(buffer, sizeof(buffer), "Top %zu of %zu by %s, rows %zu-%zu", total, containers,
+                            sortName(mode), first_row_ + 1, first_row_ + rows.size())
+            : std::snprintf(buffer, sizeof(buffer), "Containers %zu-%zu of %zu by %s", first_row_ + 1,
+                            first_row_ + rows.size(), total, sortName(mode));
+        length += percentiles_
+            ? std::snprintf(buffer + length, sizeof(buffer) - length, ", percentiles of the open %.0f s window",
+                            cfg_.percentile_window_ms / MILLISECONDS_PER_SECOND)
+            : std::snprintf(buffer + length, sizeof(buffer) - length, ", max over %.1f s",
+                            cfg_.ui_window_ms / MILLISECONDS_PER_SECOND);
+        std::snprintf(buffer + length, sizeof(buffer) - length,
+                      "  [c/m/p/o: sort, t: top-N, q: percentiles, h: top consumers, Up/Down, PgUp/PgDn, Home/End: scroll]");
+        lines.back().push_back({0, 0, 0, buffer});
+    }
+}
+
+/**
+ * @brief Renders a frame, writing only the cells that changed since the previous frame.
+ *
+ * A line whose layout changed (e.g. the name column widened) is cleared and redrawn;
+ * otherwise only cells whose text or color differ are written.
+ */
+void MonitorDashboard::render() {
+    buildFrame(frame_);
+    bool drawn = false;
+    for (size_t y = 0; y < frame_.size(); ++y) {
+        const ScreenLine& line = frame_[y];
+        const ScreenLine* shown = (y < screen_.size()) ? &screen_[y] : nullptr;
+        bool same_layout = shown && shown->size() == line.size();
+        for (size_t c = 0; same_layout && c < line.size(); ++c) {
+            same_layout = (*shown)[c].x == line[c].x && (*shown)[c].width == line[c].width;
+        }
+        if (!same_layout) {
+            move(static_cast<int>(y), 0);
+            clrtoeol();
+            drawn = true;
+        }
+        for (size_t c = 0; c < line.size(); ++c) {
+            const ScreenCell& cell = line[c];
+            if (same_layout && (*shown)[c] == cell) continue;
+            if (cell.color) attron(COLOR_PAIR(cell.color));
+            mvprintw(static_cast<int>(y), cell.x, "%-*s", cell.width, cell.text.c_str());
+            if (cell.width == 0) clrtoeol(); // Free-width text may be shorter than before
+            if (cell.color) attroff(COLOR_PAIR(cell.color));
+            drawn = true;
+        }
+    }
+    if (drawn) refresh();
+    screen_.swap(frame_);
 }
\ No newline at end of file
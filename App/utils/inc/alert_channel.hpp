@@ -0,0 +1,84 @@
+/**
+ * @file alert_channel.hpp
+ * @brief Declares the AlertChannel class, a lock-free queue of alerts from the samplers to the alert sinks.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "common.hpp"
+
+/**
+ * @class AlertChannel
+ * @brief Bounded lock-free multi-producer, single-consumer queue of AlertEvent.
+ *
+ * A ring of cells, each carrying a sequence number: a producer claims a position with a
+ * CAS on the head, copies the event and publishes it by advancing the cell's sequence;
+ * the consumer takes cells in order once their sequence shows them published. Producers
+ * never wait for each other or for the consumer. When the ring is full the alert is
+ * dropped and counted, so a stalled consumer can never block a sampler.
+ *
+ * Every push also signals an eventfd, so the consumer can sleep in epoll; the eventfd
+ * counter coalesces bursts into a single wake-up.
+ */
+class AlertChannel {
+public:
+    /**
+     * @brief Constructs an empty channel.
+     * @param capacity Number of buffered alerts (rounded up to a power of two).
+     */
+    explicit AlertChannel(size_t capacity);
+
+    /**
+     * @brief Destructor. Closes the eventfd.
+     */
+    ~AlertChannel();
+
+    AlertChannel(const AlertChannel&) = delete;
+    AlertChannel& operator=(const AlertChannel&) = delete;
+
+    /**
+     * @brief Queues an alert; safe from any number of threads.
+     * @param event Alert to queue.
+     * @return True if queued, false if the channel was full and the alert was dropped.
+     */
+    bool push(const AlertEvent& event);
+
+    /**
+     * @brief Takes the oldest alert; must only be called from the consumer thread.
+     * @param event Receives the alert.
+     * @return True if an alert was taken, false if the channel is empty.
+     */
+    bool pop(AlertEvent& event);
+
+    /**
+     * @brief Returns the eventfd signalled after every push.
+     * @return Non-blocking eventfd, or -1 if unavailable.
+     */
+    int eventFd() const;
+
+    /**
+     * @brief Returns the number of alerts dropped because the channel was full.
+     * @return Dropped alerts.
+     */
+    uint64_t dropped() const;
+
+private:
+    /**
+     * @struct Cell
+     * @brief A ring slot; its sequence tells whether it is free or published for a position.
+     */
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<uint64_t> sequence; ///< Position + 1 once published, position + capacity once free again.
+        AlertEvent event;               ///< Queued alert.
+    };
+
+    std::unique_ptr<Cell[]> cells_;                         ///< Ring of cells.
+    size_t mask_;                                           ///< Capacity - 1.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0}; ///< Next position to push.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0}; ///< Next position to pop.
+    std::atomic<uint64_t> dropped_{0};                      ///< Alerts dropped on a full channel.
+    int event_fd_ = -1;                                     ///< Push notification eventfd.
+};
@@ -3,11 +3,12 @@
  * @brief Common data structures, constants, and configuration for container monitoring.
  *
  * Defines configuration structures, metric types, resource paths, constants for unit conversion,
- * message queue parameters, SQL schema strings, CSV export filenames, and parsing tokens.
+ * metrics table parameters, SQL schema strings, CSV export filenames, and parsing tokens.
  */
 
 #pragma once
 #include <string>
+#include <vector>
 #include <cstring>
 #include <string_view>
 
@@ -30,6 +31,37 @@ struct MonitorConfig {
     int thread_capacity;                    ///< Maximum containers per thread.
     std::string file_export_folder_path;    ///< Path for CSV exports.
     int ui_refresh_interval_ms;             ///< UI refresh interval in milliseconds.
+    int inspect_thread_count;               ///< Number of container inspect threads.
+    bool startup_discovery_enabled;         ///< Whether running containers are discovered at startup.
+    std::string discovery_mode;             ///< Container discovery mode (runtime or cgroupfs).
+    std::string cgroup_root;                ///< Mount point of the cgroup filesystem.
+    std::string metadata_cache_path;        ///< Path to the container metadata cache (empty disables it).
+    int host_sampling_interval_ms;          ///< Host usage sampling interval in milliseconds.
+    bool memory_events_enabled;             ///< Whether kernel memory threshold and OOM notifications are used.
+    bool psi_enabled;                       ///< Whether cgroup v2 pressure stall triggers are used.
+    int psi_stall_threshold_us;             ///< Stall time per window that fires a pressure trigger (us).
+    int psi_window_us;                      ///< Pressure trigger window (us).
+    int psi_boost_interval_ms;              ///< Sampling interval of a container under pressure (ms).
+    int psi_boost_duration_ms;              ///< How long sampling stays raised after a pressure trigger (ms).
+    bool adaptive_sampling_enabled;         ///< Whether idle containers are sampled less often.
+    int max_sampling_interval_ms;           ///< Longest adaptive sampling interval of an idle container (ms).
+    double adaptive_change_threshold;       ///< Change between samples (percentage points) that counts as activity.
+    bool deadband_enabled;                  ///< Whether only samples that changed beyond the deadband are stored.
+    double deadband_absolute;               ///< Absolute deadband per metric (percentage points).
+    double deadband_relative;               ///< Relative deadband per metric (fraction of the last stored value).
+    int deadband_heartbeat_ms;              ///< Longest time without a stored sample while the deadband suppresses samples (ms).
+    int flush_max_age_ms;                   ///< Longest time a sample waits in a batch before it is flushed (ms, 0 disables).
+    int ui_top_n;                           ///< Rows shown in the dashboard's top-N view.
+    int ui_window_ms;                       ///< Length of the sliding window the UI max and min cover (ms).
+    int percentile_window_ms;               ///< Length of a persisted percentile window (ms).
+    double alert_hysteresis;                ///< Percentage points below a threshold at which its alert clears.
+    int alert_min_duration_ms;              ///< Time a threshold must be exceeded before its alert fires (ms).
+    double alert_rate_per_second;           ///< Rise in percentage points per second that raises a rate alert (0: disabled).
+    std::string alert_socket_path;          ///< Unix socket path for alert subscribers (empty: disabled).
+    int forecast_horizon_ms;                ///< Flag containers forecast to reach a limit within this time (0: disabled).
+    bool anomaly_detection_enabled;         ///< Flag samples that deviate from their EWMA mean by more than anomaly_sigma.
+    double anomaly_sigma;                   ///< Standard deviations from the EWMA mean at which a sample is anomalous.
+    int heavy_hitter_top_k;                 ///< Number of top CPU and memory consumers reported.
 };
 
 /**
@@ -41,6 +73,18 @@ struct ContainerMetrics {
     double cpu_usage_percent;       ///< CPU usage percent.
     double memory_usage_percent;    ///< Memory usage percent.
     double pids_percent;            ///< PIDs usage percent.
+    uint8_t anomaly_flags;          ///< Metrics flagged as anomalous (ANOMALY_FLAG_* bits).
+};
+
+/**
+ * @struct HostUsage
+ * @brief Stores a host resource usage sample as percentages.
+ */
+struct HostUsage {
+    int64_t timestamp;              ///< Timestamp in milliseconds.
+    double cpu_usage_percent;       ///< CPU usage percent.
+    double memory_usage_percent;    ///< Memory usage percent.
+    std::vector<double> core_usage_percent; ///< Per-core CPU usage percent, indexed by core.
 };
 
 /**
@@ -48,15 +92,36 @@ struct ContainerMetrics {
  */
 inline constexpr size_t CONTAINER_ID_BUF_SIZE = 100;
 
+/**
+ * @brief Number of reported percentiles.
+ */
+inline constexpr size_t PERCENTILE_COUNT = 3;
+
+/**
+ * @brief Reported percentiles as fractions (p50, p95, p99).
+ */
+inline constexpr double PERCENTILE_RANKS[PERCENTILE_COUNT] = {0.50, 0.95, 0.99};
+
 #pragma pack(push, 1)
 /**
  * @struct ContainerMaxMetricsMsg
- * @brief Message structure for POSIX message queue, containing max metrics for a container.
+ * @brief Max and min metrics of a container over the UI sliding window, and its percentiles,
+ * published through the metrics table.
  */
 struct ContainerMaxMetricsMsg {
     double max_cpu_usage_percent;           ///< Maximum CPU usage percent.
     double max_memory_usage_percent;        ///< Maximum memory usage percent.
+    double peak_memory_usage_percent;       ///< Kernel memory high-water mark over the window, percent (negative if unavailable).
     double max_pids_percent;                ///< Maximum PIDs usage percent.
+    double min_cpu_usage_percent;           ///< Minimum CPU usage percent.
+    double min_memory_usage_percent;        ///< Minimum memory usage percent.
+    double min_pids_percent;                ///< Minimum PIDs usage percent.
+    double cpu_percentiles[PERCENTILE_COUNT];    ///< CPU usage percentiles of the current percentile window.
+    double memory_percentiles[PERCENTILE_COUNT]; ///< Memory usage percentiles of the current percentile window.
+    double pids_percentiles[PERCENTILE_COUNT];   ///< PIDs usage percentiles of the current percentile window.
+    double memory_seconds_to_limit;         ///< Forecast seconds until memory reaches its limit (negative if not approaching).
+    double pids_seconds_to_limit;           ///< Forecast seconds until PIDs reach their limit (negative if not approaching).
+    uint8_t anomaly_flags;                  ///< Metrics with an anomalous sample over the window (ANOMALY_FLAG_* bits).
     char container_id[CONTAINER_ID_BUF_SIZE]; ///< Container ID.
 };
 #pragma pack(pop)
@@ -69,6 +134,121 @@ struct ContainerResourcePaths {
     std::string cpu_path;       ///< Path to CPU usage file.
     std::string memory_path;    ///< Path to memory usage file.
     std::string pids_path;      ///< Path to PIDs usage file.
+    std::string memory_peak_path; ///< Path to memory high-water mark file (empty if unsupported).
+};
+
+/**
+ * @struct ContainerLimitPaths
+ * @brief Holds file paths for container resource limits.
+ */
+struct ContainerLimitPaths {
+    std::string cpu_quota_path;     ///< Path to CFS quota file.
+    std::string cpu_period_path;    ///< Path to CFS period file.
+    std::string memory_limit_path;  ///< Path to memory limit file.
+    std::string pids_max_path;      ///< Path to PIDs limit file.
+};
+
+/**
+ * @struct ContainerMemoryEventPaths
+ * @brief Holds file paths used to register kernel memory notifications.
+ */
+struct ContainerMemoryEventPaths {
+    std::string event_control_path; ///< Path to cgroup.event_control (empty if unsupported).
+    std::string usage_path;         ///< Path to the memory usage file thresholds refer to.
+    std::string oom_control_path;   ///< Path to memory.oom_control.
+};
+
+/**
+ * @struct ContainerPressurePaths
+ * @brief Holds file paths of a container's pressure stall information (PSI).
+ */
+struct ContainerPressurePaths {
+    std::string cpu_pressure_path;      ///< Path to cpu.pressure (empty if unsupported).
+    std::string memory_pressure_path;   ///< Path to memory.pressure (empty if unsupported).
+    std::string io_pressure_path;       ///< Path to io.pressure (empty if unsupported).
+};
+
+/**
+ * @struct PressureSample
+ * @brief Pressure stall values of one container resource, recorded when a trigger fires.
+ */
+struct PressureSample {
+    int64_t timestamp;              ///< Timestamp in milliseconds.
+    std::string container_name;     ///< Container name.
+    std::string resource;           ///< Resource under pressure (cpu, memory or io).
+    double some_avg10;              ///< Share of time some tasks stalled, 10s average (percent).
+    double full_avg10;              ///< Share of time all tasks stalled, 10s average (percent).
+    uint64_t some_total_us;         ///< Total stall time of some tasks (us).
+};
+
+/**
+ * @enum AlertMetric
+ * @brief Container metric an alert rule watches.
+ */
+enum class AlertMetric : uint8_t { Cpu, Memory, Pids };
+
+/**
+ * @enum AlertSeverity
+ * @brief Severity of an alert rule.
+ */
+enum class AlertSeverity : uint8_t { Warning, Critical };
+
+/**
+ * @enum AlertKind
+ * @brief Condition an alert rule checks.
+ */
+enum class AlertKind : uint8_t {
+    Threshold,  ///< Metric value at or above a level.
+    Rate,       ///< Metric rise per second at or above a level.
+    Forecast    ///< Forecast time until the metric reaches its limit within a horizon.
+};
+
+/**
+ * @struct HeavyHitter
+ * @brief A top consumer reported by a heavy-hitter summary.
+ */
+struct HeavyHitter {
+    std::string name;       ///< Container name.
+    double weight;          ///< Estimated weight (never below the true weight).
+    double error;           ///< Maximum overestimate of weight.
+};
+
+/**
+ * @struct ContainerForecast
+ * @brief Forecast time until a container's memory and PIDs reach their limits.
+ */
+struct ContainerForecast {
+    double memory_seconds_to_limit;     ///< Seconds until memory reaches its limit (negative if not approaching).
+    double pids_seconds_to_limit;       ///< Seconds until PIDs reach their limit (negative if not approaching).
+};
+
+/**
+ * @struct AlertEvent
+ * @brief An alert that fired or cleared, passed from the samplers to the alert sinks.
+ */
+struct AlertEvent {
+    int64_t timestamp;              ///< Sample time in milliseconds.
+    int64_t detected_ns;            ///< Monotonic time of detection in nanoseconds (for latency measurement).
+    double value;                   ///< Metric value (percent, or percentage points per second for rate rules).
+    double threshold;               ///< Level of the rule.
+    uint16_t rule;                  ///< Index of the rule in the compiled rule set.
+    AlertMetric metric;             ///< Watched metric.
+    AlertSeverity severity;         ///< Rule severity.
+    AlertKind kind;                 ///< Rule condition.
+    bool raised;                    ///< True when the alert fired, false when it cleared.
+    char container_name[CONTAINER_ID_BUF_SIZE]; ///< Container name.
+};
+
+/**
+ * @struct ContainerPercentiles
+ * @brief Percentiles of one container metric over a window.
+ */
+struct ContainerPercentiles {
+    int64_t window_start;           ///< Start of the window in milliseconds.
+    int64_t window_ms;              ///< Window length in milliseconds.
+    std::string metric;             ///< Metric name (cpu, memory or pids).
+    uint64_t samples;               ///< Number of samples in the window.
+    double values[PERCENTILE_COUNT]; ///< Percentiles in PERCENTILE_RANKS order (percent).
 };
 
 /**
@@ -94,6 +274,7 @@ struct HostInfo {
 // Unit conversion and percentage constants
 constexpr double NANOSECONDS_PER_SECOND = 1e9;           ///< Nanoseconds per second.
 constexpr double MILLISECONDS_PER_SECOND = 1000.0;       ///< Milliseconds per second.
+constexpr double MILLISECONDS_PER_MINUTE = 60000.0;      ///< Milliseconds per minute.
 constexpr double PERCENT_FACTOR = 100.0;                 ///< Factor for percentage calculation.
 constexpr double ZERO_PERCENT = 0.0;                     ///< Zero percent value.
 constexpr uint64_t BYTES_PER_KILOBYTE = 1024;            ///< Bytes per kilobyte.
@@ -105,10 +286,11 @@ inline constexpr int SLEEP_MS_SHORT   = 10;               ///< Short sleep durat
 inline constexpr int SLEEP_MS_MEDIUM  = 500;             ///< Medium sleep duration.
 inline constexpr int SLEEP_MS_LONG    = 1000;            ///< Long sleep duration.
 
-// Message queue constants
-inline constexpr std::string_view METRIC_MQ_NAME = "/container_max_metric_mq"; ///< POSIX message queue name.
-inline constexpr size_t METRIC_MQ_MSG_SIZE = sizeof(ContainerMaxMetricsMsg);    ///< Message size.
-inline constexpr long METRIC_MQ_MAX_MSG = 100;                                 ///< Max messages in queue.
+// Shared-memory metrics table constants
+inline constexpr std::string_view METRICS_TABLE_NAME = "/container_max_metric_table"; ///< POSIX shared-memory object name.
+inline constexpr size_t CACHE_LINE_SIZE = 64;                                   ///< Slot alignment, avoids false sharing between writers.
+inline constexpr int METRICS_TABLE_SNAPSHOT_MS = 250;                           ///< Snapshot interval of readers without update notifications.
+inline constexpr int METRICS_TABLE_OPEN_ATTEMPTS = 50;                          ///< Attempts to attach to the table before giving up.
 
 // Configuration file path
 inline constexpr std::string_view CONFIG_FILE_PATH = "../../config/parameter.conf"; ///< Path to config file.
@@ -128,6 +310,37 @@ inline constexpr std::string_view KEY_THREAD_COUNT = "thread_count";
 inline constexpr std::string_view KEY_THREAD_CAPACITY = "thread_capacity";
 inline constexpr std::string_view KEY_FILE_EXPORT_FOLDER_PATH = "file_export_folder_path";
 inline constexpr std::string_view KEY_UI_REFRESH_INTERVAL_MS = "ui_refresh_interval_ms";
+inline constexpr std::string_view KEY_INSPECT_THREAD_COUNT = "inspect_thread_count";
+inline constexpr std::string_view KEY_STARTUP_DISCOVERY_ENABLED = "startup_discovery_enabled";
+inline constexpr std::string_view KEY_DISCOVERY_MODE = "discovery_mode";
+inline constexpr std::string_view KEY_CGROUP_ROOT = "cgroup_root";
+inline constexpr std::string_view KEY_METADATA_CACHE_PATH = "metadata_cache_path";
+inline constexpr std::string_view KEY_HOST_SAMPLING_INTERVAL_MS = "host_sampling_interval_ms";
+inline constexpr std::string_view KEY_MEMORY_EVENTS_ENABLED = "memory_events_enabled";
+inline constexpr std::string_view KEY_PSI_ENABLED = "psi_enabled";
+inline constexpr std::string_view KEY_PSI_STALL_THRESHOLD_US = "psi_stall_threshold_us";
+inline constexpr std::string_view KEY_PSI_WINDOW_US = "psi_window_us";
+inline constexpr std::string_view KEY_PSI_BOOST_INTERVAL_MS = "psi_boost_interval_ms";
+inline constexpr std::string_view KEY_PSI_BOOST_DURATION_MS = "psi_boost_duration_ms";
+inline constexpr std::string_view KEY_ADAPTIVE_SAMPLING_ENABLED = "adaptive_sampling_enabled";
+inline constexpr std::string_view KEY_MAX_SAMPLING_INTERVAL_MS = "max_sampling_interval_ms";
+inline constexpr std::string_view KEY_ADAPTIVE_CHANGE_THRESHOLD = "adaptive_change_threshold";
+inline constexpr std::string_view KEY_DEADBAND_ENABLED = "deadband_enabled";
+inline constexpr std::string_view KEY_DEADBAND_ABSOLUTE = "deadband_absolute";
+inline constexpr std::string_view KEY_DEADBAND_RELATIVE = "deadband_relative";
+inline constexpr std::string_view KEY_DEADBAND_HEARTBEAT_MS = "deadband_heartbeat_ms";
+inline constexpr std::string_view KEY_FLUSH_MAX_AGE_MS = "flush_max_age_ms";
+inline constexpr std::string_view KEY_UI_TOP_N = "ui_top_n";
+inline constexpr std::string_view KEY_UI_WINDOW_MS = "ui_window_ms";
+inline constexpr std::string_view KEY_PERCENTILE_WINDOW_MS = "percentile_window_ms";
+inline constexpr std::string_view KEY_ALERT_HYSTERESIS = "alert_hysteresis";
+inline constexpr std::string_view KEY_ALERT_MIN_DURATION_MS = "alert_min_duration_ms";
+inline constexpr std::string_view KEY_ALERT_RATE_PER_SECOND = "alert_rate_per_second";
+inline constexpr std::string_view KEY_ALERT_SOCKET_PATH = "alert_socket_path";
+inline constexpr std::string_view KEY_FORECAST_HORIZON_MS = "forecast_horizon_ms";
+inline constexpr std::string_view KEY_ANOMALY_DETECTION_ENABLED = "anomaly_detection_enabled";
+inline constexpr std::string_view KEY_ANOMALY_SIGMA = "anomaly_sigma";
+inline constexpr std::string_view KEY_HEAVY_HITTER_TOP_K = "heavy_hitter_top_k";
 
 // Default values as string_view
 inline constexpr std::string_view DEFAULT_RUNTIME = "docker";
@@ -144,19 +357,70 @@ inline constexpr double DEFAULT_ALERT_CRITICAL = 100.0;
 inline constexpr int DEFAULT_THREAD_COUNT = 5;
 inline constexpr int DEFAULT_THREAD_CAPACITY = 10;
 inline constexpr int DEFAULT_UI_REFRESH_INTERVAL_MS = 2000;
+inline constexpr int DEFAULT_INSPECT_THREAD_COUNT = 4;
+inline constexpr bool DEFAULT_STARTUP_DISCOVERY_ENABLED = true;
+inline constexpr std::string_view DEFAULT_DISCOVERY_MODE = "runtime";
+inline constexpr std::string_view DEFAULT_CGROUP_ROOT = "/sys/fs/cgroup";
+inline constexpr std::string_view DEFAULT_METADATA_CACHE_PATH = "../../storage/container_cache.bin";
+inline constexpr int DEFAULT_HOST_SAMPLING_INTERVAL_MS = 1000;
+inline constexpr bool DEFAULT_MEMORY_EVENTS_ENABLED = true;
+inline constexpr bool DEFAULT_PSI_ENABLED = true;
+inline constexpr int DEFAULT_PSI_STALL_THRESHOLD_US = 150000;
+inline constexpr int DEFAULT_PSI_WINDOW_US = 1000000;
+inline constexpr int DEFAULT_PSI_BOOST_INTERVAL_MS = 100;
+inline constexpr int DEFAULT_PSI_BOOST_DURATION_MS = 5000;
+inline constexpr bool DEFAULT_ADAPTIVE_SAMPLING_ENABLED = true;
+inline constexpr int DEFAULT_MAX_SAMPLING_INTERVAL_MS = 5000;
+inline constexpr double DEFAULT_ADAPTIVE_CHANGE_THRESHOLD = 5.0;
+inline constexpr bool DEFAULT_DEADBAND_ENABLED = false;
+inline constexpr double DEFAULT_DEADBAND_ABSOLUTE = 0.5;
+inline constexpr double DEFAULT_DEADBAND_RELATIVE = 0.02;
+inline constexpr int DEFAULT_DEADBAND_HEARTBEAT_MS = 10000;
+inline constexpr int DEFAULT_FLUSH_MAX_AGE_MS = 2000;
+inline constexpr int DEFAULT_UI_TOP_N = 10;
+inline constexpr int DEFAULT_UI_WINDOW_MS = 5000;
+inline constexpr int DEFAULT_PERCENTILE_WINDOW_MS = 60000;
+inline constexpr double DEFAULT_ALERT_HYSTERESIS = 5.0;
+inline constexpr int DEFAULT_ALERT_MIN_DURATION_MS = 1000;
+inline constexpr double DEFAULT_ALERT_RATE_PER_SECOND = 0.0;
+inline constexpr std::string_view DEFAULT_ALERT_SOCKET_PATH = "";
+inline constexpr int DEFAULT_FORECAST_HORIZON_MS = 600000;
+inline constexpr bool DEFAULT_ANOMALY_DETECTION_ENABLED = false;
+inline constexpr double DEFAULT_ANOMALY_SIGMA = 3.0;
+inline constexpr int DEFAULT_HEAVY_HITTER_TOP_K = 10;
 
 // UI Table Column Names
 inline constexpr const char* COL_CONTAINER_NAME = "Container Name"; ///< UI column: container name.
 inline constexpr const char* COL_MAX_CPU = "Max CPU %";             ///< UI column: max CPU.
 inline constexpr const char* COL_MAX_MEM = "Max Memory %";          ///< UI column: max memory.
+inline constexpr const char* COL_PEAK_MEM = "Peak Memory %";        ///< UI column: kernel memory high-water mark.
 inline constexpr const char* COL_MAX_PIDS = "Max PIDs %";           ///< UI column: max PIDs.
+inline constexpr const char* COL_LIMIT_IN = "Limit in";             ///< UI column: forecast time until a limit is reached.
+inline constexpr const char* COL_CPU_PERCENTILES[PERCENTILE_COUNT] = {"CPU p50 %", "CPU p95 %", "CPU p99 %"}; ///< UI columns: CPU percentiles.
+inline constexpr const char* COL_MEM_PERCENTILES[PERCENTILE_COUNT] = {"Mem p50 %", "Mem p95 %", "Mem p99 %"}; ///< UI columns: memory percentiles.
+
+// UI layout and pacing
+inline constexpr int DASHBOARD_HEADER_LINES = 1;        ///< Lines above the container rows.
+inline constexpr int DASHBOARD_FOOTER_LINES = 2;        ///< Alert and status lines below the container rows.
+inline constexpr const char* COL_RANK = "Rank";                     ///< UI column: heavy-hitter rank.
+inline constexpr const char* COL_TOP_CPU = "Top CPU consumer";      ///< UI column: container with the most CPU use.
+inline constexpr const char* COL_AVG_CORES = "Avg cores";           ///< UI column: decayed average CPU cores.
+inline constexpr const char* COL_TOP_MEM = "Top memory consumer";   ///< UI column: container with the most memory use.
+inline constexpr const char* COL_AVG_MB = "Avg MB";                 ///< UI column: decayed average memory in MB.
+inline constexpr int DASHBOARD_NAME_PADDING = 2;        ///< Padding after the longest container name.
+inline constexpr int DASHBOARD_FRAME_INTERVAL_MS = 100; ///< Minimum time between frames triggered by new data.
 
 // System resource file paths
 inline constexpr const char* PROC_STAT_PATH    = "/proc/stat";      ///< Path to /proc/stat.
 inline constexpr const char* PROC_MEMINFO_PATH = "/proc/meminfo";   ///< Path to /proc/meminfo.
 
-// /proc/stat parsing format
-inline constexpr const char* CPU_STAT_FORMAT = "cpu  %lu %lu %lu %lu %lu %lu %lu %lu"; ///< Format for /proc/stat.
+// /proc read buffer sizes (the cpu lines of /proc/stat come first and fit for several hundred cores)
+inline constexpr size_t PROC_STAT_BUF_SIZE    = 65536;      ///< Read buffer for /proc/stat.
+inline constexpr size_t PROC_MEMINFO_BUF_SIZE = 4096;       ///< Read buffer for /proc/meminfo.
+
+// /proc/stat parsing tokens
+inline constexpr const char* CPU_STAT_PREFIX = "cpu";       ///< Prefix of the aggregate and per-core cpu lines.
+inline constexpr int CPU_STAT_FIELDS = 8;                   ///< user, nice, system, idle, iowait, irq, softirq, steal.
 
 // /proc/meminfo parsing tokens
 inline constexpr const char* MEMINFO_TOTAL   = "MemTotal:";         ///< Token for total memory.
@@ -164,16 +428,121 @@ inline constexpr const char* MEMINFO_FREE    = "MemFree:";          ///< Token f
 inline constexpr const char* MEMINFO_BUFFERS = "Buffers:";          ///< Token for buffers.
 inline constexpr const char* MEMINFO_CACHED  = "Cached:";           ///< Token for cached memory.
 
-// /proc/meminfo parsing format
-inline constexpr const char* MEMINFO_FORMAT  = "%lu kB";            ///< Format for /proc/meminfo values.
-
 // Cgroup path buffer size
 inline constexpr size_t CGROUP_PATH_BUF_SIZE = 512;                 ///< Buffer size for cgroup paths.
 
-// Docker Cgroup v1 path formats
-inline constexpr const char* DOCKER_CGROUP_V1_CPU_PATH_FMT    = "/sys/fs/cgroup/cpu/docker/%s/cpuacct.usage"; ///< Format for CPU path.
-inline constexpr const char* DOCKER_CGROUP_V1_MEMORY_PATH_FMT = "/sys/fs/cgroup/memory/docker/%s/memory.usage_in_bytes"; ///< Format for memory path.
-inline constexpr const char* DOCKER_CGROUP_V1_PIDS_PATH_FMT   = "/sys/fs/cgroup/pids/docker/%s/pids.current"; ///< Format for PIDs path.
+// Docker Cgroup v1 path formats (first %s: cgroup root, second %s: container ID)
+inline constexpr const char* DOCKER_CGROUP_V1_CPU_PATH_FMT    = "%s/cpu/docker/%s/cpuacct.usage"; ///< Format for CPU path.
+inline constexpr const char* DOCKER_CGROUP_V1_MEMORY_PATH_FMT = "%s/memory/docker/%s/memory.usage_in_bytes"; ///< Format for memory path.
+inline constexpr const char* DOCKER_CGROUP_V1_PIDS_PATH_FMT   = "%s/pids/docker/%s/pids.current"; ///< Format for PIDs path.
+inline constexpr const char* DOCKER_CGROUP_V1_MEMORY_PEAK_PATH_FMT = "%s/memory/docker/%s/memory.max_usage_in_bytes"; ///< Format for memory high-water mark path.
+
+// Docker Cgroup v1 limit file formats (first %s: cgroup root, second %s: container ID)
+inline constexpr const char* DOCKER_CGROUP_V1_CPU_QUOTA_PATH_FMT    = "%s/cpu/docker/%s/cpu.cfs_quota_us";        ///< Format for CPU quota path.
+inline constexpr const char* DOCKER_CGROUP_V1_CPU_PERIOD_PATH_FMT   = "%s/cpu/docker/%s/cpu.cfs_period_us";       ///< Format for CPU period path.
+inline constexpr const char* DOCKER_CGROUP_V1_MEMORY_LIMIT_PATH_FMT = "%s/memory/docker/%s/memory.limit_in_bytes"; ///< Format for memory limit path.
+inline constexpr const char* DOCKER_CGROUP_V1_PIDS_MAX_PATH_FMT     = "%s/pids/docker/%s/pids.max";               ///< Format for PIDs limit path.
+
+// Docker cgroup v2 path formats, cgroupfs driver (first %s: cgroup root, second %s: container ID)
+inline constexpr const char* DOCKER_CGROUP_V2_DIR_FMT          = "%s/docker/%s";                ///< Format for a container's cgroup directory.
+inline constexpr const char* DOCKER_CGROUP_V2_CPU_PATH_FMT     = "%s/docker/%s/cpu.stat";       ///< Format for CPU path (usage_usec).
+inline constexpr const char* DOCKER_CGROUP_V2_MEMORY_PATH_FMT  = "%s/docker/%s/memory.current"; ///< Format for memory path.
+inline constexpr const char* DOCKER_CGROUP_V2_PIDS_PATH_FMT    = "%s/docker/%s/pids.current";   ///< Format for PIDs path.
+inline constexpr const char* DOCKER_CGROUP_V2_MEMORY_PEAK_PATH_FMT = "%s/docker/%s/memory.peak"; ///< Format for memory high-water mark path.
+inline constexpr const char* DOCKER_CGROUP_V2_CPU_MAX_PATH_FMT = "%s/docker/%s/cpu.max";        ///< Format for CPU quota and period path.
+inline constexpr const char* DOCKER_CGROUP_V2_MEMORY_MAX_PATH_FMT = "%s/docker/%s/memory.max";  ///< Format for memory limit path.
+inline constexpr const char* DOCKER_CGROUP_V2_PIDS_MAX_PATH_FMT   = "%s/docker/%s/pids.max";    ///< Format for PIDs limit path.
+inline constexpr const char* DOCKER_CGROUP_V2_CPU_PRESSURE_PATH_FMT    = "%s/docker/%s/cpu.pressure";    ///< Format for CPU pressure path.
+inline constexpr const char* DOCKER_CGROUP_V2_MEMORY_PRESSURE_PATH_FMT = "%s/docker/%s/memory.pressure"; ///< Format for memory pressure path.
+inline constexpr const char* DOCKER_CGROUP_V2_IO_PRESSURE_PATH_FMT     = "%s/docker/%s/io.pressure";     ///< Format for IO pressure path.
+inline constexpr const char* DOCKER_CGROUP_V2_PARENT_DIR = "/docker";   ///< Parent directory relative to the cgroup root.
+
+// Cgroup v2 file tokens
+inline constexpr const char* CGROUP_V2_CPU_USAGE_KEY = "usage_usec";    ///< cpu.stat key of the cumulative CPU time.
+inline constexpr const char* CGROUP_V2_UNLIMITED = "max";               ///< Value of an unlimited cpu.max, memory.max or pids.max.
+inline constexpr uint64_t NANOSECONDS_PER_MICROSECOND = 1000;           ///< Nanoseconds per microsecond.
+inline constexpr int64_t NANOSECONDS_PER_MILLISECOND = 1000000;       ///< Nanoseconds per millisecond.
+
+// Memory high-water mark reset (accepted by v1 memory.max_usage_in_bytes and v2 memory.peak)
+inline constexpr const char* CGROUP_PEAK_RESET_VALUE = "0";             ///< Value written to reset a high-water mark.
+inline constexpr double PEAK_UNAVAILABLE = -1.0;                        ///< Peak percent reported when no high-water mark is available.
+
+// Pressure stall information (PSI) triggers
+inline constexpr const char* PSI_TRIGGER_TYPE = "some";     ///< Trigger on stalls of some tasks.
+inline constexpr const char* PSI_SOME_PREFIX = "some";      ///< Prefix of the some line in a pressure file.
+inline constexpr const char* PSI_FULL_PREFIX = "full";      ///< Prefix of the full line in a pressure file.
+inline constexpr size_t PSI_BUF_SIZE = 256;                 ///< Read buffer for a pressure file.
+
+// Docker Cgroup v1 parent directories relative to the cgroup root (one sub-directory per running container)
+inline constexpr const char* DOCKER_CGROUP_V1_CPU_PARENT_DIR    = "/cpu/docker";    ///< CPU controller parent.
+inline constexpr const char* DOCKER_CGROUP_V1_MEMORY_PARENT_DIR = "/memory/docker"; ///< Memory controller parent.
+inline constexpr const char* DOCKER_CGROUP_V1_PIDS_PARENT_DIR   = "/pids/docker";   ///< PIDs controller parent.
+inline constexpr const char* DOCKER_CGROUP_V1_DIR_FMT            = "%s/cpu/docker/%s"; ///< Format for a container's cgroup directory.
+
+// Docker cgroup v1 memory notification path formats
+inline constexpr const char* DOCKER_CGROUP_V1_EVENT_CONTROL_PATH_FMT = "%s/memory/docker/%s/cgroup.event_control"; ///< Format for event control path.
+inline constexpr const char* DOCKER_CGROUP_V1_OOM_CONTROL_PATH_FMT   = "%s/memory/docker/%s/memory.oom_control";   ///< Format for OOM control path.
+inline constexpr int EPOLL_MAX_EVENTS = 64;     ///< Maximum events returned by one epoll_wait call.
+
+// Container discovery constants
+inline constexpr size_t CONTAINER_ID_LENGTH = 64;               ///< Length of a full container ID.
+inline constexpr size_t INSPECT_BATCH_SIZE  = 32;               ///< Container IDs per bulk inspect call.
+inline constexpr size_t SHORT_CONTAINER_ID_LENGTH = 12;         ///< Length of a short container ID (used as name without a runtime).
+inline constexpr int CGROUP_SETTLE_MS = 50;                     ///< Delay before reading limits of a new cgroup.
+inline constexpr int CGROUP_PROBE_INITIAL_MS = 100;             ///< First retry delay for a missing container cgroup.
+inline constexpr int CGROUP_PROBE_MAX_MS = 2000;                ///< Maximum retry delay for a missing container cgroup.
+inline constexpr uint64_t CGROUP_UNLIMITED_BYTES = 1ULL << 62;  ///< Memory limits at or above this are treated as unlimited.
+
+// Adaptive sampling
+inline constexpr int ADAPTIVE_BACKOFF_FACTOR = 2;               ///< Growth of an idle container's sampling interval per calm sample.
+inline constexpr double ADAPTIVE_NEAR_THRESHOLD_FRACTION = 0.75; ///< Share of alert_warning from which values count as near the threshold.
+
+// Streaming percentiles
+inline constexpr double QUANTILE_SKETCH_RELATIVE_ACCURACY = 0.01; ///< Relative error of a percentile.
+inline constexpr double QUANTILE_SKETCH_MIN_VALUE = 0.01;        ///< Smaller values share the zero bucket.
+inline constexpr size_t QUANTILE_SKETCH_BUCKETS = 692;           ///< Buckets covering QUANTILE_SKETCH_MIN_VALUE up to 10000.
+inline constexpr int PERCENTILE_ROLLUP_WINDOWS = 60;             ///< Percentile windows merged into one rollup.
+inline constexpr const char* PERCENTILE_METRIC_CPU = "cpu";       ///< Metric name of CPU percentiles.
+inline constexpr const char* PERCENTILE_METRIC_MEMORY = "memory"; ///< Metric name of memory percentiles.
+inline constexpr const char* PERCENTILE_METRIC_PIDS = "pids";     ///< Metric name of PIDs percentiles.
+
+// Alerting
+inline constexpr size_t ALERT_CHANNEL_CAPACITY = 1024;           ///< Alerts buffered between samplers and sinks (power of two).
+inline constexpr double ALERT_RATE_CLEAR_FRACTION = 0.5;         ///< Share of the rate level below which a rate alert clears.
+inline constexpr int ALERT_SOCKET_BACKLOG = 8;                   ///< Pending connections on the alert socket.
+inline constexpr size_t ALERT_SOCKET_MAX_SUBSCRIBERS = 16;       ///< Maximum connected alert subscribers.
+inline constexpr size_t ALERT_LINE_BUF_SIZE = 512;               ///< Buffer for one formatted alert.
+inline constexpr const char* ALERT_METRIC_NAMES[] = {"cpu", "memory", "pids"};   ///< Names indexed by AlertMetric.
+inline constexpr const char* ALERT_SEVERITY_NAMES[] = {"warning", "critical"};     ///< Names indexed by AlertSeverity.
+inline constexpr const char* ALERT_KIND_NAMES[] = {"threshold", "rate", "forecast"}; ///< Names indexed by AlertKind.
+
+// Time-to-limit forecasting
+inline constexpr double FORECAST_LEVEL_TAU_MS = 15000.0;         ///< Time constant of the smoothed level.
+inline constexpr double FORECAST_TREND_TAU_MS = 60000.0;         ///< Time constant of the smoothed trend.
+inline constexpr int64_t FORECAST_WARMUP_MS = 30000;             ///< Observation time before a forecast is reported.
+inline constexpr double FORECAST_LIMIT_PERCENT = 100.0;          ///< Usage at which a limit is reached.
+inline constexpr double FORECAST_NONE = -1.0;                    ///< Seconds reported when no limit is approached.
+inline constexpr double FORECAST_CLEAR_FACTOR = 1.5;             ///< Share of the horizon beyond which a forecast alert clears.
+
+// Heavy hitters
+inline constexpr size_t HEAVY_HITTER_COUNTERS_PER_K = 8;         ///< Space-Saving counters per reported consumer.
+inline constexpr double HEAVY_HITTER_HALF_LIFE_MS = 300000.0;    ///< Half-life of a consumer's past usage.
+inline constexpr double HEAVY_HITTER_RESCALE_HALF_LIVES = 32.0;  ///< Half-lives after which the decay landmark moves.
+inline constexpr int HEAVY_HITTER_REPORT_MS = 1000;              ///< Interval of top-consumer updates to the dashboard.
+inline constexpr int HEAVY_HITTER_LOG_MS = 60000;                ///< Interval of top-consumer log lines.
+
+// Anomaly detection
+inline constexpr size_t ANOMALY_METRICS = 3;                     ///< Metrics tracked per container (CPU, memory, PIDs).
+inline constexpr uint8_t ANOMALY_FLAG_CPU = 1 << 0;              ///< Anomalous CPU usage.
+inline constexpr uint8_t ANOMALY_FLAG_MEMORY = 1 << 1;           ///< Anomalous memory usage.
+inline constexpr uint8_t ANOMALY_FLAG_PIDS = 1 << 2;             ///< Anomalous PIDs usage.
+inline constexpr double ANOMALY_EWMA_ALPHA = 0.05;               ///< Weight of a new sample in the EWMA mean and variance.
+inline constexpr uint32_t ANOMALY_WARMUP_SAMPLES = 20;           ///< Samples before anomalies are flagged.
+inline constexpr double ANOMALY_MIN_STDDEV = 0.5;                ///< Standard deviation floor in percentage points (flat metrics).
+
+// Container metadata cache file format
+inline constexpr uint32_t METADATA_CACHE_MAGIC   = 0x31434D43;  ///< "CMC1" in little endian.
+inline constexpr uint32_t METADATA_CACHE_VERSION = 2;           ///< Cache file format version.
 
 // SQLite table schema and SQL statements
 inline constexpr const char* SQL_CREATE_CONTAINERS_TABLE =
@@ -191,9 +560,16 @@ inline constexpr const char* SQL_CREATE_CONTAINER_METRICS_TABLE =
     "timestamp INTEGER,"
     "cpu_usage REAL,"
     "memory_usage REAL,"
-    "pids INTEGER"
+    "pids INTEGER,"
+    "anomaly INTEGER"
     ");"; ///< SQL for creating container_metrics table.
 
+inline constexpr const char* SQL_TABLE_INFO_CONTAINER_METRICS =
+    "PRAGMA table_info(container_metrics);"; ///< SQL for listing the columns of an existing container_metrics table.
+
+inline constexpr const char* SQL_ADD_CONTAINER_METRICS_ANOMALY =
+    "ALTER TABLE container_metrics ADD COLUMN anomaly INTEGER DEFAULT 0;"; ///< SQL for upgrading a container_metrics table created without the anomaly column.
+
 inline constexpr const char* SQL_CREATE_HOST_USAGE_TABLE =
     "CREATE TABLE IF NOT EXISTS host_usage ("
     "timestamp INTEGER,"
@@ -201,6 +577,35 @@ inline constexpr const char* SQL_CREATE_HOST_USAGE_TABLE =
     "memory_usage_percent REAL"
     ");"; ///< SQL for creating host_usage table.
 
+inline constexpr const char* SQL_CREATE_HOST_CORE_USAGE_TABLE =
+    "CREATE TABLE IF NOT EXISTS host_core_usage ("
+    "timestamp INTEGER,"
+    "core INTEGER,"
+    "cpu_usage_percent REAL"
+    ");"; ///< SQL for creating host_core_usage table.
+
+inline constexpr const char* SQL_CREATE_CONTAINER_PRESSURE_TABLE =
+    "CREATE TABLE IF NOT EXISTS container_pressure ("
+    "container_name TEXT,"
+    "timestamp INTEGER,"
+    "resource TEXT,"
+    "some_avg10 REAL,"
+    "full_avg10 REAL,"
+    "some_total_us INTEGER"
+    ");"; ///< SQL for creating container_pressure table.
+
+inline constexpr const char* SQL_CREATE_CONTAINER_PERCENTILES_TABLE =
+    "CREATE TABLE IF NOT EXISTS container_percentiles ("
+    "container_name TEXT,"
+    "window_start INTEGER,"
+    "window_ms INTEGER,"
+    "metric TEXT,"
+    "samples INTEGER,"
+    "p50 REAL,"
+    "p95 REAL,"
+    "p99 REAL"
+    ");"; ///< SQL for creating container_percentiles table.
+
 inline constexpr const char* SQL_INSERT_OR_REPLACE_CONTAINER =
     "INSERT OR REPLACE INTO containers (name, id, cpus, memory, pids_limit) VALUES (?, ?, ?, ?, ?);"; ///< SQL for upserting container.
 
@@ -219,11 +624,20 @@ inline constexpr const char* SQL_DELETE_CONTAINER_METRICS =
 inline constexpr const char* SQL_DELETE_HOST_USAGE =
     "DELETE FROM host_usage;"; ///< SQL for deleting all host usage.
 
+inline constexpr const char* SQL_DELETE_HOST_CORE_USAGE =
+    "DELETE FROM host_core_usage;"; ///< SQL for deleting all host per-core usage.
+
+inline constexpr const char* SQL_DELETE_CONTAINER_PRESSURE =
+    "DELETE FROM container_pressure;"; ///< SQL for deleting all container pressure samples.
+
+inline constexpr const char* SQL_DELETE_CONTAINER_PERCENTILES =
+    "DELETE FROM container_percentiles;"; ///< SQL for deleting all container percentiles.
+
 inline constexpr const char* SQL_INSERT_CONTAINER_METRICS =
-    "INSERT INTO container_metrics (container_name, timestamp, cpu_usage, memory_usage, pids) VALUES (?, ?, ?, ?, ?);"; ///< SQL for inserting container metrics.
+    "INSERT INTO container_metrics (container_name, timestamp, cpu_usage, memory_usage, pids, anomaly) VALUES (?, ?, ?, ?, ?, ?);"; ///< SQL for inserting container metrics.
 
 inline constexpr const char* SQL_SELECT_CONTAINER_METRICS =
-    "SELECT container_name, timestamp, cpu_usage, memory_usage, pids FROM container_metrics;"; ///< SQL for selecting container metrics.
+    "SELECT container_name, timestamp, cpu_usage, memory_usage, pids, anomaly FROM container_metrics;"; ///< SQL for selecting container metrics.
 
 inline constexpr const char* SQL_SELECT_HOST_USAGE =
     "SELECT timestamp, cpu_usage_percent, memory_usage_percent FROM host_usage;"; ///< SQL for selecting host usage.
@@ -231,10 +645,34 @@ inline constexpr const char* SQL_SELECT_HOST_USAGE =
 inline constexpr const char* SQL_INSERT_HOST_USAGE =
     "INSERT INTO host_usage (timestamp, cpu_usage_percent, memory_usage_percent) VALUES (?, ?, ?);"; ///< SQL for inserting host usage.
 
+inline constexpr const char* SQL_SELECT_HOST_CORE_USAGE =
+    "SELECT timestamp, core, cpu_usage_percent FROM host_core_usage;"; ///< SQL for selecting host per-core usage.
+
+inline constexpr const char* SQL_INSERT_HOST_CORE_USAGE =
+    "INSERT INTO host_core_usage (timestamp, core, cpu_usage_percent) VALUES (?, ?, ?);"; ///< SQL for inserting host per-core usage.
+
+inline constexpr const char* SQL_SELECT_CONTAINER_PRESSURE =
+    "SELECT container_name, timestamp, resource, some_avg10, full_avg10, some_total_us FROM container_pressure;"; ///< SQL for selecting container pressure samples.
+
+inline constexpr const char* SQL_INSERT_CONTAINER_PRESSURE =
+    "INSERT INTO container_pressure (container_name, timestamp, resource, some_avg10, full_avg10, some_total_us) VALUES (?, ?, ?, ?, ?, ?);"; ///< SQL for inserting a container pressure sample.
+
+inline constexpr const char* SQL_SELECT_CONTAINER_PERCENTILES =
+    "SELECT container_name, window_start, window_ms, metric, samples, p50, p95, p99 FROM container_percentiles;"; ///< SQL for selecting container percentiles.
+
+inline constexpr const char* SQL_INSERT_CONTAINER_PERCENTILES =
+    "INSERT INTO container_percentiles (container_name, window_start, window_ms, metric, samples, p50, p95, p99) VALUES (?, ?, ?, ?, ?, ?, ?, ?);"; ///< SQL for inserting container percentiles.
+
 // CSV export filenames
 inline constexpr const char* CSV_CONTAINER_METRICS_FILENAME = "/container_metrics.csv"; ///< Filename for container metrics CSV.
 inline constexpr const char* CSV_HOST_USAGE_FILENAME        = "/host_usage.csv";        ///< Filename for host usage CSV.
+inline constexpr const char* CSV_HOST_CORE_USAGE_FILENAME   = "/host_core_usage.csv";   ///< Filename for host per-core usage CSV.
+inline constexpr const char* CSV_CONTAINER_PRESSURE_FILENAME = "/container_pressure.csv"; ///< Filename for container pressure CSV.
+inline constexpr const char* CSV_CONTAINER_PERCENTILES_FILENAME = "/container_percentiles.csv"; ///< Filename for container percentiles CSV.
 
 // CSV header strings
-inline constexpr const char* CSV_CONTAINER_METRICS_HEADER = "container_name,timestamp,cpu_usage,memory_usage,pids\n"; ///< Header for container metrics CSV.
-inline constexpr const char* CSV_HOST_USAGE_HEADER        = "timestamp,cpu_usage_percent,memory_usage_percent\n";     ///< Header for host usage CSV.
\ No newline at end of file
+inline constexpr const char* CSV_CONTAINER_METRICS_HEADER = "container_name,timestamp,cpu_usage,memory_usage,pids,anomaly\n"; ///< Header for container metrics CSV.
+inline constexpr const char* CSV_HOST_USAGE_HEADER        = "timestamp,cpu_usage_percent,memory_usage_percent\n";     ///< Header for host usage CSV.
+inline constexpr const char* CSV_HOST_CORE_USAGE_HEADER   = "timestamp,core,cpu_usage_percent\n";                     ///< Header for host per-core usage CSV.
+inline constexpr const char* CSV_CONTAINER_PRESSURE_HEADER = "container_name,timestamp,resource,some_avg10,full_avg10,some_total_us\n"; ///< Header for container pressure CSV.
+inline constexpr const char* CSV_CONTAINER_PERCENTILES_HEADER = "container_name,window_start,window_ms,metric,samples,p50,p95,p99\n"; ///< Header for container percentiles CSV.
\ No newline at end of file
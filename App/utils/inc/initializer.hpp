@@ -8,7 +8,7 @@
 
 /**
  * @class Initializer
- * @brief Provides static methods for initializing logging, configuration, message queues, and signal handlers.
+ * @brief Provides static methods for initializing logging, configuration, the shared-memory metrics table, and signal handlers.
  */
 class Initializer {
 public:
@@ -21,9 +21,9 @@ public:
     static void initLogger(int argc, char* argv[], const MonitorConfig& cfg);
 
     /**
-     * @brief Unlinks the POSIX message queue used for metrics.
+     * @brief Removes the shared-memory metrics table left behind by a previous run.
      */
-    static void unlinkMessageQueue();
+    static void unlinkMetricsTable();
 
     /**
      * @brief Parses the configuration file and returns a MonitorConfig object.
@@ -5,6 +5,8 @@
 
 #pragma once
 #include <string>
+#include <vector>
+#include "common.hpp"
 
 /**
  * @struct ContainerEventInfo
@@ -22,8 +24,47 @@ struct ContainerEventInfo {
 
 /**
  * @brief Parses a container event JSON string into a ContainerEventInfo struct.
+ *
+ * Only the event payload is parsed; missing resource constraints are not fetched here.
+ * Use hasResourceConstraints() and getResourceConstraintsFromInspect() to enrich the event.
+ *
  * @param json_str JSON string representing the event.
  * @param info Reference to ContainerEventInfo to populate.
  * @return True if parsing was successful, false otherwise.
  */
-bool parseContainerEvent(const std::string& json_str, ContainerEventInfo& info);
\ No newline at end of file
+bool parseContainerEvent(const std::string& json_str, ContainerEventInfo& info);
+
+/**
+ * @brief Checks whether a "create" event already carries all resource constraints.
+ * @param info Parsed container event.
+ * @return True if cpus, memory and pids limit are all present.
+ */
+bool hasResourceConstraints(const ContainerEventInfo& info);
+
+/**
+ * @brief Extracts resource constraints from 'docker/podman inspect' output for a container.
+ * @param container_id Container ID.
+ * @param info Reference to ContainerEventInfo to populate.
+ * @return True if extraction was successful, false otherwise.
+ */
+bool getResourceConstraintsFromInspect(const std::string& container_id, ContainerEventInfo& info);
+
+/**
+ * @brief Inspects several containers with a single 'docker inspect' call.
+ *
+ * Each successfully inspected container is appended to @p infos as a "create" event
+ * carrying its name, full ID and resource constraints.
+ *
+ * @param container_ids Container IDs to inspect.
+ * @param infos Vector to append the inspected containers to.
+ * @return True if the inspect command ran and its output could be parsed, false otherwise.
+ */
+bool inspectContainers(const std::vector<std::string>& container_ids, std::vector<ContainerEventInfo>& infos);
+
+/**
+ * @brief Converts the string resource constraints of an event into a ContainerInfo.
+ * @param info Container event with resource constraints.
+ * @return ContainerInfo struct.
+ * @throws std::invalid_argument or std::out_of_range if a constraint is missing or malformed.
+ */
+ContainerInfo toContainerInfo(const ContainerEventInfo& info);
\ No newline at end of file
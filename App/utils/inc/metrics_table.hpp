@@ -0,0 +1,164 @@
+/**
+ * @file metrics_table.hpp
+ * @brief Declares the MetricsTable class, a shared-memory table of per-container UI metrics.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+#include "common.hpp"
+
+/**
+ * @struct MetricsTableEntry
+ * @brief Contents of a metrics table slot.
+ */
+struct MetricsTableEntry {
+    int64_t updated_ms;                 ///< Time of the last write in milliseconds.
+    ContainerMaxMetricsMsg metrics;     ///< Latest window extrema (empty container_id if the slot is free).
+};
+
+/**
+ * @class MetricsTable
+ * @brief Fixed-size table of per-container metrics in POSIX shared memory.
+ *
+ * Each container owns one slot, claimed when monitoring starts and released when it ends.
+ * Samplers overwrite their slot in place, so updates are never dropped; a reader only sees
+ * the latest values of each container. Every slot is protected by a seqlock: the writer
+ * makes the sequence odd, copies the entry and makes it even again, and a reader retries
+ * its copy until it saw the same even sequence before and after. Readers therefore take
+ * consistent snapshots without locks or syscalls, and never block the samplers.
+ *
+ * Within the creating process every write also signals an eventfd, so a reader can sleep
+ * in epoll until something changed; the eventfd counter coalesces bursts of writes into a
+ * single wake-up. Readers in other processes have no update descriptor and snapshot
+ * periodically instead.
+ *
+ * Each slot must have a single writer at a time; claiming is safe from any thread.
+ */
+class MetricsTable {
+public:
+    /**
+     * @brief Creates (or recreates) the shared-memory table.
+     * @param name Shared-memory object name.
+     * @param capacity Number of slots.
+     * @return The table, or nullptr on failure.
+     */
+    static std::unique_ptr<MetricsTable> create(std::string_view name, size_t capacity);
+
+    /**
+     * @brief Attaches to a table created by create().
+     * @param name Shared-memory object name.
+     * @return The table, or nullptr if it does not exist (yet).
+     */
+    static std::unique_ptr<MetricsTable> open(std::string_view name);
+
+    /**
+     * @brief Removes the shared-memory object name (existing mappings stay valid).
+     * @param name Shared-memory object name.
+     * @return True if the name was removed.
+     */
+    static bool unlink(std::string_view name);
+
+    /**
+     * @brief Destructor. Unmaps the table and closes the update descriptor.
+     */
+    ~MetricsTable();
+
+    MetricsTable(const MetricsTable&) = delete;
+    MetricsTable& operator=(const MetricsTable&) = delete;
+
+    /**
+     * @brief Returns the number of slots.
+     * @return Number of slots.
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Claims a free slot.
+     * @return Slot index, or -1 if the table is full.
+     */
+    int claim();
+
+    /**
+     * @brief Overwrites a claimed slot.
+     * @param slot Slot index returned by claim().
+     * @param metrics Latest window extrema.
+     * @param now_ms Current time in milliseconds.
+     */
+    void write(int slot, const ContainerMaxMetricsMsg& metrics, int64_t now_ms);
+
+    /**
+     * @brief Clears a claimed slot and makes it available again.
+     * @param slot Slot index returned by claim().
+     */
+    void release(int slot);
+
+    /**
+     * @brief Takes a consistent copy of a slot.
+     * @param slot Slot index.
+     * @param entry Receives the slot contents.
+     * @param sequence Receives the slot sequence; it changes with every write.
+     * @return True if the slot holds a container, false if it is free.
+     */
+    bool read(size_t slot, MetricsTableEntry& entry, uint32_t& sequence) const;
+
+    /**
+     * @brief Returns the current sequence of a slot without copying it.
+     * @param slot Slot index.
+     * @return Slot sequence (odd while a write is in progress).
+     */
+    uint32_t sequence(size_t slot) const;
+
+    /**
+     * @brief Returns the eventfd signalled after every write or release.
+     * @return Non-blocking eventfd, or -1 if the table was opened from another process.
+     */
+    int updateFd() const;
+
+private:
+    /**
+     * @struct Header
+     * @brief Table header at the start of the mapping.
+     */
+    struct alignas(CACHE_LINE_SIZE) Header {
+        std::atomic<uint32_t> ready;    ///< Set once the table is initialized.
+        uint32_t capacity;              ///< Number of slots.
+        int32_t owner_pid;              ///< Process that created the table.
+        int32_t update_fd;              ///< Update eventfd, valid in the owner process only.
+    };
+
+    /**
+     * @struct Slot
+     * @brief A seqlock-protected entry; one per cache line so writers do not contend.
+     */
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint32_t> sequence; ///< Odd while a write is in progress.
+        std::atomic<uint32_t> claimed;  ///< Non-zero while the slot is owned by a container.
+        MetricsTableEntry entry;        ///< Slot contents.
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared-memory atomics must be lock-free");
+
+    /**
+     * @brief Constructs a table over an existing mapping.
+     * @param base Start of the mapping.
+     * @param size Size of the mapping in bytes.
+     * @param update_fd Update eventfd owned by this object, or -1.
+     */
+    MetricsTable(void* base, size_t size, int update_fd);
+
+    /**
+     * @brief Writes a slot under its seqlock.
+     * @param slot Slot to write.
+     * @param entry New contents.
+     */
+    static void store(Slot& slot, const MetricsTableEntry& entry);
+
+    void* base_;            ///< Start of the mapping.
+    size_t size_;           ///< Size of the mapping in bytes.
+    Header* header_;        ///< Table header.
+    Slot* slots_;           ///< Slot array following the header.
+    int update_fd_;         ///< Update eventfd (-1 if unavailable).
+};
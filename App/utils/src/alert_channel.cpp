@@ -0,0 +1,94 @@
+/**
+ * @file alert_channel.cpp
+ * @brief Implements the AlertChannel class, a lock-free queue of alerts from the samplers to the alert sinks.
+ */
+
+#include "alert_channel.hpp"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "logger.hpp"
+
+/**
+ * @brief Constructs an empty channel.
+ * @param capacity Number of buffered alerts (rounded up to a power of two).
+ */
+AlertChannel::AlertChannel(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    mask_ = size - 1;
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+        CM_LOG_ERROR << "[AlertChannel] eventfd failed: " << strerror(errno) << "\n";
+    }
+}
+
+/**
+ * @brief Destructor. Closes the eventfd.
+ */
+AlertChannel::~AlertChannel() {
+    if (event_fd_ >= 0) close(event_fd_);
+}
+
+/**
+ * @brief Queues an alert; safe from any number of threads.
+ * @param event Alert to queue.
+ * @return True if queued, false if the channel was full and the alert was dropped.
+ */
+bool AlertChannel::push(const AlertEvent& event) {
+    uint64_t position = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[position & mask_];
+        uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (diff == 0) {
+            // Cell is free for this position; claim it (on failure position is reloaded)
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // The consumer has not freed this cell yet: full
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->event = event;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    if (event_fd_ >= 0) eventfd_write(event_fd_, 1);
+    return true;
+}
+
+/**
+ * @brief Takes the oldest alert; must only be called from the consumer thread.
+ * @param event Receives the alert.
+ * @return True if an alert was taken, false if the channel is empty.
+ */
+bool AlertChannel::pop(AlertEvent& event) {
+    uint64_t position = tail_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[position & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false;
+    event = cell.event;
+    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+    tail_.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Returns the eventfd signalled after every push.
+ * @return Non-blocking eventfd, or -1 if unavailable.
+ */
+int AlertChannel::eventFd() const {
+    return event_fd_;
+}
+
+/**
+ * @brief Returns the number of alerts dropped because the channel was full.
+ * @return Dropped alerts.
+ */
+uint64_t AlertChannel::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
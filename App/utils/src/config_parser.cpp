@@ -95,6 +95,37 @@ MonitorConfig ConfigParser::toMonitorConfig() const {
     cfg.thread_capacity                     = getInt(KEY_THREAD_CAPACITY, DEFAULT_THREAD_CAPACITY);
     cfg.file_export_folder_path             = get(KEY_FILE_EXPORT_FOLDER_PATH, DEFAULT_FILE_EXPORT_FOLDER_PATH);
     cfg.ui_refresh_interval_ms              = getInt(KEY_UI_REFRESH_INTERVAL_MS, DEFAULT_UI_REFRESH_INTERVAL_MS);
+    cfg.inspect_thread_count                = getInt(KEY_INSPECT_THREAD_COUNT, DEFAULT_INSPECT_THREAD_COUNT);
+    cfg.startup_discovery_enabled           = getBool(KEY_STARTUP_DISCOVERY_ENABLED, DEFAULT_STARTUP_DISCOVERY_ENABLED);
+    cfg.discovery_mode                      = get(KEY_DISCOVERY_MODE, DEFAULT_DISCOVERY_MODE);
+    cfg.cgroup_root                         = get(KEY_CGROUP_ROOT, DEFAULT_CGROUP_ROOT);
+    cfg.metadata_cache_path                 = get(KEY_METADATA_CACHE_PATH, DEFAULT_METADATA_CACHE_PATH);
+    cfg.host_sampling_interval_ms           = getInt(KEY_HOST_SAMPLING_INTERVAL_MS, DEFAULT_HOST_SAMPLING_INTERVAL_MS);
+    cfg.memory_events_enabled               = getBool(KEY_MEMORY_EVENTS_ENABLED, DEFAULT_MEMORY_EVENTS_ENABLED);
+    cfg.psi_enabled                         = getBool(KEY_PSI_ENABLED, DEFAULT_PSI_ENABLED);
+    cfg.psi_stall_threshold_us              = getInt(KEY_PSI_STALL_THRESHOLD_US, DEFAULT_PSI_STALL_THRESHOLD_US);
+    cfg.psi_window_us                       = getInt(KEY_PSI_WINDOW_US, DEFAULT_PSI_WINDOW_US);
+    cfg.psi_boost_interval_ms               = getInt(KEY_PSI_BOOST_INTERVAL_MS, DEFAULT_PSI_BOOST_INTERVAL_MS);
+    cfg.psi_boost_duration_ms               = getInt(KEY_PSI_BOOST_DURATION_MS, DEFAULT_PSI_BOOST_DURATION_MS);
+    cfg.adaptive_sampling_enabled           = getBool(KEY_ADAPTIVE_SAMPLING_ENABLED, DEFAULT_ADAPTIVE_SAMPLING_ENABLED);
+    cfg.max_sampling_interval_ms            = getInt(KEY_MAX_SAMPLING_INTERVAL_MS, DEFAULT_MAX_SAMPLING_INTERVAL_MS);
+    cfg.adaptive_change_threshold           = getDouble(KEY_ADAPTIVE_CHANGE_THRESHOLD, DEFAULT_ADAPTIVE_CHANGE_THRESHOLD);
+    cfg.deadband_enabled                    = getBool(KEY_DEADBAND_ENABLED, DEFAULT_DEADBAND_ENABLED);
+    cfg.deadband_absolute                   = getDouble(KEY_DEADBAND_ABSOLUTE, DEFAULT_DEADBAND_ABSOLUTE);
+    cfg.deadband_relative                   = getDouble(KEY_DEADBAND_RELATIVE, DEFAULT_DEADBAND_RELATIVE);
+    cfg.deadband_heartbeat_ms               = getInt(KEY_DEADBAND_HEARTBEAT_MS, DEFAULT_DEADBAND_HEARTBEAT_MS);
+    cfg.flush_max_age_ms                    = getInt(KEY_FLUSH_MAX_AGE_MS, DEFAULT_FLUSH_MAX_AGE_MS);
+    cfg.ui_top_n                            = getInt(KEY_UI_TOP_N, DEFAULT_UI_TOP_N);
+    cfg.ui_window_ms                        = getInt(KEY_UI_WINDOW_MS, DEFAULT_UI_WINDOW_MS);
+    cfg.percentile_window_ms                = getInt(KEY_PERCENTILE_WINDOW_MS, DEFAULT_PERCENTILE_WINDOW_MS);
+    cfg.alert_hysteresis                    = getDouble(KEY_ALERT_HYSTERESIS, DEFAULT_ALERT_HYSTERESIS);
+    cfg.alert_min_duration_ms               = getInt(KEY_ALERT_MIN_DURATION_MS, DEFAULT_ALERT_MIN_DURATION_MS);
+    cfg.alert_rate_per_second               = getDouble(KEY_ALERT_RATE_PER_SECOND, DEFAULT_ALERT_RATE_PER_SECOND);
+    cfg.alert_socket_path                   = get(KEY_ALERT_SOCKET_PATH, DEFAULT_ALERT_SOCKET_PATH);
+    cfg.forecast_horizon_ms                 = getInt(KEY_FORECAST_HORIZON_MS, DEFAULT_FORECAST_HORIZON_MS);
+    cfg.anomaly_detection_enabled           = getBool(KEY_ANOMALY_DETECTION_ENABLED, DEFAULT_ANOMALY_DETECTION_ENABLED);
+    cfg.anomaly_sigma                       = getDouble(KEY_ANOMALY_SIGMA, DEFAULT_ANOMALY_SIGMA);
+    cfg.heavy_hitter_top_k                  = getInt(KEY_HEAVY_HITTER_TOP_K, DEFAULT_HEAVY_HITTER_TOP_K);
     return cfg;
 }
 
@@ -116,4 +147,35 @@ void ConfigParser::printConfig(const MonitorConfig& cfg) const {
     CM_LOG_INFO << "Thread capacity: " << cfg.thread_capacity << "\n";
     CM_LOG_INFO << "File Export Path: " << cfg.file_export_folder_path << "\n";
     CM_LOG_INFO << "UI Refresh Interval: " << cfg.ui_refresh_interval_ms << " ms\n";
+    CM_LOG_INFO << "Inspect thread count: " << cfg.inspect_thread_count << "\n";
+    CM_LOG_INFO << "Startup discovery: " << (cfg.startup_discovery_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "Discovery mode: " << cfg.discovery_mode << "\n";
+    CM_LOG_INFO << "Cgroup root: " << cfg.cgroup_root << "\n";
+    CM_LOG_INFO << "Metadata cache path: " << cfg.metadata_cache_path << "\n";
+    CM_LOG_INFO << "Host sampling interval: " << cfg.host_sampling_interval_ms << " ms\n";
+    CM_LOG_INFO << "Memory events: " << (cfg.memory_events_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "PSI Enabled: " << (cfg.psi_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "PSI Stall Threshold: " << cfg.psi_stall_threshold_us << " us\n";
+    CM_LOG_INFO << "PSI Window: " << cfg.psi_window_us << " us\n";
+    CM_LOG_INFO << "PSI Boost Interval: " << cfg.psi_boost_interval_ms << " ms\n";
+    CM_LOG_INFO << "PSI Boost Duration: " << cfg.psi_boost_duration_ms << " ms\n";
+    CM_LOG_INFO << "Adaptive Sampling Enabled: " << (cfg.adaptive_sampling_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "Max Sampling Interval: " << cfg.max_sampling_interval_ms << " ms\n";
+    CM_LOG_INFO << "Adaptive Change Threshold: " << cfg.adaptive_change_threshold << " %\n";
+    CM_LOG_INFO << "Deadband Enabled: " << (cfg.deadband_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "Deadband Absolute: " << cfg.deadband_absolute << " %\n";
+    CM_LOG_INFO << "Deadband Relative: " << cfg.deadband_relative << "\n";
+    CM_LOG_INFO << "Deadband Heartbeat: " << cfg.deadband_heartbeat_ms << " ms\n";
+    CM_LOG_INFO << "Flush Max Age: " << cfg.flush_max_age_ms << " ms\n";
+    CM_LOG_INFO << "UI Top N: " << cfg.ui_top_n << "\n";
+    CM_LOG_INFO << "UI Window: " << cfg.ui_window_ms << " ms\n";
+    CM_LOG_INFO << "Percentile Window: " << cfg.percentile_window_ms << " ms\n";
+    CM_LOG_INFO << "Alert Hysteresis: " << cfg.alert_hysteresis << " %\n";
+    CM_LOG_INFO << "Alert Min Duration: " << cfg.alert_min_duration_ms << " ms\n";
+    CM_LOG_INFO << "Alert Rate: " << cfg.alert_rate_per_second << " %/s\n";
+    CM_LOG_INFO << "Alert Socket: " << cfg.alert_socket_path << "\n";
+    CM_LOG_INFO << "Forecast horizon: " << cfg.forecast_horizon_ms << " ms\n";
+    CM_LOG_INFO << "Anomaly detection enabled: " << (cfg.anomaly_detection_enabled ? "true" : "false") << "\n";
+    CM_LOG_INFO << "Anomaly sigma: " << cfg.anomaly_sigma << "\n";
+    CM_LOG_INFO << "Heavy hitter top K: " << cfg.heavy_hitter_top_k << "\n";
 }
\ No newline at end of file
@@ -6,9 +6,9 @@
 #include "initializer.hpp"
 #include <csignal>
 #include <cerrno>
-#include <mqueue.h>
 #include "logger.hpp"
 #include "config_parser.hpp"
+#include "metrics_table.hpp"
 
 /**
  * @brief Initializes the glog logger.
@@ -22,14 +22,13 @@ void Initializer::initLogger(int argc, char* argv[], const MonitorConfig& cfg) {
 }
 
 /**
- * @brief Unlinks the POSIX message queue used for metrics.
+ * @brief Removes the shared-memory metrics table left behind by a previous run.
  */
-void Initializer::unlinkMessageQueue() {
-    int unlink_result = mq_unlink(METRIC_MQ_NAME.data());
-    if (unlink_result == 0) {
-        CM_LOG_INFO << "[Main] Successfully unlinked message queue \n";
-    } else {
-        CM_LOG_ERROR << "[Main] mq_unlink failed: " << strerror(errno) << "\n";
+void Initializer::unlinkMetricsTable() {
+    if (MetricsTable::unlink(METRICS_TABLE_NAME)) {
+        CM_LOG_INFO << "[Main] Removed stale metrics table \n";
+    } else if (errno != ENOENT) {
+        CM_LOG_ERROR << "[Main] shm_unlink failed: " << strerror(errno) << "\n";
     }
 }
 
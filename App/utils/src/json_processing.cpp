@@ -11,13 +11,12 @@
 #include "common.hpp"
 
 /**
- * @brief Extracts resource constraints from 'docker/podman inspect' output for a container.
- * @param container_id Container ID.
- * @param info Reference to ContainerEventInfo to populate.
- * @return True if extraction was successful, false otherwise.
+ * @brief Runs a shell command and captures its standard output.
+ * @param cmd Command to run.
+ * @param output Reference to string receiving the output.
+ * @return True if the command could be started, false otherwise.
  */
-bool getResourceConstraintsFromInspect(const std::string& container_id, ContainerEventInfo& info) {
-    std::string cmd = "docker inspect " + container_id;
+static bool runCommand(const std::string& cmd, std::string& output) {
     FILE* pipe = popen(cmd.c_str(), "r");
     if (!pipe) return false;
 
@@ -27,25 +26,88 @@ bool getResourceConstraintsFromInspect(const std::string& container_id, Containe
         ss << buffer;
     }
     pclose(pipe);
+    output = ss.str();
+    return true;
+}
+
+/**
+ * @brief Copies resource constraints from one element of 'docker inspect' output.
+ * @param inspect Inspect JSON object of a single container.
+ * @param info Reference to ContainerEventInfo to populate.
+ */
+static void extractResourceConstraints(const nlohmann::json& inspect, ContainerEventInfo& info) {
+    const auto& hostConfig = inspect.at("HostConfig");
+    // CPUs: Docker stores as NanoCpus (divide by 1e9 for cores)
+    if (hostConfig.contains("NanoCpus")) {
+        long long nano_cpus = hostConfig["NanoCpus"];
+        info.cpus = std::to_string(nano_cpus / NANOSECONDS_PER_SECOND);
+    }
+    // Memory: bytes, convert to MB
+    if (hostConfig.contains("Memory")) {
+        long long mem_bytes = hostConfig["Memory"];
+        info.memory = std::to_string(mem_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE)) + "MB";
+    }
+    // PIDs limit (null when unlimited)
+    if (hostConfig.contains("PidsLimit") && hostConfig["PidsLimit"].is_number()) {
+        info.pids_limit = std::to_string(hostConfig["PidsLimit"].get<int>());
+    }
+}
+
+/**
+ * @brief Extracts resource constraints from 'docker/podman inspect' output for a container.
+ * @param container_id Container ID.
+ * @param info Reference to ContainerEventInfo to populate.
+ * @return True if extraction was successful, false otherwise.
+ */
+bool getResourceConstraintsFromInspect(const std::string& container_id, ContainerEventInfo& info) {
+    std::string output;
+    if (!runCommand("docker inspect " + container_id, output)) return false;
 
     try {
-        auto j = nlohmann::json::parse(ss.str());
+        auto j = nlohmann::json::parse(output);
         if (!j.is_array() || j.empty()) return false;
-        auto& inspect = j[0];
-        auto& hostConfig = inspect["HostConfig"];
-        // CPUs: Docker stores as NanoCpus (divide by 1e9 for cores)
-        if (hostConfig.contains("NanoCpus")) {
-            long long nano_cpus = hostConfig["NanoCpus"];
-            info.cpus = std::to_string(nano_cpus / NANOSECONDS_PER_SECOND);
-        }
-        // Memory: bytes, convert to MB
-        if (hostConfig.contains("Memory")) {
-            long long mem_bytes = hostConfig["Memory"];
-            info.memory = std::to_string(mem_bytes / (BYTES_PER_KILOBYTE * KILOBYTES_PER_MEGABYTE)) + "MB";
-        }
-        // PIDs limit
-        if (hostConfig.contains("PidsLimit")) {
-            info.pids_limit = std::to_string(hostConfig["PidsLimit"].get<int>());
+        extractResourceConstraints(j[0], info);
+        return true;
+    } catch (...) {
+        // Optionally log error
+    }
+    return false;
+}
+
+/**
+ * @brief Inspects several containers with a single 'docker inspect' call.
+ * @param container_ids Container IDs to inspect.
+ * @param infos Vector to append the inspected containers to.
+ * @return True if the inspect command ran and its output could be parsed, false otherwise.
+ */
+bool inspectContainers(const std::vector<std::string>& container_ids, std::vector<ContainerEventInfo>& infos) {
+    if (container_ids.empty()) return true;
+    std::string cmd = "docker inspect";
+    for (const auto& id : container_ids) {
+        cmd += " " + id;
+    }
+    // Containers that vanished in the meantime are reported on stderr and skipped
+    cmd += " 2>/dev/null";
+
+    std::string output;
+    if (!runCommand(cmd, output)) return false;
+
+    try {
+        auto j = nlohmann::json::parse(output);
+        if (!j.is_array()) return false;
+        for (const auto& inspect : j) {
+            try {
+                ContainerEventInfo info;
+                info.status = "create";
+                info.id = inspect.value("Id", "");
+                info.name = inspect.value("Name", "");
+                if (!info.name.empty() && info.name[0] == '/') info.name.erase(0, 1);
+                info.timeNano = 0;
+                extractResourceConstraints(inspect, info);
+                infos.push_back(std::move(info));
+            } catch (...) {
+                // Skip malformed entries, keep the rest of the batch
+            }
         }
         return true;
     } catch (...) {
@@ -54,9 +116,31 @@ bool getResourceConstraintsFromInspect(const std::string& container_id, Containe
     return false;
 }
 
+/**
+ * @brief Converts the string resource constraints of an event into a ContainerInfo.
+ * @param info Container event with resource constraints.
+ * @return ContainerInfo struct.
+ */
+ContainerInfo toContainerInfo(const ContainerEventInfo& info) {
+    double cpus = std::stod(info.cpus);
+    int memory = std::stoi(info.memory);
+    int pids_limit = std::stoi(info.pids_limit);
+    return ContainerInfo{info.id, cpus, memory, pids_limit};
+}
+
+/**
+ * @brief Checks whether a "create" event already carries all resource constraints.
+ * @param info Parsed container event.
+ * @return True if cpus, memory and pids limit are all present.
+ */
+bool hasResourceConstraints(const ContainerEventInfo& info) {
+    return !info.cpus.empty() && !info.memory.empty() && !info.pids_limit.empty();
+}
+
 /**
  * @brief Parses a container event JSON string into a ContainerEventInfo struct.
- *        If resource constraints are missing, attempts to fetch them via docker/podman inspect.
+ *        Resource constraints are taken from the event attributes only; callers fetch
+ *        missing ones via getResourceConstraintsFromInspect().
  * @param json_str JSON string representing the event.
  * @param info Reference to ContainerEventInfo to populate.
  * @return True if parsing was successful, false otherwise.
@@ -76,10 +160,6 @@ bool parseContainerEvent(const std::string& json_str, ContainerEventInfo& info)
                 info.cpus = attrs.value("cpus", "");
                 info.memory = attrs.value("memory", "");
                 info.pids_limit = attrs.value("pids-limit", "");
-                // If missing, fetch from docker inspect
-                if (info.cpus.empty() || info.memory.empty() || info.pids_limit.empty()) {
-                    getResourceConstraintsFromInspect(info.id, info);
-                }
             }
             return true;
         }
@@ -0,0 +1,236 @@
+/**
+ * @file metrics_table.cpp
+ * @brief Implements the MetricsTable class, a shared-memory table of per-container UI metrics.
+ */
+
+#include "metrics_table.hpp"
+#include <new>
+#include <string>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include "logger.hpp"
+
+/**
+ * @brief Creates (or recreates) the shared-memory table.
+ * @param name Shared-memory object name.
+ * @param capacity Number of slots.
+ * @return The table, or nullptr on failure.
+ */
+std::unique_ptr<MetricsTable> MetricsTable::create(std::string_view name, size_t capacity) {
+    std::string shm_name(name);
+    shm_unlink(shm_name.c_str());
+    int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        CM_LOG_ERROR << "[MetricsTable] shm_open failed for " << shm_name << ": " << strerror(errno) << "\n";
+        return nullptr;
+    }
+
+    size_t size = sizeof(Header) + capacity * sizeof(Slot);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        CM_LOG_ERROR << "[MetricsTable] ftruncate failed for " << shm_name << ": " << strerror(errno) << "\n";
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        return nullptr;
+    }
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        CM_LOG_ERROR << "[MetricsTable] mmap failed for " << shm_name << ": " << strerror(errno) << "\n";
+        shm_unlink(shm_name.c_str());
+        return nullptr;
+    }
+
+    // The mapping is zero-filled; construct the header and slots in place, then publish
+    Header* header = new (base) Header{};
+    Slot* slots = reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header));
+    for (size_t i = 0; i < capacity; ++i) new (&slots[i]) Slot{};
+    int update_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (update_fd < 0) {
+        CM_LOG_WARN << "[MetricsTable] eventfd failed, readers will poll: " << strerror(errno) << "\n";
+    }
+    header->capacity = static_cast<uint32_t>(capacity);
+    header->owner_pid = static_cast<int32_t>(getpid());
+    header->update_fd = update_fd;
+    header->ready.store(1, std::memory_order_release);
+
+    CM_LOG_INFO << "[MetricsTable] Created " << shm_name << " with " << capacity << " slots (" << size << " bytes)\n";
+    return std::unique_ptr<MetricsTable>(new MetricsTable(base, size, update_fd));
+}
+
+/**
+ * @brief Attaches to a table created by create().
+ *
+ * The mapping is read-only; claim(), write() and release() must only be used on the
+ * table returned by create(). Within the creating process the update eventfd is shared.
+ *
+ * @param name Shared-memory object name.
+ * @return The table, or nullptr if it does not exist (yet).
+ */
+std::unique_ptr<MetricsTable> MetricsTable::open(std::string_view name) {
+    std::string shm_name(name);
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        CM_LOG_ERROR << "[MetricsTable] mmap failed for " << shm_name << ": " << strerror(errno) << "\n";
+        return nullptr;
+    }
+
+    const Header* header = static_cast<const Header*>(base);
+    if (header->ready.load(std::memory_order_acquire) == 0 ||
+        sizeof(Header) + header->capacity * sizeof(Slot) > size) {
+        munmap(base, size);
+        return nullptr;
+    }
+    int update_fd = -1;
+    if (header->owner_pid == static_cast<int32_t>(getpid()) && header->update_fd >= 0) {
+        update_fd = fcntl(header->update_fd, F_DUPFD_CLOEXEC, 0);
+    }
+    return std::unique_ptr<MetricsTable>(new MetricsTable(base, size, update_fd));
+}
+
+/**
+ * @brief Removes the shared-memory object name (existing mappings stay valid).
+ * @param name Shared-memory object name.
+ * @return True if the name was removed.
+ */
+bool MetricsTable::unlink(std::string_view name) {
+    return shm_unlink(std::string(name).c_str()) == 0;
+}
+
+/**
+ * @brief Constructs a table over an existing mapping.
+ * @param base Start of the mapping.
+ * @param size Size of the mapping in bytes.
+ * @param update_fd Update eventfd owned by this object, or -1.
+ */
+MetricsTable::MetricsTable(void* base, size_t size, int update_fd)
+    : base_(base), size_(size), header_(static_cast<Header*>(base)),
+      slots_(reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header))), update_fd_(update_fd) {}
+
+/**
+ * @brief Destructor. Unmaps the table and closes the update descriptor.
+ */
+MetricsTable::~MetricsTable() {
+    if (update_fd_ >= 0) close(update_fd_);
+    munmap(base_, size_);
+}
+
+/**
+ * @brief Returns the number of slots.
+ * @return Number of slots.
+ */
+size_t MetricsTable::capacity() const {
+    return header_->capacity;
+}
+
+/**
+ * @brief Claims a free slot.
+ * @return Slot index, or -1 if the table is full.
+ */
+int MetricsTable::claim() {
+    for (size_t i = 0; i < capacity(); ++i) {
+        uint32_t expected = 0;
+        if (slots_[i].claimed.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Overwrites a claimed slot.
+ * @param slot Slot index returned by claim().
+ * @param metrics Latest window extrema.
+ * @param now_ms Current time in milliseconds.
+ */
+void MetricsTable::write(int slot, const ContainerMaxMetricsMsg& metrics, int64_t now_ms) {
+    store(slots_[slot], MetricsTableEntry{now_ms, metrics});
+    if (update_fd_ >= 0) eventfd_write(update_fd_, 1);
+}
+
+/**
+ * @brief Clears a claimed slot and makes it available again.
+ * @param slot Slot index returned by claim().
+ */
+void MetricsTable::release(int slot) {
+    MetricsTableEntry empty;
+    std::memset(&empty, 0, sizeof(empty));
+    store(slots_[slot], empty);
+    slots_[slot].claimed.store(0, std::memory_order_release);
+    if (update_fd_ >= 0) eventfd_write(update_fd_, 1);
+}
+
+/**
+ * @brief Writes a slot under its seqlock.
+ * @param slot Slot to write.
+ * @param entry New contents.
+ */
+void MetricsTable::store(Slot& slot, const MetricsTableEntry& entry) {
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.entry, &entry, sizeof(entry));
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Takes a consistent copy of a slot.
+ *
+ * Retries while a write is in progress or the slot changed during the copy.
+ *
+ * @param slot Slot index.
+ * @param entry Receives the slot contents.
+ * @param sequence Receives the slot sequence; it changes with every write.
+ * @return True if the slot holds a container, false if it is free.
+ */
+bool MetricsTable::read(size_t slot, MetricsTableEntry& entry, uint32_t& sequence) const {
+    const Slot& source = slots_[slot];
+    for (;;) {
+        uint32_t before = source.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(&entry, &source.entry, sizeof(entry));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (source.sequence.load(std::memory_order_relaxed) == before) {
+            sequence = before;
+            return entry.metrics.container_id[0] != '\0';
+        }
+    }
+}
+
+/**
+ * @brief Returns the current sequence of a slot without copying it.
+ *
+ * Lets a reader skip slots that did not change since its previous read.
+ *
+ * @param slot Slot index.
+ * @return Slot sequence (odd while a write is in progress).
+ */
+uint32_t MetricsTable::sequence(size_t slot) const {
+    return slots_[slot].sequence.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Returns the eventfd signalled after every write or release.
+ * @return Non-blocking eventfd, or -1 if the table was opened from another process.
+ */
+int MetricsTable::updateFd() const {
+    return update_fd_;
+}
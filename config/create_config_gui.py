@@ -12,14 +12,45 @@ LIMITS = {
     "alert_critical": (0.0, 100.0),
     "thread_count": (1, 10),
     "thread_capacity": (1, 10),
+    "inspect_thread_count": (1, 16),
+    "host_sampling_interval_ms": (100, 10000),
+    "psi_stall_threshold_us": (10000, 5000000),
+    "psi_window_us": (500000, 10000000),
+    "psi_boost_interval_ms": (10, 5000),
+    "psi_boost_duration_ms": (100, 60000),
+    "max_sampling_interval_ms": (100, 60000),
+    "adaptive_change_threshold": (0.5, 50.0),
+    "deadband_absolute": (0.0, 100.0),
+    "deadband_relative": (0.0, 1.0),
+    "deadband_heartbeat_ms": (100, 600000),
+    "flush_max_age_ms": (0, 60000),
+    "ui_top_n": (1, 1000),
+    "ui_window_ms": (0, 600000),
+    "percentile_window_ms": (1000, 3600000),
+    "alert_hysteresis": (0.0, 100.0),
+    "alert_min_duration_ms": (0, 600000),
+    "alert_rate_per_second": (0.0, 1000.0),
+    "forecast_horizon_ms": (0, 86400000),
+    "anomaly_sigma": (1.0, 10.0),
+    "heavy_hitter_top_k": (1, 100),
 }
 OPTIONS = {
     "runtime": ["docker", "podman"],
     "cgroup": ["v1", "v2"],
     "database": ["sqlite", "mysql"],
     "ui_enabled": ["true", "false"],
+    "startup_discovery_enabled": ["true", "false"],
+    "discovery_mode": ["runtime", "cgroupfs"],
+    "memory_events_enabled": ["true", "false"],
+    "psi_enabled": ["true", "false"],
+    "adaptive_sampling_enabled": ["true", "false"],
+    "deadband_enabled": ["true", "false"],
+    "anomaly_detection_enabled": ["true", "false"],
 }
 DEFAULTS = {
+    "alert_socket_path": "",
+    "metadata_cache_path": "../../storage/container_cache.bin",
+    "cgroup_root": "/sys/fs/cgroup",
     "db_path": "../../storage/metrics.db",
     "file_export_folder_path": "../../storage"
 }
@@ -39,6 +70,37 @@ FIELDS = [
     ("thread_count", "Spinbox"),
     ("thread_capacity", "Spinbox"),
     ("file_export_folder_path", "Entry"),
+    ("inspect_thread_count", "Spinbox"),
+    ("startup_discovery_enabled", "OptionMenu"),
+    ("discovery_mode", "OptionMenu"),
+    ("cgroup_root", "Entry"),
+    ("metadata_cache_path", "Entry"),
+    ("host_sampling_interval_ms", "Spinbox"),
+    ("memory_events_enabled", "OptionMenu"),
+    ("psi_enabled", "OptionMenu"),
+    ("psi_stall_threshold_us", "Spinbox"),
+    ("psi_window_us", "Spinbox"),
+    ("psi_boost_interval_ms", "Spinbox"),
+    ("psi_boost_duration_ms", "Spinbox"),
+    ("adaptive_sampling_enabled", "OptionMenu"),
+    ("max_sampling_interval_ms", "Spinbox"),
+    ("adaptive_change_threshold", "Spinbox"),
+    ("deadband_enabled", "OptionMenu"),
+    ("deadband_absolute", "Spinbox"),
+    ("deadband_relative", "Spinbox"),
+    ("deadband_heartbeat_ms", "Spinbox"),
+    ("flush_max_age_ms", "Spinbox"),
+    ("ui_top_n", "Spinbox"),
+    ("ui_window_ms", "Spinbox"),
+    ("percentile_window_ms", "Spinbox"),
+    ("alert_hysteresis", "Spinbox"),
+    ("alert_min_duration_ms", "Spinbox"),
+    ("alert_rate_per_second", "Spinbox"),
+    ("alert_socket_path", "Entry"),
+    ("forecast_horizon_ms", "Spinbox"),
+    ("anomaly_detection_enabled", "OptionMenu"),
+    ("anomaly_sigma", "Spinbox"),
+    ("heavy_hitter_top_k", "Spinbox"),
 ]
 
 def save_config(values):